@@ -18,7 +18,8 @@ class CanonicalPotential {
   CanonicalPotential(std::shared_ptr<system_type> _system);
 
   /// \brief Reset pointer to state currently being calculated
-  void set(state_type const *state, std::shared_ptr<Conditions> conditions);
+  void set(state_type const *state, std::shared_ptr<Conditions> conditions,
+           bool independent_clex = false);
 
   /// \brief Pointer to current state
   state_type const *state() const;
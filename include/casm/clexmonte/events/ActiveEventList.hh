@@ -0,0 +1,126 @@
+#ifndef CASM_clexmonte_events_ActiveEventList
+#define CASM_clexmonte_events_ActiveEventList
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace xtal {
+class BasicStructure;
+}
+
+namespace clexmonte {
+
+/// \brief Tracks the events that may be allowed, given the positions of
+///     defects (i.e. vacancies)
+///
+/// In dilute defect systems, almost every event in a CompleteEventList is
+/// not allowed because its initial occupation requires a defect which is
+/// not present. ActiveEventList keeps only the "active" events: events which
+/// have at least one site whose initial occupant is a defect, and which
+/// currently have a defect on such a site. Each active event is "anchored"
+/// by each defect it requires, and an event is active while it has at least
+/// one anchor.
+///
+/// After an event occurs, `update` is called with the event index to update
+/// the active events incrementally, using the initial and final occupation
+/// of the event sites to find which defects moved. The number of active
+/// events is O(N_defects * z), where z is the number of events anchored by
+/// one defect.
+///
+/// Notes:
+/// - Every prim event must have at least one site whose initial occupant is
+///   a defect.
+/// - Events excluded by event filters are never active.
+/// - Active events are not necessarily allowed: sites other than the
+///   anchors may not match the event's initial occupation.
+class ActiveEventList {
+ public:
+  ActiveEventList(std::vector<PrimEventData> const &prim_event_list,
+                  CompleteEventList const &event_list,
+                  xtal::UnitCellIndexConverter const &unitcell_converter,
+                  std::vector<std::vector<bool>> const &is_defect);
+
+  /// \brief Set the active events, given the current occupation
+  void initialize(Eigen::VectorXi const &occupation);
+
+  /// \brief Update the active events after an event occurs
+  void update(EventIndex event_index);
+
+  /// \brief Return true if an event is active
+  bool is_active(EventIndex event_index) const {
+    return m_anchor_count.count(event_index);
+  }
+
+  /// \brief Number of active events
+  Index size() const { return m_anchor_count.size(); }
+
+  /// \brief Events which became active during the last `initialize` or
+  ///     `update`, in a deterministic order
+  std::vector<EventIndex> const &added() const { return m_added; }
+
+  /// \brief Events which became inactive during the last `update`, in a
+  ///     deterministic order
+  ///
+  /// Defects are removed before they are added, so an event may be both
+  /// removed and then added during one update.
+  std::vector<EventIndex> const &removed() const { return m_removed; }
+
+ private:
+  /// \brief An event anchored by a defect on a particular sublattice
+  struct Anchor {
+    Index prim_event_index;
+
+    /// Index of the translation from the defect's unit cell to the event's
+    /// unit cell
+    Index translation_index;
+  };
+
+  void _add_anchors(Index linear_site_index);
+
+  void _remove_anchors(Index linear_site_index);
+
+  std::vector<PrimEventData> const &m_prim_event_list;
+
+  CompleteEventList const &m_event_list;
+
+  /// m_is_defect[sublattice_index][occupant_index]
+  std::vector<std::vector<bool>> m_is_defect;
+
+  /// m_anchors[sublattice_index]: events anchored by a defect on a site of
+  /// the sublattice
+  std::vector<std::vector<Anchor>> m_anchors;
+
+  /// Number of distinct translations from a defect to anchored events
+  Index m_n_translations;
+
+  /// Linear unit cell index of the event, by
+  /// `unitcell_index * m_n_translations + translation_index`, where
+  /// `unitcell_index` is the defect's unit cell
+  std::vector<Index> m_anchored_unitcell;
+
+  /// Number of anchors of each active event
+  std::unordered_map<EventIndex, int> m_anchor_count;
+
+  std::vector<EventIndex> m_added;
+
+  std::vector<EventIndex> m_removed;
+
+  /// Holds linear site indices of the event being updated
+  std::vector<Index> m_linear_site_index;
+};
+
+/// \brief Make the `is_defect` table for ActiveEventList from occupant names
+std::vector<std::vector<bool>> make_is_defect(
+    xtal::BasicStructure const &prim,
+    std::vector<std::string> const &defect_names);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,172 @@
+#ifndef CASM_clexmonte_events_ActiveEventSelector
+#define CASM_clexmonte_events_ActiveEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ActiveEventList.hh"
+#include "casm/clexmonte/events/SumTree.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection-free event selector over the active events only
+///
+/// ActiveEventSelector has the same `select_event` / `total_rate` interface
+/// as RejectionFreeEventSelector, but stores rates only for the events in an
+/// ActiveEventList. Each active event is assigned a "slot" in a SumTree;
+/// slots of events that become inactive are re-used. So, in dilute defect
+/// systems the selector size and the cost of initialization are
+/// O(N_defects * z) rather than O(N_sites).
+///
+/// After an event is selected and applied, the next call to `select_event`
+/// first updates the active event list, then calculates the rates of newly
+/// active events and updates the rates of impacted active events.
+///
+/// \tparam RateCalculatorType Must have a method
+///     `double calculate_rate(EventIndex event_index)`.
+/// \tparam ImpactTableType Must have an `operator[](EventIndex event_index)`
+///     returning an iterable range of EventIndex.
+/// \tparam EngineType Random number engine type
+template <typename RateCalculatorType, typename ImpactTableType,
+          typename EngineType = std::mt19937_64>
+class ActiveEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param rate_calculator Event rate calculator
+  /// \param active_event_list Active event list, which must be initialized.
+  ///     A reference is held and it must remain valid for the lifetime of the
+  ///     selector.
+  /// \param impact_table Impact table. A reference is held and it must remain
+  ///     valid for the lifetime of the selector.
+  /// \param engine Random number engine
+  ActiveEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator,
+      ActiveEventList &active_event_list, ImpactTableType const &impact_table,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>())
+      : m_rate_calculator(rate_calculator),
+        m_active_event_list(active_event_list),
+        m_impact_table(impact_table),
+        m_random_number_generator(engine) {
+    for (EventIndex event_index : m_active_event_list.added()) {
+      _add(event_index);
+    }
+  }
+
+  /// \brief Update active events and impacted event rates, then select an
+  ///     event and sample the time increment
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    if (m_last_selected.has_value()) {
+      _update(*m_last_selected);
+    }
+    double total_rate = m_sum_tree.total();
+    if (!(total_rate > 0.0)) {
+      throw std::runtime_error(
+          "Error in ActiveEventSelector::select_event: total rate is zero");
+    }
+    Index slot =
+        m_sum_tree.find(m_random_number_generator.random_real(total_rate));
+    EventIndex selected = m_slot_event[slot];
+    m_last_selected = selected;
+
+    // time increment: -ln(u) / total_rate, with u in (0, 1]
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    double time_increment = -std::log(u) / total_rate;
+    return std::make_pair(selected, time_increment);
+  }
+
+  /// \brief Total rate of all events
+  double total_rate() const { return m_sum_tree.total(); }
+
+  /// \brief Current rate of an event (0.0 if not active)
+  double get_rate(EventIndex event_index) const {
+    auto it = m_event_slot.find(event_index);
+    if (it == m_event_slot.end()) {
+      return 0.0;
+    }
+    return m_sum_tree.value(it->second);
+  }
+
+  /// \brief Number of active events
+  Index size() const { return m_event_slot.size(); }
+
+ private:
+  /// \brief Update active events and rates after an event occurred
+  void _update(EventIndex event_index) {
+    m_active_event_list.update(event_index);
+    for (EventIndex removed : m_active_event_list.removed()) {
+      _remove(removed);
+    }
+    for (EventIndex added : m_active_event_list.added()) {
+      _add(added);
+    }
+    for (EventIndex impacted : m_impact_table[event_index]) {
+      auto it = m_event_slot.find(impacted);
+      if (it != m_event_slot.end()) {
+        m_sum_tree.set(it->second,
+                       m_rate_calculator->calculate_rate(impacted));
+      }
+    }
+  }
+
+  /// \brief Assign a slot to an event and calculate its rate
+  void _add(EventIndex event_index) {
+    Index slot;
+    if (!m_free_slots.empty()) {
+      slot = m_free_slots.back();
+      m_free_slots.pop_back();
+      m_slot_event[slot] = event_index;
+    } else {
+      slot = m_slot_event.size();
+      m_slot_event.push_back(event_index);
+      if (slot >= m_sum_tree.size()) {
+        m_sum_tree.resize(std::max<Index>(2 * m_sum_tree.size(), 16));
+      }
+    }
+    m_event_slot[event_index] = slot;
+    m_sum_tree.set(slot, m_rate_calculator->calculate_rate(event_index));
+  }
+
+  /// \brief Free the slot of an event
+  void _remove(EventIndex event_index) {
+    auto it = m_event_slot.find(event_index);
+    m_sum_tree.set(it->second, 0.0);
+    m_free_slots.push_back(it->second);
+    m_event_slot.erase(it);
+  }
+
+  std::shared_ptr<RateCalculatorType> m_rate_calculator;
+  ActiveEventList &m_active_event_list;
+  ImpactTableType const &m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+  std::optional<EventIndex> m_last_selected;
+
+  /// Rates, by slot
+  SumTree m_sum_tree;
+
+  /// Event index, by slot
+  std::vector<EventIndex> m_slot_event;
+
+  /// Slot, by event index, for active events
+  std::unordered_map<EventIndex, Index> m_event_slot;
+
+  /// Unused slots
+  std::vector<Index> m_free_slots;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
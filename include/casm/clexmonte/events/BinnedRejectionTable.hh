@@ -0,0 +1,365 @@
+#ifndef CASM_clexmonte_events_BinnedRejectionTable
+#define CASM_clexmonte_events_BinnedRejectionTable
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Values grouped into bins of equal width in log(value), for O(1)
+///     weighted selection by composition and rejection
+///
+/// BinnedRejectionTable stores non-negative values (event rates) by index
+/// and groups them into bins. Bin `k` holds values in
+/// (2^-((k+1)/w), 2^-(k/w)], with `w = BinsPerFactorOf2`. A value is
+/// selected with probability proportional to its value in two steps:
+///
+/// 1. Composition: a bin is selected with probability proportional to the
+///    sum of its values, by linear search over the non-empty bins in order
+///    of decreasing value.
+/// 2. Rejection: a member of the bin is chosen uniformly and accepted with
+///    probability `v / upper`, where `upper` is the bin upper bound, which
+///    is >= 2^(-1/w), otherwise step 2 is repeated. Values equal to a bin
+///    upper bound are accepted without rejection.
+///
+/// The number of non-empty bins is set by the range of values, not by the
+/// number of values, so `set` is O(1) and `select` is O(1) expected time,
+/// compared to O(log N) for SumTree. More bins per factor of 2 means fewer
+/// rejections, and more bins to search.
+///
+/// This has the same interface as SumTree for setting values, so it can be
+/// used as the rate table of RejectionFreeEventSelector. It is used as
+/// CompositionRejectionTable and RateClassTable.
+///
+/// Notes:
+/// - Bin sums are incremented as values change, and recalculated from
+///   their members after a number of updates proportional to the bin size,
+///   so that rounding errors do not accumulate
+/// - Zero-valued entries are not in any bin and are never selected
+/// - Selection consumes a variable number of random numbers, so results
+///   differ from SumTree for the same random number engine state
+///
+/// \tparam BinsPerFactorOf2 Number of bins per factor of 2 in value
+template <int BinsPerFactorOf2>
+class BinnedRejectionTable {
+ public:
+  /// Number of bins per factor of 2 in value
+  static int const bins_per_factor_of_2 = BinsPerFactorOf2;
+
+  /// \brief Constructor, all values are initialized to 0.0
+  explicit BinnedRejectionTable(Index n_values = 0);
+
+  /// \brief Constructor, with initial values
+  explicit BinnedRejectionTable(std::vector<double> const &values,
+                                int n_threads = 1);
+
+  /// \brief Number of values
+  Index size() const { return m_value.size(); }
+
+  /// \brief Sum of all values
+  double total() const;
+
+  /// \brief Get a value
+  double value(Index index) const { return m_value[index]; }
+
+  /// \brief Set a value
+  void set(Index index, double value);
+
+  /// \brief Set all values
+  void reset(std::vector<double> const &values, int n_threads = 1);
+
+  /// \brief Number of non-empty bins
+  Index n_bins() const { return m_active.size(); }
+
+  /// \brief Number of values in the same bin as a value
+  Index bin_size(Index index) const {
+    return m_bin[index] < 0 ? 0 : m_bins[m_bin[index]].members.size();
+  }
+
+  /// \brief Select an index with probability proportional to its value
+  ///
+  /// \param random_number_generator Must have methods
+  ///     `double random_real(double max)` and `Index random_int(Index max)`,
+  ///     as monte::RandomNumberGenerator
+  ///
+  /// \returns The index of an entry with non-zero value
+  template <typename GeneratorType>
+  Index select(GeneratorType &random_number_generator) const {
+    double total_value = total();
+    if (!(total_value > 0.0)) {
+      throw std::runtime_error(
+          "Error in BinnedRejectionTable::select: total is zero");
+    }
+
+    // composition: select a bin by linear search, largest values first
+    double x = random_number_generator.random_real(total_value);
+    Bin const *bin = &m_bins[m_active.back()];
+    for (int bin_index : m_active) {
+      Bin const &b = m_bins[bin_index];
+      if (x < b.sum) {
+        bin = &b;
+        break;
+      }
+      x -= b.sum;
+    }
+
+    // rejection: select a bin member
+    Index n_members = bin->members.size();
+    while (true) {
+      Index index =
+          bin->members[random_number_generator.random_int(n_members - 1)];
+      double value = m_value[index];
+      if (value == bin->upper ||
+          random_number_generator.random_real(bin->upper) < value) {
+        return index;
+      }
+    }
+  }
+
+ private:
+  struct Bin {
+    /// Upper bound on member values, 2^-(k/w)
+    double upper = 0.0;
+
+    /// Sum of member values
+    double sum = 0.0;
+
+    /// Indices of members
+    std::vector<Index> members;
+
+    /// Number of updates since `sum` was recalculated
+    Index n_updates = 0;
+  };
+
+  /// Offset from bin `k` to bin index, so that all finite positive doubles
+  /// have a non-negative bin index
+  static int const bin_offset =
+      (std::numeric_limits<double>::max_exponent + 1) * BinsPerFactorOf2;
+
+  /// Number of bins, enough for all finite positive doubles, including
+  /// subnormals
+  static int const n_bins_max =
+      bin_offset + (1 - std::numeric_limits<double>::min_exponent +
+                    std::numeric_limits<double>::digits + 1) *
+                       BinsPerFactorOf2;
+
+  /// \brief Bin index for a value, or -1 if the value is zero
+  int _bin_index(double value) const;
+
+  /// \brief Add an entry to its bin
+  void _insert(int bin_index, Index index);
+
+  /// \brief Remove an entry from its bin
+  void _remove(int bin_index, Index index);
+
+  /// \brief Count an update, recalculating the bin sum if necessary
+  void _count_update(Bin &bin);
+
+  /// Values, by index
+  std::vector<double> m_value;
+
+  /// Bin index, by index; -1 for zero values
+  std::vector<int> m_bin;
+
+  /// Position in bin members, by index
+  std::vector<Index> m_position;
+
+  /// Bins, by bin index (in order of decreasing upper bound)
+  std::vector<Bin> m_bins;
+
+  /// Indices of non-empty bins, sorted (in order of decreasing value)
+  std::vector<int> m_active;
+};
+
+// --- Implementation ---
+
+/// \brief Constructor, all values are initialized to 0.0
+///
+/// \param n_values Number of values
+template <int BinsPerFactorOf2>
+BinnedRejectionTable<BinsPerFactorOf2>::BinnedRejectionTable(Index n_values)
+    : m_value(n_values, 0.0),
+      m_bin(n_values, -1),
+      m_position(n_values, -1),
+      m_bins(n_bins_max) {
+  for (int i = 0; i < n_bins_max; ++i) {
+    m_bins[i].upper = std::exp2(-double(i - bin_offset) / BinsPerFactorOf2);
+  }
+}
+
+/// \brief Constructor, with initial values
+///
+/// \param values Initial values, which must be non-negative and finite
+/// \param n_threads Unused; accepted for consistency with SumTree
+template <int BinsPerFactorOf2>
+BinnedRejectionTable<BinsPerFactorOf2>::BinnedRejectionTable(
+    std::vector<double> const &values, int n_threads)
+    : BinnedRejectionTable(Index(values.size())) {
+  reset(values, n_threads);
+}
+
+/// \brief Sum of all values
+///
+/// This is the sum of the bin sums, so it is O(number of non-empty bins).
+template <int BinsPerFactorOf2>
+double BinnedRejectionTable<BinsPerFactorOf2>::total() const {
+  double sum = 0.0;
+  for (int bin_index : m_active) {
+    sum += m_bins[bin_index].sum;
+  }
+  return sum;
+}
+
+/// \brief Set a value
+///
+/// \param index Index, in range [0, size())
+/// \param value New value, which must be non-negative and finite
+template <int BinsPerFactorOf2>
+void BinnedRejectionTable<BinsPerFactorOf2>::set(Index index, double value) {
+  int bin_index = _bin_index(value);
+  int old_bin_index = m_bin[index];
+  if (bin_index == old_bin_index) {
+    if (bin_index >= 0) {
+      Bin &bin = m_bins[bin_index];
+      bin.sum += value - m_value[index];
+      m_value[index] = value;
+      _count_update(bin);
+    }
+    return;
+  }
+  if (old_bin_index >= 0) {
+    _remove(old_bin_index, index);
+  }
+  m_value[index] = value;
+  if (bin_index >= 0) {
+    _insert(bin_index, index);
+  }
+}
+
+/// \brief Set all values
+///
+/// \param values New values, which must be non-negative and finite. Size
+///     must be equal to size().
+/// \param n_threads Unused; accepted for consistency with SumTree
+template <int BinsPerFactorOf2>
+void BinnedRejectionTable<BinsPerFactorOf2>::reset(
+    std::vector<double> const &values, int n_threads) {
+  if (Index(values.size()) != size()) {
+    throw std::runtime_error(
+        "Error in BinnedRejectionTable::reset: size mismatch");
+  }
+  for (int bin_index : m_active) {
+    Bin &bin = m_bins[bin_index];
+    bin.sum = 0.0;
+    bin.members.clear();
+    bin.n_updates = 0;
+  }
+  m_active.clear();
+  std::fill(m_bin.begin(), m_bin.end(), -1);
+  std::fill(m_position.begin(), m_position.end(), -1);
+  for (Index i = 0; i < size(); ++i) {
+    m_value[i] = values[i];
+    int bin_index = _bin_index(values[i]);
+    if (bin_index >= 0) {
+      _insert(bin_index, i);
+    }
+  }
+}
+
+/// \brief Bin index for a value, or -1 if the value is zero
+///
+/// The bin index `i` satisfies `upper(i+1) < value <= upper(i)`, using the
+/// stored bin upper bounds, so that rejection never accepts with
+/// probability > 1.
+template <int BinsPerFactorOf2>
+int BinnedRejectionTable<BinsPerFactorOf2>::_bin_index(double value) const {
+  if (value == 0.0) {
+    return -1;
+  }
+  if (!(value > 0.0) || !std::isfinite(value)) {
+    throw std::runtime_error(
+        "Error in BinnedRejectionTable: value must be non-negative and "
+        "finite");
+  }
+  int i = static_cast<int>(std::floor(-std::log2(value) * BinsPerFactorOf2)) +
+          bin_offset;
+  i = std::max(0, std::min(i, n_bins_max - 1));
+  while (i > 0 && value > m_bins[i].upper) {
+    --i;
+  }
+  while (i + 1 < n_bins_max && value <= m_bins[i + 1].upper) {
+    ++i;
+  }
+  return i;
+}
+
+/// \brief Add an entry to its bin
+template <int BinsPerFactorOf2>
+void BinnedRejectionTable<BinsPerFactorOf2>::_insert(int bin_index,
+                                                     Index index) {
+  Bin &bin = m_bins[bin_index];
+  if (bin.members.empty()) {
+    m_active.insert(
+        std::lower_bound(m_active.begin(), m_active.end(), bin_index),
+        bin_index);
+    bin.sum = 0.0;
+    bin.n_updates = 0;
+  }
+  m_bin[index] = bin_index;
+  m_position[index] = bin.members.size();
+  bin.members.push_back(index);
+  bin.sum += m_value[index];
+  _count_update(bin);
+}
+
+/// \brief Remove an entry from its bin
+template <int BinsPerFactorOf2>
+void BinnedRejectionTable<BinsPerFactorOf2>::_remove(int bin_index,
+                                                     Index index) {
+  Bin &bin = m_bins[bin_index];
+  Index position = m_position[index];
+  Index last = bin.members.back();
+  bin.members[position] = last;
+  m_position[last] = position;
+  bin.members.pop_back();
+  m_bin[index] = -1;
+  m_position[index] = -1;
+
+  if (bin.members.empty()) {
+    m_active.erase(
+        std::lower_bound(m_active.begin(), m_active.end(), bin_index));
+    bin.sum = 0.0;
+    bin.n_updates = 0;
+    return;
+  }
+  bin.sum -= m_value[index];
+  _count_update(bin);
+}
+
+/// \brief Count an update, recalculating the bin sum if necessary
+///
+/// Recalculating after a number of updates proportional to the bin size
+/// keeps the cost amortized O(1) per update.
+template <int BinsPerFactorOf2>
+void BinnedRejectionTable<BinsPerFactorOf2>::_count_update(Bin &bin) {
+  ++bin.n_updates;
+  if (bin.n_updates > std::max(Index(1024), Index(bin.members.size()))) {
+    double sum = 0.0;
+    for (Index index : bin.members) {
+      sum += m_value[index];
+    }
+    bin.sum = sum;
+    bin.n_updates = 0;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -1,29 +1,112 @@
 #ifndef CASM_clexmonte_events_CompleteEventList
 #define CASM_clexmonte_events_CompleteEventList
 
+#include <limits>
 #include <map>
+#include <set>
+#include <string>
 #include <vector>
 
+#include "casm/clexmonte/events/EventSiteTable.hh"
 #include "casm/clexmonte/events/ImpactTable.hh"
 #include "casm/clexmonte/events/event_data.hh"
 
 namespace CASM {
+class Log;
+
 namespace monte {
 class OccLocation;
 }
 
 namespace clexmonte {
 
+/// \brief All events in a supercell, stored in flat arrays
+///
+/// Events are indexed by EventIndex, `unitcell_index * n_prim_events +
+/// prim_event_index`, so that event sites and impact lists can be accessed in
+/// O(1) by the event calculators and selectors. Events excluded by event
+/// filters are still indexed, but have `is_included[event_index] == false`.
+///
+/// Events are not stored explicitly. The linear site indices needed to
+/// calculate event rates are looked up from `site_table`, and the
+/// monte::OccEvent needed to apply an event is constructed as needed using
+/// `set_event`.
 struct CompleteEventList {
-  std::map<EventID, std::vector<EventID>> impact_table;
+  /// \brief Number of events associated with the origin unit cell
+  Index n_prim_events = 0;
+
+  /// \brief Number of unit cells in the supercell
+  Index n_unitcells = 0;
+
+  /// \brief Events impacted by the occurance of each event, by EventIndex
+  ///
+  /// This is empty if the event list was constructed without an impact
+  /// table, as for rejection KMC.
+  CompressedEventImpactTable impact_table;
+
+  /// \brief Event sites lookup table
+  EventSiteTable site_table;
+
+  /// \brief Whether events are allowed by the event filters, by EventIndex
+  std::vector<bool> is_included;
+
+  /// \brief Construction time, in seconds, by construction step
+  ///
+  /// Keys are "relative_impact_table" (if constructed from prim impact
+  /// info), "impact_table", "site_table", "event_filters", and "total".
+  std::map<std::string, double> timing;
+
+  /// \brief Total number of events (n_unitcells * n_prim_events)
+  Index size() const { return n_unitcells * n_prim_events; }
+
+  /// \brief Convert EventID to EventIndex
+  EventIndex event_index(EventID const &event_id) const {
+    return static_cast<EventIndex>(event_id.unitcell_index * n_prim_events +
+                                   event_id.prim_event_index);
+  }
+
+  /// \brief Convert EventIndex to EventID
+  EventID event_id(EventIndex event_index) const {
+    EventID event_id;
+    event_id.prim_event_index = event_index % n_prim_events;
+    event_id.unitcell_index = event_index / n_prim_events;
+    return event_id;
+  }
+};
+
+/// \brief A box of unit cells, in unit cell coordinates
+///
+/// A unit cell `(i, j, k)`, as given by the supercell's
+/// xtal::UnitCellIndexConverter (i.e. within the supercell), is in the region
+/// if `min(d) <= unitcell(d) <= max(d)` for each `d`. A slab is a region with
+/// one bounded direction.
+struct UnitCellRegion {
+  /// Minimum unit cell coordinates (inclusive)
+  Eigen::Vector3l min =
+      Eigen::Vector3l::Constant(std::numeric_limits<long>::min());
+
+  /// Maximum unit cell coordinates (inclusive)
+  Eigen::Vector3l max =
+      Eigen::Vector3l::Constant(std::numeric_limits<long>::max());
 
-  std::map<EventID, EventData> events;
+  bool contains(xtal::UnitCell const &unitcell) const {
+    for (Index d = 0; d < 3; ++d) {
+      if (unitcell(d) < min(d) || unitcell(d) > max(d)) {
+        return false;
+      }
+    }
+    return true;
+  }
 };
 
 struct EventFilterGroup {
   /// The linear unit cell index for which the group applies
   std::set<Index> unitcell_index;
 
+  /// Regions of unit cells for which the group applies, in addition to
+  /// `unitcell_index`
+  std::vector<UnitCellRegion> regions;
+
   /// Whether events are included (default) or excluded as a default
   bool include_by_default = true;
 
@@ -31,11 +114,54 @@ struct EventFilterGroup {
   std::set<Index> prim_event_index;
 };
 
+/// \brief Event filters, compiled for a particular supercell
+///
+/// If a unit cell is in more than one EventFilterGroup, the first group
+/// applies. Then event `(unitcell_index, prim_event_index)` is included if
+/// `group_index[unitcell_index] == -1` or
+/// `is_included[group_index[unitcell_index]][prim_event_index]`.
+struct CompiledEventFilters {
+  /// \brief Index of the filter group that applies to each unit cell, or
+  ///     -1 if no group applies
+  std::vector<int> group_index;
+
+  /// \brief is_included[group_index][prim_event_index]
+  std::vector<std::vector<bool>> is_included;
+};
+
+CompiledEventFilters compile_event_filters(
+    std::vector<EventFilterGroup> const &event_filters,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    Index n_prim_events);
+
 CompleteEventList make_complete_event_list(
     std::vector<PrimEventData> const &prim_event_list,
     std::vector<EventImpactInfo> const &prim_impact_info_list,
     monte::OccLocation const &occ_location,
-    std::vector<EventFilterGroup> const &event_filters = {});
+    std::vector<EventFilterGroup> const &event_filters = {},
+    int n_threads = 1, bool with_impact_table = true);
+
+CompleteEventList make_complete_event_list(
+    std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::vector<RelativeEventID>> const &relative_impact_table,
+    monte::OccLocation const &occ_location,
+    std::vector<EventFilterGroup> const &event_filters = {},
+    int n_threads = 1, bool with_impact_table = true);
+
+/// \brief Print CompleteEventList construction timing and size
+void print_timing(Log &log, CompleteEventList const &event_list);
+
+/// \brief Set monte::OccEvent for an event in a CompleteEventList
+monte::OccEvent &set_event(monte::OccEvent &event, EventIndex event_index,
+                           CompleteEventList const &event_list,
+                           std::vector<PrimEventData> const &prim_event_list,
+                           monte::OccLocation const &occ_location);
+
+/// \brief Set EventData for an event in a CompleteEventList
+EventData &set_event_data(EventData &event_data, EventIndex event_index,
+                          CompleteEventList const &event_list,
+                          std::vector<PrimEventData> const &prim_event_list,
+                          monte::OccLocation const &occ_location);
 
 std::vector<EventID> make_complete_event_id_list(
     Index n_unitcells, std::vector<PrimEventData> const &prim_event_list);
@@ -0,0 +1,20 @@
+#ifndef CASM_clexmonte_events_CompositionRejectionTable
+#define CASM_clexmonte_events_CompositionRejectionTable
+
+#include "casm/clexmonte/events/BinnedRejectionTable.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Values grouped by power of 2, for O(1) weighted selection
+///
+/// A value `v` in (2^-(k+1), 2^-k] is in group `k`, so rejection accepts
+/// with probability >= 1/2. The number of non-empty groups is set by the
+/// range of values (i.e. ~40 groups for rates spanning 12 orders of
+/// magnitude). See BinnedRejectionTable.
+typedef BinnedRejectionTable<1> CompositionRejectionTable;
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
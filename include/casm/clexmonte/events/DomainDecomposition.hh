@@ -0,0 +1,62 @@
+#ifndef CASM_clexmonte_events_DomainDecomposition
+#define CASM_clexmonte_events_DomainDecomposition
+
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Splits the unit cells of a supercell into domains and sectors,
+///     for synchronous sublattice KMC
+///
+/// The supercell is split into `n_domains(a)` slabs along each supercell
+/// lattice vector `a`, giving a grid of domains. If `n_domains(a) > 1`, each
+/// domain is split in half again along `a`, giving up to 8 sectors per
+/// domain. A unit cell is assigned to a domain and sector by its fractional
+/// coordinates in the supercell, so any supercell shape is supported.
+///
+/// Sectors with the same index in different domains are separated by at
+/// least one sector width along each split axis. If the sector width is at
+/// least the range of the impact table (the largest translation in the
+/// relative impact table, along each axis), then events anchored in the
+/// same sector of different domains never impact each other, so they may
+/// be selected and applied concurrently.
+struct DomainDecomposition {
+  /// \brief Constructor
+  ///
+  /// \param transformation_matrix_to_super Supercell transformation matrix
+  /// \param unitcell_index_converter Supercell unit cell index converter
+  /// \param n_domains Number of domains along each supercell lattice vector
+  /// \param relative_impact_table Events impacted by each prim event,
+  ///     relative to the origin unit cell. Used to check the sector width.
+  ///
+  /// Throws if any `n_domains(a) < 1`, or if the sector width along a split
+  /// axis is less than the range of the impact table.
+  DomainDecomposition(
+      Eigen::Matrix3l const &transformation_matrix_to_super,
+      xtal::UnitCellIndexConverter const &unitcell_index_converter,
+      Eigen::Vector3l const &n_domains,
+      std::vector<std::vector<RelativeEventID>> const &relative_impact_table);
+
+  /// Number of domains
+  Index n_domains;
+
+  /// Number of sectors per domain
+  Index n_sectors;
+
+  /// Domain index, by linear unit cell index
+  std::vector<Index> unitcell_domain;
+
+  /// Sector index, by linear unit cell index
+  std::vector<Index> unitcell_sector;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,100 @@
+#ifndef CASM_clexmonte_events_EventSiteTable
+#define CASM_clexmonte_events_EventSiteTable
+
+#include <cstddef>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/crystallography/LinearIndexConverter.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Look up the linear site indices of events without storing them
+///     for every event
+///
+/// For each prim event, EventSiteTable stores the sublattice index and the
+/// index of the unit cell translation of each event site. For each unit cell
+/// in the supercell, it stores the linear unit cell index of each of the
+/// distinct translations. Then the linear site index of site `i` of an event
+/// is:
+///
+///     l = sublattice * n_unitcells +
+///         neighbor_unitcell[unitcell_index * n_translations +
+///                           translation_index]
+///
+/// This is consistent with the linear site index used by
+/// xtal::UnitCellCoordIndexConverter and monte::Conversions.
+struct EventSiteTable {
+  /// \brief Default constructor, an empty table
+  EventSiteTable();
+
+  EventSiteTable(std::vector<PrimEventData> const &prim_event_list,
+                 xtal::UnitCellIndexConverter const &unitcell_converter,
+                 int n_threads = 1);
+
+  EventSiteTable(
+      std::vector<std::vector<xtal::UnitCellCoord>> const &prim_event_sites,
+      xtal::UnitCellIndexConverter const &unitcell_converter,
+      int n_threads = 1);
+
+  /// \brief Number of sites of prim event `prim_event_index`
+  Index n_sites(Index prim_event_index) const {
+    return m_sublattice[prim_event_index].size();
+  }
+
+  /// \brief Linear site index of site `site_index` of an event
+  Index linear_site_index(Index unitcell_index, Index prim_event_index,
+                          Index site_index) const {
+    return m_sublattice[prim_event_index][site_index] * m_n_unitcells +
+           m_neighbor_unitcell[unitcell_index * m_n_translations +
+                               m_translation_index[prim_event_index]
+                                                  [site_index]];
+  }
+
+  /// \brief Set the linear site indices of all sites of an event
+  void set_linear_site_index(std::vector<Index> &linear_site_index,
+                             Index unitcell_index,
+                             Index prim_event_index) const;
+
+  /// \brief Approximate memory used by the table, in bytes
+  std::size_t memory_usage() const;
+
+ private:
+  Index m_n_unitcells;
+
+  /// Number of distinct unit cell translations of event sites
+  Index m_n_translations;
+
+  /// m_sublattice[prim_event_index][site_index]: sublattice index of site
+  std::vector<std::vector<Index>> m_sublattice;
+
+  /// m_translation_index[prim_event_index][site_index]: translation index of
+  /// site
+  std::vector<std::vector<Index>> m_translation_index;
+
+  /// Linear unit cell index of each translation from each unit cell
+  std::vector<Index> m_neighbor_unitcell;
+};
+
+// -- Inline definitions --
+
+inline void EventSiteTable::set_linear_site_index(
+    std::vector<Index> &linear_site_index, Index unitcell_index,
+    Index prim_event_index) const {
+  std::vector<Index> const &sublattice = m_sublattice[prim_event_index];
+  std::vector<Index> const &translation_index =
+      m_translation_index[prim_event_index];
+  Index const *neighbor_unitcell =
+      m_neighbor_unitcell.data() + unitcell_index * m_n_translations;
+  linear_site_index.resize(sublattice.size());
+  for (Index i = 0; i < sublattice.size(); ++i) {
+    linear_site_index[i] = sublattice[i] * m_n_unitcells +
+                           neighbor_unitcell[translation_index[i]];
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
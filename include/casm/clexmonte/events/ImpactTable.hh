@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_events_ImpactTable
 #define CASM_clexmonte_events_ImpactTable
 
+#include <cstddef>
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -22,6 +24,9 @@ namespace clexmonte {
 /// occurance upon request by applying translations and within
 /// supercell operations. Therefore, compared to SupercellEventImpactTable it
 /// has lower memory requirements but will be slower.
+///
+/// Note: `operator()` writes into an internal buffer, so it is not
+/// thread-safe. Use CompressedEventImpactTable for parallel rate updates.
 struct RelativeEventImpactTable {
   RelativeEventImpactTable(
       std::vector<EventImpactInfo> const &prim_event_list,
@@ -29,6 +34,9 @@ struct RelativeEventImpactTable {
 
   std::vector<EventID> const &operator()(EventID const &event_id) const;
 
+  /// \brief Approximate memory used by the table, in bytes
+  std::size_t memory_usage() const;
+
  private:
   std::vector<std::vector<RelativeEventID>> m_impact_table;
   xtal::UnitCellIndexConverter m_unitcell_converter;
@@ -51,11 +59,83 @@ struct SupercellEventImpactTable {
 
   std::vector<EventID> const &operator()(EventID const &event_id) const;
 
+  /// \brief Approximate memory used by the table, in bytes
+  std::size_t memory_usage() const;
+
  private:
   Index m_n_prim_events;
   std::vector<std::vector<EventID>> m_impact_table;
 };
 
+/// \brief A contiguous range of EventIndex
+struct EventIndexRange {
+  EventIndex const *begin_ptr = nullptr;
+  EventIndex const *end_ptr = nullptr;
+
+  EventIndex const *begin() const { return begin_ptr; }
+  EventIndex const *end() const { return end_ptr; }
+  Index size() const { return end_ptr - begin_ptr; }
+  bool empty() const { return begin_ptr == end_ptr; }
+  EventIndex operator[](Index i) const { return begin_ptr[i]; }
+};
+
+/// \brief Implements an event impact table, storing all interactions in a
+/// supercell explicitly in compressed sparse row (CSR) format
+///
+/// Specifies which events are impacted (and therefore must have their
+/// propensities updated) by the occurance of another event.
+///
+/// CompressedEventImpactTable generates all impact vectors at construction,
+/// like SupercellEventImpactTable, but stores them in a single contiguous
+/// array of EventIndex, with one offsets array giving the beginning of the
+/// impact list for each event. This avoids one allocation per event and
+/// stores impacted events as 32-bit EventIndex, so it has much lower memory
+/// requirements than SupercellEventImpactTable with the same lookup speed.
+///
+/// Events are indexed by EventIndex, `unitcell_index * n_prim_events +
+/// prim_event_index`. Lookup does not modify the table, so it may be used by
+/// multiple threads concurrently. Each row has unique entries, even in
+/// supercells small enough that impacted events are periodic images.
+struct CompressedEventImpactTable {
+  /// \brief Default constructor, an empty table
+  CompressedEventImpactTable();
+
+  CompressedEventImpactTable(
+      std::vector<EventImpactInfo> const &prim_event_list,
+      xtal::UnitCellIndexConverter const &unitcell_converter,
+      int n_threads = 1);
+
+  CompressedEventImpactTable(
+      std::vector<std::vector<RelativeEventID>> const &relative_impact_table,
+      xtal::UnitCellIndexConverter const &unitcell_converter,
+      int n_threads = 1);
+
+  /// \brief Events impacted by the occurance of event `event_index`
+  EventIndexRange operator[](EventIndex event_index) const;
+
+  /// \brief Events impacted by the occurance of event `event_id`
+  EventIndexRange operator()(EventID const &event_id) const;
+
+  /// \brief Number of events (rows) in the table
+  Index size() const { return m_offsets.size() - 1; }
+
+  /// \brief Total number of impacted event entries in the table
+  std::size_t n_entries() const { return m_impacted.size(); }
+
+  /// \brief Approximate memory used by the table, in bytes
+  std::size_t memory_usage() const;
+
+ private:
+  Index m_n_prim_events;
+
+  /// m_offsets[event_index] is the position in m_impacted of the first event
+  /// impacted by event_index; size is n_events + 1
+  std::vector<std::uint64_t> m_offsets;
+
+  /// Impacted events, for all events
+  std::vector<EventIndex> m_impacted;
+};
+
 /// \brief Return an impact table for events in the origin unit cell
 std::vector<std::vector<RelativeEventID>> make_relative_impact_table(
     std::vector<EventImpactInfo> const &prim_event_list);
@@ -85,6 +165,19 @@ inline std::vector<EventID> const &SupercellEventImpactTable::operator()(
   return m_impact_table[linear_index];
 }
 
+inline EventIndexRange CompressedEventImpactTable::operator[](
+    EventIndex event_index) const {
+  EventIndex const *data = m_impacted.data();
+  return EventIndexRange{data + m_offsets[event_index],
+                         data + m_offsets[event_index + 1]};
+}
+
+inline EventIndexRange CompressedEventImpactTable::operator()(
+    EventID const &event_id) const {
+  return (*this)[static_cast<EventIndex>(
+      event_id.unitcell_index * m_n_prim_events + event_id.prim_event_index)];
+}
+
 }  // namespace clexmonte
 }  // namespace CASM
 
@@ -0,0 +1,73 @@
+#ifndef CASM_clexmonte_events_IndexedMinHeap
+#define CASM_clexmonte_events_IndexedMinHeap
+
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A binary min-heap of keys, indexed by item
+///
+/// IndexedMinHeap stores one key (i.e. a putative event firing time) for
+/// each item in the range [0, size()), and keeps the position of each item
+/// in the heap, so that the key of any item can be changed in O(log N) and
+/// the item with minimum key is found in O(1). Items can be indexed directly
+/// by EventIndex.
+///
+/// Notes:
+/// - Keys may be `std::numeric_limits<double>::infinity()`, i.e. for events
+///   that never occur
+/// - Ties are broken by heap position, which depends only on the sequence of
+///   operations, so results are reproducible
+class IndexedMinHeap {
+ public:
+  /// \brief Constructor, with initial keys
+  explicit IndexedMinHeap(std::vector<double> const &keys = {});
+
+  /// \brief Number of items
+  Index size() const { return m_key.size(); }
+
+  /// \brief Item with the minimum key
+  Index top() const { return m_heap[0]; }
+
+  /// \brief Minimum key
+  double top_key() const { return m_key[m_heap[0]]; }
+
+  /// \brief Key of an item
+  double key(Index item) const { return m_key[item]; }
+
+  /// \brief Set the key of an item and restore the heap order
+  void set(Index item, double key);
+
+  /// \brief Set all keys and rebuild the heap, in O(N)
+  void reset(std::vector<double> const &keys);
+
+ private:
+  /// \brief Move the item at heap position `pos` up until in order
+  void _sift_up(Index pos);
+
+  /// \brief Move the item at heap position `pos` down until in order
+  void _sift_down(Index pos);
+
+  /// \brief Place `item` at heap position `pos`
+  void _place(Index pos, Index item) {
+    m_heap[pos] = item;
+    m_position[item] = pos;
+  }
+
+  /// Keys, by item
+  std::vector<double> m_key;
+
+  /// Items, by heap position
+  std::vector<Index> m_heap;
+
+  /// Heap position, by item
+  std::vector<Index> m_position;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,350 @@
+#ifndef CASM_clexmonte_events_NextReactionEventSelector
+#define CASM_clexmonte_events_NextReactionEventSelector
+
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/IndexedMinHeap.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Next reaction method event selector for events indexed by
+///     EventIndex
+///
+/// NextReactionEventSelector implements the Gibson-Bruck next reaction
+/// method: each event has a putative absolute firing time, kept in an
+/// IndexedMinHeap, and the event with the earliest firing time is selected.
+/// After an event occurs, only the impacted events are updated:
+///
+/// - The selected event gets a new firing time, `t + Exp(rate)`
+/// - An impacted event with rate changing from `a_old` to `a_new` (both
+///   non-zero) keeps its remaining time, scaled: `t + (a_old / a_new) *
+///   (tau_old - t)`
+/// - An event becoming possible gets a new firing time; an event becoming
+///   impossible gets firing time infinity
+///
+/// Rates may also change with time, as piecewise-constant rate laws (i.e. a
+/// temperature schedule). With `set_rate_changes`, at each change time a
+/// function gives the new rates of all events, and all firing times are
+/// rescheduled with the same scaling, in O(N) and without re-calculating
+/// the event list or impact table. Selection is exact for
+/// piecewise-constant rates.
+///
+/// This has the same `select_event` / `total_rate` interface as
+/// RejectionFreeEventSelector, so it can be used with
+/// `monte::kinetic_monte_carlo` using EventIndex as the event ID type. The
+/// time increment returned by `select_event` is the difference between
+/// firing times, including any rate changes in between.
+///
+/// \tparam RateCalculatorType Must have methods
+///     `double calculate_rate(EventIndex event_index)` and
+///     `void calculate_rates(EventIndexRange event_index_list,
+///     std::vector<double> &rates)`.
+/// \tparam ImpactTableType Must have an `operator[](EventIndex event_index)`
+///     returning an EventIndexRange of the events which must have their
+///     rates updated when `event_index` occurs.
+/// \tparam EngineType Random number engine type
+template <typename RateCalculatorType, typename ImpactTableType,
+          typename EngineType = std::mt19937_64>
+class NextReactionEventSelector {
+ public:
+  /// \brief Gives the rates of all events after a rate change
+  ///
+  /// Called as `f(change_index, rates)`, it must update any conditions used
+  /// by the rate calculator and set `rates` to the new rate of every event,
+  /// by EventIndex.
+  typedef std::function<void(Index change_index, std::vector<double> &rates)>
+      rate_change_f_type;
+
+  /// \brief Constructor
+  ///
+  /// \param rate_calculator Event rate calculator
+  /// \param n_events Number of events. Events are indexed in the range
+  ///     [0, n_events), and all rates are calculated at construction.
+  /// \param impact_table Impact table. A reference is held and it must remain
+  ///     valid for the lifetime of the selector.
+  /// \param engine Random number engine
+  /// \param thread_rate_calculators Optional rate calculators, one per
+  ///     thread, used to calculate the initial rates in parallel, as for
+  ///     RejectionFreeEventSelector.
+  NextReactionEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator, Index n_events,
+      ImpactTableType const &impact_table,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>(),
+      std::vector<std::shared_ptr<RateCalculatorType>> const
+          &thread_rate_calculators = {})
+      : m_rate_calculator(rate_calculator),
+        m_impact_table(impact_table),
+        m_random_number_generator(engine),
+        m_time(0.0) {
+    std::vector<double> rates(n_events);
+    int n_threads = thread_rate_calculators.size();
+    if (n_threads <= 1) {
+      for (Index i = 0; i < n_events; ++i) {
+        rates[i] = m_rate_calculator->calculate_rate(EventIndex(i));
+      }
+    } else {
+      parallel_for_blocks(n_events, n_threads,
+                          [&](int thread_index, Index begin, Index end) {
+                            RateCalculatorType &calculator =
+                                *thread_rate_calculators[thread_index];
+                            for (Index i = begin; i < end; ++i) {
+                              rates[i] =
+                                  calculator.calculate_rate(EventIndex(i));
+                            }
+                          });
+    }
+    _initialize(rates);
+  }
+
+  /// \brief Constructor, with given initial rates
+  ///
+  /// \param rate_calculator Event rate calculator, used to update rates
+  /// \param initial_rates The current rates of all events, by EventIndex
+  /// \param impact_table Impact table. A reference is held and it must remain
+  ///     valid for the lifetime of the selector.
+  /// \param engine Random number engine
+  NextReactionEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator,
+      std::vector<double> const &initial_rates,
+      ImpactTableType const &impact_table,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>())
+      : m_rate_calculator(rate_calculator),
+        m_impact_table(impact_table),
+        m_random_number_generator(engine),
+        m_time(0.0) {
+    _initialize(initial_rates);
+  }
+
+  /// \brief Set times at which all rates change
+  ///
+  /// \param change_times Times, relative to the construction of the
+  ///     selector, at which rates change. Must be increasing.
+  /// \param rate_change_f Gives the new rates at each change time
+  void set_rate_changes(std::vector<double> const &change_times,
+                        rate_change_f_type rate_change_f) {
+    for (Index i = 1; i < change_times.size(); ++i) {
+      if (!(change_times[i] > change_times[i - 1])) {
+        throw std::runtime_error(
+            "Error in NextReactionEventSelector::set_rate_changes: change "
+            "times must be increasing");
+      }
+    }
+    m_change_times = change_times;
+    m_rate_change_f = rate_change_f;
+    m_next_change = 0;
+    while (m_next_change < m_change_times.size() &&
+           m_change_times[m_next_change] < m_time) {
+      ++m_next_change;
+    }
+  }
+
+  /// \brief Update impacted event rates, then select an event and return
+  ///     the time increment
+  ///
+  /// Notes:
+  /// - The rates of events impacted by the previously selected event are
+  ///   updated at the beginning of this call, so the previously selected
+  ///   event must have been applied to the state before calling this again.
+  /// - Rate changes scheduled before the next firing time are applied first.
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    if (m_last_selected.has_value()) {
+      _update_impacted_event_rates(*m_last_selected);
+      m_last_selected.reset();
+    }
+    double previous_time = m_time;
+    while (m_next_change < m_change_times.size() && m_heap.size() > 0 &&
+           !(m_heap.top_key() < m_change_times[m_next_change])) {
+      m_time = m_change_times[m_next_change];
+      m_rate_change_f(m_next_change, m_new_rates);
+      _reschedule_all(m_new_rates);
+      ++m_next_change;
+    }
+    if (m_heap.size() == 0 || std::isinf(m_heap.top_key())) {
+      throw std::runtime_error(
+          "Error in NextReactionEventSelector::select_event: total rate is "
+          "zero");
+    }
+    EventIndex selected = static_cast<EventIndex>(m_heap.top());
+    m_time = m_heap.top_key();
+    m_last_selected = selected;
+    return std::make_pair(selected, m_time - previous_time);
+  }
+
+  /// \brief Total rate of all events
+  double total_rate() const { return m_total_rate; }
+
+  /// \brief Current rate of an event
+  double get_rate(EventIndex event_index) const { return m_rate[event_index]; }
+
+  /// \brief Current putative firing time of an event
+  double get_firing_time(EventIndex event_index) const {
+    return m_heap.key(event_index);
+  }
+
+  /// \brief Number of events
+  Index size() const { return m_rate.size(); }
+
+  /// \brief Current time, relative to the construction of the selector
+  double time() const { return m_time; }
+
+  /// \brief Number of rate changes applied
+  Index n_rate_changes_applied() const { return m_next_change; }
+
+  /// \brief Update the rates of events impacted by the last selected event,
+  ///     if not already done
+  ///
+  /// This is done automatically by `select_event`. Call this after the last
+  /// selected event has been applied, at the end of a run, so that the rates
+  /// (and any rates stored by the rate calculator) are up-to-date.
+  void update_impacted_event_rates() {
+    if (m_last_selected.has_value()) {
+      _update_impacted_event_rates(*m_last_selected);
+      m_last_selected.reset();
+    }
+  }
+
+ private:
+  /// \brief Set rates and sample all firing times
+  void _initialize(std::vector<double> const &rates) {
+    m_rate = rates;
+    std::vector<double> firing_time(m_rate.size());
+    for (Index i = 0; i < m_rate.size(); ++i) {
+      firing_time[i] = _sample_firing_time(m_rate[i]);
+    }
+    m_heap.reset(firing_time);
+    _recalculate_total_rate();
+  }
+
+  /// \brief Sample a firing time, `m_time + Exp(rate)`, or infinity if
+  ///     `rate` is 0.0
+  double _sample_firing_time(double rate) {
+    if (!(rate > 0.0)) {
+      return std::numeric_limits<double>::infinity();
+    }
+    // u in (0, 1]
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    return m_time - std::log(u) / rate;
+  }
+
+  /// \brief Firing time after a rate change, keeping the remaining time if
+  ///     possible
+  double _rescheduled_firing_time(Index event_index, double new_rate) {
+    double old_rate = m_rate[event_index];
+    double old_firing_time = m_heap.key(event_index);
+    if (new_rate == old_rate) {
+      return old_firing_time;
+    }
+    if (old_rate > 0.0 && new_rate > 0.0) {
+      return m_time + (old_rate / new_rate) * (old_firing_time - m_time);
+    }
+    return _sample_firing_time(new_rate);
+  }
+
+  /// \brief Recalculate the rates of events impacted by an event
+  void _update_impacted_event_rates(EventIndex selected) {
+    EventIndexRange impacted = m_impact_table[selected];
+    m_rate_calculator->calculate_rates(impacted, m_impacted_rates);
+    double new_selected_rate = m_rate[selected];
+    for (Index i = 0; i < impacted.size(); ++i) {
+      EventIndex event_index = impacted[i];
+      double new_rate = m_impacted_rates[i];
+      if (event_index == selected) {
+        new_selected_rate = new_rate;
+        continue;
+      }
+      m_heap.set(event_index, _rescheduled_firing_time(event_index, new_rate));
+      _set_rate(event_index, new_rate);
+    }
+    // the selected event always gets a new firing time
+    _set_rate(selected, new_selected_rate);
+    m_heap.set(selected, _sample_firing_time(new_selected_rate));
+  }
+
+  /// \brief Reschedule all events after a change of rate law
+  void _reschedule_all(std::vector<double> const &new_rates) {
+    if (new_rates.size() != m_rate.size()) {
+      throw std::runtime_error(
+          "Error in NextReactionEventSelector: rate change size mismatch");
+    }
+    std::vector<double> firing_time(m_rate.size());
+    for (Index i = 0; i < m_rate.size(); ++i) {
+      firing_time[i] = _rescheduled_firing_time(i, new_rates[i]);
+    }
+    m_rate = new_rates;
+    m_heap.reset(firing_time);
+    _recalculate_total_rate();
+  }
+
+  /// \brief Set one rate, updating the total rate
+  void _set_rate(EventIndex event_index, double rate) {
+    m_total_rate += rate - m_rate[event_index];
+    m_rate[event_index] = rate;
+
+    // recalculate after O(N) updates so that rounding errors do not
+    // accumulate, at amortized O(1) cost
+    if (++m_n_rate_updates > m_rate.size()) {
+      _recalculate_total_rate();
+    }
+  }
+
+  /// \brief Recalculate the total rate from all rates
+  void _recalculate_total_rate() {
+    m_total_rate = 0.0;
+    for (double rate : m_rate) {
+      m_total_rate += rate;
+    }
+    m_n_rate_updates = 0;
+  }
+
+  std::shared_ptr<RateCalculatorType> m_rate_calculator;
+  ImpactTableType const &m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// Current rates, by EventIndex
+  std::vector<double> m_rate;
+
+  /// Putative absolute firing times, by EventIndex
+  IndexedMinHeap m_heap;
+
+  /// Current time
+  double m_time;
+
+  /// Sum of m_rate
+  double m_total_rate;
+
+  /// Number of rate updates since m_total_rate was recalculated
+  Index m_n_rate_updates;
+
+  std::optional<EventIndex> m_last_selected;
+
+  /// Rates of impacted events, as calculated by `calculate_rates`
+  std::vector<double> m_impacted_rates;
+
+  /// Rate law changes
+  std::vector<double> m_change_times;
+  rate_change_f_type m_rate_change_f;
+  Index m_next_change = 0;
+
+  /// New rates, set by m_rate_change_f
+  std::vector<double> m_new_rates;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
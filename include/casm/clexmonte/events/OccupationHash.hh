@@ -0,0 +1,59 @@
+#ifndef CASM_clexmonte_events_OccupationHash
+#define CASM_clexmonte_events_OccupationHash
+
+#include <cstdint>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief An incrementally updated hash of the occupation
+///
+/// OccupationHash is the XOR over all sites of a pseudo-random 64-bit value
+/// for each (site, occupant) pair (Zobrist hashing). When an event changes
+/// the occupation of a few sites, the hash is updated in O(1) per site, so
+/// configurations visited during a KMC run can be identified cheaply.
+///
+/// Notes:
+/// - The values for each (site, occupant) pair are generated on demand by a
+///   fixed mixing function, so no table is stored
+/// - Different occupations have the same hash with probability ~2^-64
+/// - This is not a copy of the occupation, so the current occupant must be
+///   given to `update`
+class OccupationHash {
+ public:
+  /// \brief Constructor, hash of `occupation`
+  explicit OccupationHash(Eigen::VectorXi const &occupation) : m_value(0) {
+    for (Index l = 0; l < occupation.size(); ++l) {
+      m_value ^= site_value(l, occupation(l));
+    }
+  }
+
+  /// \brief Current hash value
+  std::uint64_t value() const { return m_value; }
+
+  /// \brief Update the hash for a change of occupation on site `l`
+  void update(Index l, int old_occ, int new_occ) {
+    m_value ^= site_value(l, old_occ) ^ site_value(l, new_occ);
+  }
+
+  /// \brief Pseudo-random value for occupant `occ` on site `l`
+  static std::uint64_t site_value(Index l, int occ) {
+    // splitmix64 finalizer
+    std::uint64_t x = (static_cast<std::uint64_t>(l) << 8) +
+                      static_cast<std::uint64_t>(occ) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+ private:
+  std::uint64_t m_value;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
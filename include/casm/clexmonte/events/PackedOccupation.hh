@@ -0,0 +1,140 @@
+#ifndef CASM_clexmonte_events_PackedOccupation
+#define CASM_clexmonte_events_PackedOccupation
+
+#include <cstdint>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace xtal {
+class BasicStructure;
+}
+
+namespace clexmonte {
+
+/// \brief The occupation of the sites of an event, packed 8 bits per site
+///
+/// A PackedOccSignature is made once per prim event, from its initial
+/// occupation, and compared with `PackedOccupation::matches`, one word per 8
+/// event sites.
+///
+/// Notes:
+/// - Event site `i` is stored in word `i / 8` at bit offset `(i % 8) * 8`
+struct PackedOccSignature {
+  /// \brief Default constructor, no sites
+  PackedOccSignature() = default;
+
+  /// \brief Constructor
+  explicit PackedOccSignature(std::vector<int> const &occ);
+
+  std::vector<std::uint64_t> words;
+};
+
+/// \brief A compact copy of the occupation, using 1, 2, 4, or 8 bits per
+///     site
+///
+/// PackedOccupation is used to check whether events are allowed (i.e. the
+/// current occupation matches the event's initial occupation) before any
+/// cluster expansion is evaluated. Most events in a KMC or N-fold way
+/// calculation are not allowed, so most rate calculations end at this
+/// check, and with 2 bits per site the occupation of a large supercell fits
+/// in cache.
+///
+/// Notes:
+/// - Site `l` is stored in word `l / sites_per_word` at bit offset
+///   `(l % sites_per_word) * bits_per_site`. Both are powers of 2, so
+///   access is by shift and mask.
+/// - This is a copy, so it must be updated with `set` whenever the
+///   occupation changes. During KMC and N-fold way runs this is done as each
+///   selected event is applied.
+class PackedOccupation {
+ public:
+  /// \brief Default constructor, empty
+  PackedOccupation();
+
+  /// \brief Constructor
+  PackedOccupation(Eigen::VectorXi const &occupation, int n_occupants_max);
+
+  /// \brief Set all site occupations
+  void reset(Eigen::VectorXi const &occupation);
+
+  /// \brief Number of sites
+  Index size() const { return m_size; }
+
+  /// \brief Bits per site
+  int bits_per_site() const { return m_bits; }
+
+  /// \brief Occupation of site `l`
+  int get(Index l) const {
+    return static_cast<int>((m_words[l >> m_word_shift] >>
+                             ((l & m_site_mask) << m_bits_shift)) &
+                            m_occ_mask);
+  }
+
+  /// \brief Set the occupation of site `l`
+  void set(Index l, int occ) {
+    std::uint64_t &word = m_words[l >> m_word_shift];
+    int shift = (l & m_site_mask) << m_bits_shift;
+    word = (word & ~(m_occ_mask << shift)) |
+           (static_cast<std::uint64_t>(occ) << shift);
+  }
+
+  /// \brief Return true if the occupation of sites `linear_site_index`
+  ///     matches `signature`
+  ///
+  /// The sites of an event are at different positions in the packed words
+  /// for each translation, so the occupation of up to 8 event sites is
+  /// gathered into one word, without branching, and compared with the
+  /// corresponding word of `signature`.
+  bool matches(std::vector<Index> const &linear_site_index,
+               PackedOccSignature const &signature) const {
+    Index n = linear_site_index.size();
+    Index i = 0;
+    for (std::uint64_t expected : signature.words) {
+      std::uint64_t gathered = 0;
+      for (int shift = 0; shift < 64 && i < n; shift += 8, ++i) {
+        gathered |= static_cast<std::uint64_t>(get(linear_site_index[i]))
+                    << shift;
+      }
+      if (gathered != expected) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Approximate memory used, in bytes
+  std::size_t memory_usage() const {
+    return sizeof(*this) + m_words.capacity() * sizeof(std::uint64_t);
+  }
+
+ private:
+  Index m_size;
+
+  /// Bits per site: 1, 2, 4, or 8
+  int m_bits;
+
+  /// log2(m_bits)
+  int m_bits_shift;
+
+  /// log2(sites per word)
+  int m_word_shift;
+
+  /// sites per word - 1
+  Index m_site_mask;
+
+  /// (1 << m_bits) - 1
+  std::uint64_t m_occ_mask;
+
+  std::vector<std::uint64_t> m_words;
+};
+
+/// \brief Maximum number of occupants allowed on any sublattice
+int max_n_occupants(xtal::BasicStructure const &prim);
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef CASM_clexmonte_events_ParallelReplicaEventSelector
+#define CASM_clexmonte_events_ParallelReplicaEventSelector
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Accelerates rare-event KMC with parallel replica dynamics
+///
+/// ParallelReplicaEventSelector runs K independent replicas of the current
+/// state, each with its own occupation, event rates, and random number
+/// engine, one per thread, until one escapes from the current basin. The
+/// basin of a replica is identified by `ReplicaType::basin()` (i.e. a hash
+/// of part of the occupation, or binned order parameter values), so a
+/// replica escapes when an event changes its basin. Following Voter (Phys.
+/// Rev. B 57, R13985 (1998)), each escape is found in stages:
+///
+/// 1. Correlation: replica 0 runs for `correlation_time`. If it escapes,
+///    its trajectory is accepted with its own time, as in standard KMC.
+/// 2. Dephasing: meanwhile, the other replicas run for `correlation_time`
+///    from the current state, and are restarted if they escape. Time spent
+///    dephasing is not counted. Replicas which fail to dephase in
+///    `max_dephasing_attempts` attempts do not take part in stage 3.
+/// 3. Parallel: the n_active replicas run in blocks of `block_time`, in
+///    parallel, until at least one escapes. The first escape, at time
+///    `t_escape` after the beginning of stage 3, is accepted, and the
+///    simulated time is accumulated across replicas, as
+///    `correlation_time + n_active * t_escape`.
+///
+/// The events of the accepted replica's trajectory are then returned, one
+/// per call to `select_event`, so that they are applied to the state as
+/// usual by `monte::kinetic_monte_carlo`. All have time increment 0.0,
+/// except the escape event, which has the accumulated time.
+///
+/// Notes:
+/// - Parallel replica dynamics assumes that escape from a basin is a
+///   Poisson process, which holds approximately if the basin is a set of
+///   states that are visited many times before escape, and
+///   `correlation_time` is long compared to the time needed to lose memory
+///   of how the basin was entered. Within a basin, only the occupation at
+///   escape is meaningful; displacements within the basin are those of the
+///   accepted replica.
+/// - At the end of a block, a replica's pending event is discarded and its
+///   time is set to the end of the block, which is exact for KMC because
+///   the waiting time is exponentially distributed.
+/// - The replica which escapes is in the same state as the main state after
+///   its trajectory is applied, so it is not re-synchronized; the others
+///   are re-synchronized before the next escape. A replica differs from the
+///   main state only on the sites changed by the events it applied since it
+///   was last synchronized and by the events applied to the main state
+///   since then, so these events are passed to `synchronize`, which need
+///   only update what they impact.
+///
+/// \tparam ReplicaType Must have the methods `void
+///     synchronize(std::vector<EventIndex> const &changed_events)` (set the
+///     replica to the main state, which differs from the replica only on
+///     sites changed by `changed_events`), `std::pair<EventIndex, double>
+///     select_event()`, `void apply(EventIndex)` (apply the selected event
+///     to the replica), and `std::uint64_t basin() const`. Different
+///     replicas must not share data that is not thread-safe.
+template <typename ReplicaType>
+class ParallelReplicaEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param replicas The replicas, K >= 1. They are synchronized with the
+  ///     main state before the first escape.
+  /// \param correlation_time Duration of the correlation and dephasing
+  ///     stages
+  /// \param block_time Duration of each block of the parallel stage. Must
+  ///     be > 0.0, so that replicas which do not escape are stopped.
+  /// \param thread_pool Threads used to run replicas, one block of
+  ///     replicas per thread. If null, replicas are run serially.
+  /// \param max_dephasing_attempts Maximum number of attempts to dephase
+  ///     each replica, per escape
+  ParallelReplicaEventSelector(
+      std::vector<std::shared_ptr<ReplicaType>> replicas,
+      double correlation_time, double block_time,
+      std::shared_ptr<ThreadPool> thread_pool = std::shared_ptr<ThreadPool>(),
+      Index max_dephasing_attempts = 100)
+      : m_replicas(replicas),
+        m_correlation_time(correlation_time),
+        m_block_time(block_time),
+        m_thread_pool(thread_pool),
+        m_max_dephasing_attempts(max_dephasing_attempts),
+        m_status(replicas.size()) {
+    if (m_replicas.empty()) {
+      throw std::runtime_error(
+          "Error constructing ParallelReplicaEventSelector: no replicas");
+    }
+    if (!(m_correlation_time >= 0.0)) {
+      throw std::runtime_error(
+          "Error constructing ParallelReplicaEventSelector: requires "
+          "correlation_time >= 0.0");
+    }
+    if (!(m_block_time > 0.0)) {
+      throw std::runtime_error(
+          "Error constructing ParallelReplicaEventSelector: requires "
+          "block_time > 0.0");
+    }
+  }
+
+  /// \brief Select an event and return the time increment
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    if (m_path.empty()) {
+      _escape();
+    }
+    EventIndex event_index = m_path.front();
+    m_path.pop_front();
+    if (!m_path.empty()) {
+      return std::make_pair(event_index, 0.0);
+    }
+    return std::make_pair(event_index, m_escape_time);
+  }
+
+  /// \brief Mean escape rate so far, as the number of escapes per unit time
+  ///
+  /// The total rate of the main state is not calculated, so this gives the
+  /// rate at which the state changes basin instead.
+  double total_rate() const {
+    return (m_total_time > 0.0) ? m_n_escapes / m_total_time : 0.0;
+  }
+
+  /// \brief Number of replicas
+  Index n_replicas() const { return m_replicas.size(); }
+
+  /// \brief Number of escapes
+  Index n_escapes() const { return m_n_escapes; }
+
+  /// \brief Number of escapes found in the correlation stage
+  Index n_correlated_escapes() const { return m_n_correlated_escapes; }
+
+  /// \brief Number of events applied along accepted trajectories
+  Index n_path_events() const { return m_n_path_events; }
+
+  /// \brief Total number of events applied by all replicas
+  Index n_replica_events() const {
+    Index total = 0;
+    for (Status const &status : m_status) {
+      total += status.n_events;
+    }
+    return total;
+  }
+
+  /// \brief Total simulated time of all escapes
+  double total_time() const { return m_total_time; }
+
+ private:
+  /// \brief Data for each replica, written only by the thread running it
+  struct Status {
+    /// True if in the main state, except for the trajectory in `history`
+    bool is_synchronized = false;
+
+    /// Basin of the main state, as found when synchronized
+    std::uint64_t initial_basin = 0;
+
+    /// Events applied since synchronized
+    std::vector<EventIndex> history;
+
+    /// Events applied to the replica or to the main state, not including
+    /// `history`, since the replica was last synchronized
+    std::vector<EventIndex> changed_events;
+
+    /// Time in the current stage
+    double time = 0.0;
+
+    /// True if taking part in the parallel stage
+    bool is_active = false;
+
+    /// True if escaped in the current stage
+    bool has_escaped = false;
+
+    /// Total number of events applied
+    Index n_events = 0;
+  };
+
+  /// \brief Run the replicas until one escapes, and set `m_path` and
+  ///     `m_escape_time`
+  void _escape() {
+    Index n = m_replicas.size();
+
+    // stages 1 and 2: correlation and dephasing
+    _for_each_replica([&](Index k) { _dephase(k); });
+
+    Index winner = -1;
+    double escape_time = 0.0;
+    if (m_status[0].has_escaped) {
+      winner = 0;
+      escape_time = m_status[0].time;
+      ++m_n_correlated_escapes;
+    } else {
+      // stage 3: parallel, times from the beginning of the stage
+      Index n_active = 0;
+      for (Status &status : m_status) {
+        status.time = 0.0;
+        if (status.is_active) {
+          ++n_active;
+        }
+      }
+      double block_end = 0.0;
+      while (winner == -1) {
+        block_end += m_block_time;
+        _for_each_replica([&](Index k) {
+          if (m_status[k].is_active) {
+            _run(k, block_end);
+          }
+        });
+        for (Index k = 0; k < n; ++k) {
+          Status const &status = m_status[k];
+          if (status.is_active && status.has_escaped &&
+              (winner == -1 || status.time < m_status[winner].time)) {
+            winner = k;
+          }
+        }
+      }
+      escape_time = m_correlation_time + n_active * m_status[winner].time;
+    }
+
+    std::vector<EventIndex> const &history = m_status[winner].history;
+    m_path.assign(history.begin(), history.end());
+    m_escape_time = escape_time;
+    for (Index k = 0; k < n; ++k) {
+      Status &status = m_status[k];
+      if (k == winner) {
+        status.is_synchronized = true;
+        status.history.clear();
+      } else {
+        status.is_synchronized = false;
+        status.changed_events.insert(status.changed_events.end(),
+                                     m_path.begin(), m_path.end());
+      }
+    }
+    ++m_n_escapes;
+    m_n_path_events += m_path.size();
+    m_total_time += escape_time;
+  }
+
+  /// \brief Call `f(k)` for each replica, in parallel if there is a thread
+  ///     pool
+  template <typename F>
+  void _for_each_replica(F f) {
+    Index n = m_replicas.size();
+    if (!m_thread_pool) {
+      for (Index k = 0; k < n; ++k) {
+        f(k);
+      }
+      return;
+    }
+    m_thread_pool->for_blocks(n, [&](int thread_index, Index begin,
+                                     Index end) {
+      for (Index k = begin; k < end; ++k) {
+        f(k);
+      }
+    });
+  }
+
+  /// \brief Synchronize replica `k` with the main state, if necessary, and
+  ///     clear its trajectory
+  void _synchronize(Index k) {
+    Status &status = m_status[k];
+    if (!status.is_synchronized) {
+      status.changed_events.insert(status.changed_events.end(),
+                                   status.history.begin(),
+                                   status.history.end());
+      m_replicas[k]->synchronize(status.changed_events);
+      status.changed_events.clear();
+      status.is_synchronized = true;
+    }
+    status.initial_basin = m_replicas[k]->basin();
+    status.history.clear();
+    status.time = 0.0;
+    status.has_escaped = false;
+  }
+
+  /// \brief Stage 1 (replica 0) or stage 2 (other replicas)
+  void _dephase(Index k) {
+    Status &status = m_status[k];
+    status.is_active = false;
+    for (Index attempt = 0; attempt < m_max_dephasing_attempts; ++attempt) {
+      _synchronize(k);
+      _run(k, m_correlation_time);
+      if (!status.has_escaped) {
+        status.is_active = true;
+        return;
+      }
+      if (k == 0) {
+        return;
+      }
+      status.is_synchronized = false;
+    }
+  }
+
+  /// \brief Run replica `k` until `end_time` or until it escapes
+  void _run(Index k, double end_time) {
+    ReplicaType &replica = *m_replicas[k];
+    Status &status = m_status[k];
+    while (true) {
+      std::pair<EventIndex, double> result = replica.select_event();
+      if (status.time + result.second >= end_time) {
+        status.time = end_time;
+        return;
+      }
+      status.time += result.second;
+      replica.apply(result.first);
+      status.history.push_back(result.first);
+      ++status.n_events;
+      if (replica.basin() != status.initial_basin) {
+        status.has_escaped = true;
+        return;
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<ReplicaType>> m_replicas;
+  double m_correlation_time;
+  double m_block_time;
+  std::shared_ptr<ThreadPool> m_thread_pool;
+  Index m_max_dephasing_attempts;
+
+  /// Status of each replica
+  std::vector<Status> m_status;
+
+  /// Pending trajectory
+  std::deque<EventIndex> m_path;
+  double m_escape_time = 0.0;
+
+  Index m_n_escapes = 0;
+  Index m_n_correlated_escapes = 0;
+  Index m_n_path_events = 0;
+  double m_total_time = 0.0;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
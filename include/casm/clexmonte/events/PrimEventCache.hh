@@ -0,0 +1,268 @@
+#ifndef CASM_clexmonte_events_PrimEventCache
+#define CASM_clexmonte_events_PrimEventCache
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/events/event_methods.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/global/filesystem.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief 64-bit FNV-1a hash, used to identify cached data
+class FNV1aHash {
+ public:
+  FNV1aHash() : m_value(14695981039346656037ULL) {}
+
+  /// \brief Add raw bytes
+  void add_bytes(void const *data, std::size_t size) {
+    unsigned char const *bytes = static_cast<unsigned char const *>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+      m_value ^= bytes[i];
+      m_value *= 1099511628211ULL;
+    }
+  }
+
+  void add(std::int64_t value) { add_bytes(&value, sizeof(value)); }
+
+  void add(double value) { add_bytes(&value, sizeof(value)); }
+
+  void add(std::string const &value) {
+    add(std::int64_t(value.size()));
+    add_bytes(value.data(), value.size());
+  }
+
+  void add(xtal::UnitCellCoord const &site) {
+    add(std::int64_t(site.sublattice()));
+    for (Index k = 0; k < 3; ++k) {
+      add(std::int64_t(site.unitcell()(k)));
+    }
+  }
+
+  template <typename ContainerType>
+  void add_sites(ContainerType const &sites) {
+    add(std::int64_t(sites.size()));
+    for (xtal::UnitCellCoord const &site : sites) {
+      add(site);
+    }
+  }
+
+  void add(clexulator::SparseCoefficients const &coefficients) {
+    add(std::int64_t(coefficients.index.size()));
+    for (Index i = 0; i < coefficients.index.size(); ++i) {
+      add(std::int64_t(coefficients.index[i]));
+      add(coefficients.value[i]);
+    }
+  }
+
+  void add(BasisSetClusterInfo const &cluster_info) {
+    add(std::int64_t(cluster_info.orbits.size()));
+    for (auto const &orbit : cluster_info.orbits) {
+      add(std::int64_t(orbit.size()));
+      for (clust::IntegralCluster const &cluster : orbit) {
+        add_sites(cluster.elements());
+      }
+    }
+    add(std::int64_t(cluster_info.function_to_orbit_index.size()));
+    for (Index i : cluster_info.function_to_orbit_index) {
+      add(std::int64_t(i));
+    }
+  }
+
+  void add(xtal::BasicStructure const &prim) {
+    Eigen::Matrix3d const &L = prim.lattice().lat_column_mat();
+    for (Index i = 0; i < 9; ++i) {
+      add(L(i));
+    }
+    add(std::int64_t(prim.basis().size()));
+    for (auto const &site : prim.basis()) {
+      Eigen::Vector3d const &frac = site.const_frac();
+      for (Index k = 0; k < 3; ++k) {
+        add(frac(k));
+      }
+      add(std::int64_t(site.occupant_dof().size()));
+      for (auto const &occupant : site.occupant_dof()) {
+        add(occupant.name());
+      }
+    }
+  }
+
+  std::uint64_t value() const { return m_value; }
+
+ private:
+  std::uint64_t m_value;
+};
+
+/// \brief Prim event data which may be cached between runs
+struct PrimEventCacheData {
+  /// \brief Information about what sites may impact each prim event
+  std::vector<EventImpactInfo> prim_impact_info_list;
+
+  /// \brief Events impacted by each prim event, relative to the origin
+  ///     unit cell
+  std::vector<std::vector<RelativeEventID>> relative_impact_table;
+};
+
+/// \brief Hash the data that determines the prim impact info list
+template <typename SystemType>
+std::uint64_t hash_prim_impact_info_inputs(
+    SystemType const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names = {"formation_energy"},
+    std::vector<std::string> const &multiclex_names = {});
+
+/// \brief Read cached prim event data, if it exists and matches `hash`
+bool read_prim_event_cache(PrimEventCacheData &data,
+                           fs::path const &filepath, std::uint64_t hash);
+
+/// \brief Write prim event data to a cache file
+void write_prim_event_cache(PrimEventCacheData const &data,
+                            fs::path const &filepath, std::uint64_t hash);
+
+/// \brief Make prim impact info and relative impact table, using a cache
+///     if available
+template <typename SystemType>
+PrimEventCacheData make_prim_event_cache_data(
+    SystemType const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names = {"formation_energy"},
+    std::vector<std::string> const &multiclex_names = {},
+    std::string const &cache_dir = "");
+
+// --- Inline definitions ---
+
+/// \brief Hash the data that determines the prim impact info list
+///
+/// The hash includes:
+/// - the prim lattice, basis, and occupants,
+/// - the prim events (type, equivalent index, direction, sites, and
+///   occupation),
+/// - for each event with a local multi-cluster expansion, the local basis
+///   set name, coefficients, and the required update neighborhood given by
+///   the local Clexulator, and
+/// - for each clex and multiclex, the basis set cluster info and
+///   coefficients.
+///
+/// The local Clexulator neighborhood is included directly because it is
+/// determined by compiled code and is inexpensive to get, unlike the
+/// expansion of the phenomenal cluster by the basis set cluster info.
+template <typename SystemType>
+std::uint64_t hash_prim_impact_info_inputs(
+    SystemType const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names,
+    std::vector<std::string> const &multiclex_names) {
+  FNV1aHash hash;
+  hash.add(*get_prim_basicstructure(system));
+
+  hash.add(std::int64_t(prim_event_list.size()));
+  for (PrimEventData const &data : prim_event_list) {
+    hash.add(data.event_type_name);
+    hash.add(std::int64_t(data.equivalent_index));
+    hash.add(std::int64_t(data.is_forward));
+    hash.add_sites(data.sites);
+    for (int occ : data.occ_init) {
+      hash.add(std::int64_t(occ));
+    }
+    for (int occ : data.occ_final) {
+      hash.add(std::int64_t(occ));
+    }
+
+    OccEventTypeData const &event_type_data =
+        get_event_type_data(system, data.event_type_name);
+    hash.add(event_type_data.local_multiclex_name);
+    if (!event_type_data.local_multiclex_name.empty()) {
+      LocalMultiClexData const &local_multiclex_data = get_local_multiclex_data(
+          system, event_type_data.local_multiclex_name);
+      hash.add(local_multiclex_data.local_basis_set_name);
+      for (auto const &coeffs : local_multiclex_data.coefficients) {
+        hash.add(coeffs);
+      }
+      hash.add_sites(get_required_update_neighborhood(
+          system, local_multiclex_data, data.equivalent_index));
+    }
+  }
+
+  for (auto const &name : clex_names) {
+    ClexData const &clex_data = get_clex_data(system, name);
+    hash.add(name);
+    hash.add(clex_data.coefficients);
+    if (clex_data.cluster_info) {
+      hash.add(*clex_data.cluster_info);
+    }
+  }
+
+  for (auto const &name : multiclex_names) {
+    MultiClexData const &multiclex_data = get_multiclex_data(system, name);
+    hash.add(name);
+    for (auto const &coeffs : multiclex_data.coefficients) {
+      hash.add(coeffs);
+    }
+    if (multiclex_data.cluster_info) {
+      hash.add(*multiclex_data.cluster_info);
+    }
+  }
+  return hash.value();
+}
+
+/// \brief Make prim impact info and relative impact table, using a cache
+///     if available
+///
+/// \param system The system
+/// \param prim_event_list The prim event list
+/// \param clex_names Names of the clex whose basis sets determine the
+///     required update neighborhoods, as for `make_prim_impact_info_list`
+/// \param multiclex_names Names of the multiclex whose basis sets determine
+///     the required update neighborhoods, as for `make_prim_impact_info_list`
+/// \param cache_dir If not empty, the directory where cached data is read
+///     from and written to. The cache file name includes the hash of the
+///     input data, as given by `hash_prim_impact_info_inputs`, so if the
+///     system changes the data is recalculated and written to a new file. If
+///     the cache file can not be read or written, the data is calculated.
+///
+/// \returns Prim impact info and relative impact table, equal to the result
+///     of `make_prim_impact_info_list` and `make_relative_impact_table`
+template <typename SystemType>
+PrimEventCacheData make_prim_event_cache_data(
+    SystemType const &system, std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::string> const &clex_names,
+    std::vector<std::string> const &multiclex_names,
+    std::string const &cache_dir) {
+  PrimEventCacheData data;
+  fs::path filepath;
+  std::uint64_t hash = 0;
+  if (!cache_dir.empty()) {
+    hash = hash_prim_impact_info_inputs(system, prim_event_list, clex_names,
+                                        multiclex_names);
+    std::stringstream ss;
+    ss << "prim_events_" << std::hex << hash << ".bin";
+    filepath = fs::path(cache_dir) / ss.str();
+    if (read_prim_event_cache(data, filepath, hash)) {
+      return data;
+    }
+  }
+
+  data.prim_impact_info_list = make_prim_impact_info_list(
+      system, prim_event_list, clex_names, multiclex_names);
+  data.relative_impact_table =
+      make_relative_impact_table(data.prim_impact_info_list);
+
+  if (!cache_dir.empty()) {
+    try {
+      write_prim_event_cache(data, filepath, hash);
+    } catch (std::exception &e) {
+      CASM::err_log() << "Warning: could not write prim event cache: "
+                      << e.what() << std::endl;
+    }
+  }
+  return data;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef CASM_clexmonte_events_RateClassTable
+#define CASM_clexmonte_events_RateClassTable
+
+#include "casm/clexmonte/events/BinnedRejectionTable.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Values grouped into rate classes, for Bortz-Kalos-Lebowitz (BKL)
+///     style O(1) weighted selection
+///
+/// For Metropolis-like rates, `rate = min(1, exp(-beta * dE))`, this groups
+/// events by quantized `beta * dE`, with 4 classes per factor of 2 in rate.
+/// Compared to CompositionRejectionTable, classes are narrower, so values
+/// are rejected less often. Classes are searched in order of decreasing
+/// rate, so at low temperature, when the fastest classes hold most of the
+/// total rate, the search usually stops at the first class; and the rate
+/// 1.0 shared by all downhill swaps in the N-fold way is accepted without
+/// rejection. See BinnedRejectionTable.
+typedef BinnedRejectionTable<4> RateClassTable;
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
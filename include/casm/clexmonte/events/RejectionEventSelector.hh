@@ -0,0 +1,213 @@
+#ifndef CASM_clexmonte_events_RejectionEventSelector
+#define CASM_clexmonte_events_RejectionEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection event selector for events indexed by EventIndex
+///
+/// RejectionEventSelector implements rejection KMC: a candidate event is
+/// chosen with probability proportional to an upper bound on its rate, which
+/// depends only on its prim event, and then accepted with probability
+/// `rate / upper_bound`. Time is advanced for each trial, accepted or not,
+/// by sampling from the total upper bound rate. Rates are calculated only for
+/// candidate events, so no impact table and no stored rates are needed, and
+/// memory and setup time are O(1) in the number of events.
+///
+/// If a candidate's rate exceeds its upper bound, the bound is raised to
+/// that rate, the violation is counted by `n_bound_exceeded`, and the trial
+/// is discarded: selection restarts with the raised bound, so the candidate
+/// is never accepted with a bound that is too small. Time already
+/// accumulated from rejected trials is kept. Raised bounds persist, so each
+/// violation slows later selection by increasing the rejection fraction.
+///
+/// This has the same `select_event` / `total_rate` interface as
+/// RejectionFreeEventSelector, so it can be used with
+/// `monte::kinetic_monte_carlo` using EventIndex as the event ID type.
+///
+/// \tparam RateCalculatorType Must have a method
+///     `double calculate_rate(EventIndex event_index)`.
+/// \tparam EngineType Random number engine type
+template <typename RateCalculatorType, typename EngineType = std::mt19937_64>
+class RejectionEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param rate_calculator Event rate calculator
+  /// \param n_unitcells Number of unit cells. Events are indexed by
+  ///     `unitcell_index * n_prim_events + prim_event_index`.
+  /// \param prim_event_rate_upper_bound Upper bound on the rate of each prim
+  ///     event, by prim event index. Must be >= 0.0 and have at least one
+  ///     value > 0.0. Prim events with bound 0.0 are never selected.
+  /// \param engine Random number engine
+  RejectionEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator, Index n_unitcells,
+      std::vector<double> const &prim_event_rate_upper_bound,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>())
+      : m_rate_calculator(rate_calculator),
+        m_n_unitcells(n_unitcells),
+        m_upper_bound(prim_event_rate_upper_bound),
+        m_random_number_generator(engine),
+        m_n_trials(0),
+        m_n_accepted(0),
+        m_n_bound_exceeded(0) {
+    for (double bound : m_upper_bound) {
+      if (!(bound >= 0.0)) {
+        throw std::runtime_error(
+            "Error constructing RejectionEventSelector: rate upper bound < "
+            "0.0");
+      }
+    }
+    if (m_n_unitcells < 1) {
+      throw std::runtime_error(
+          "Error constructing RejectionEventSelector: n_unitcells < 1");
+    }
+    _update_cumulative_bound();
+  }
+
+  /// \brief Select an event by rejection and sample the time increment
+  ///
+  /// \returns (selected event index, time increment), where the time
+  ///     increment includes all rejected trials
+  std::pair<EventIndex, double> select_event() {
+    Index n_prim_events = m_upper_bound.size();
+    double time_increment = 0.0;
+    while (true) {
+      // time increment: -ln(u) / total_rate, with u in (0, 1]
+      double u = 1.0 - m_random_number_generator.random_real(1.0);
+      time_increment += -std::log(u) / m_total_rate;
+      ++m_n_trials;
+
+      // candidate, with probability proportional to its upper bound
+      double x = m_random_number_generator.random_real(m_total_rate);
+      Index unitcell_index =
+          std::min(Index(x / m_unitcell_bound), m_n_unitcells - 1);
+      double r = x - unitcell_index * m_unitcell_bound;
+      Index prim_event_index =
+          std::upper_bound(m_cumulative_bound.begin(),
+                           m_cumulative_bound.end(), r) -
+          m_cumulative_bound.begin();
+      prim_event_index = std::min(prim_event_index, n_prim_events - 1);
+      EventIndex event_index = static_cast<EventIndex>(
+          unitcell_index * n_prim_events + prim_event_index);
+
+      double bound = m_upper_bound[prim_event_index];
+      double rate = m_rate_calculator->calculate_rate(event_index);
+      if (rate > bound) {
+        // discard the trial, and restart with the raised bound
+        ++m_n_bound_exceeded;
+        m_upper_bound[prim_event_index] = rate;
+        _update_cumulative_bound();
+        continue;
+      }
+      if (rate > 0.0 && m_random_number_generator.random_real(bound) < rate) {
+        ++m_n_accepted;
+        return std::make_pair(event_index, time_increment);
+      }
+    }
+  }
+
+  /// \brief Total upper bound rate, summed over all events
+  double total_rate() const { return m_total_rate; }
+
+  /// \brief Current upper bound on the rate of each prim event
+  std::vector<double> const &prim_event_rate_upper_bound() const {
+    return m_upper_bound;
+  }
+
+  /// \brief Number of trials
+  Index n_trials() const { return m_n_trials; }
+
+  /// \brief Number of accepted trials
+  Index n_accepted() const { return m_n_accepted; }
+
+  /// \brief Fraction of trials rejected
+  double rejection_fraction() const {
+    if (m_n_trials == 0) {
+      return 0.0;
+    }
+    return 1.0 - static_cast<double>(m_n_accepted) / m_n_trials;
+  }
+
+  /// \brief Number of candidate events with rate greater than the upper bound
+  Index n_bound_exceeded() const { return m_n_bound_exceeded; }
+
+ private:
+  void _update_cumulative_bound() {
+    m_cumulative_bound.resize(m_upper_bound.size());
+    double sum = 0.0;
+    for (Index i = 0; i < m_upper_bound.size(); ++i) {
+      sum += m_upper_bound[i];
+      m_cumulative_bound[i] = sum;
+    }
+    m_unitcell_bound = sum;
+    m_total_rate = sum * m_n_unitcells;
+    if (!(m_total_rate > 0.0)) {
+      throw std::runtime_error(
+          "Error in RejectionEventSelector: total upper bound rate is zero");
+    }
+  }
+
+  std::shared_ptr<RateCalculatorType> m_rate_calculator;
+  Index m_n_unitcells;
+
+  /// Upper bound on rate, by prim event index
+  std::vector<double> m_upper_bound;
+
+  /// Cumulative sum of m_upper_bound
+  std::vector<double> m_cumulative_bound;
+
+  /// Sum of upper bounds for the events in one unit cell
+  double m_unitcell_bound;
+
+  /// Sum of upper bounds for all events
+  double m_total_rate;
+
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+  Index m_n_trials;
+  Index m_n_accepted;
+  Index m_n_bound_exceeded;
+};
+
+/// \brief Calibrate rate upper bounds by calculating all event rates
+///
+/// \param rate_calculator Event rate calculator
+/// \param n_unitcells Number of unit cells
+/// \param n_prim_events Number of prim events
+///
+/// \returns The maximum calculated rate of each prim event, over all unit
+///     cells, for the current state
+template <typename RateCalculatorType>
+std::vector<double> calibrate_prim_event_rate_upper_bound(
+    RateCalculatorType &rate_calculator, Index n_unitcells,
+    Index n_prim_events) {
+  std::vector<double> max_rate(n_prim_events, 0.0);
+  EventIndex event_index = 0;
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    for (Index prim_event_index = 0; prim_event_index < n_prim_events;
+         ++prim_event_index) {
+      max_rate[prim_event_index] =
+          std::max(max_rate[prim_event_index],
+                   rate_calculator.calculate_rate(event_index));
+      ++event_index;
+    }
+  }
+  return max_rate;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
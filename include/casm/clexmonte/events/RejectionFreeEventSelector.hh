@@ -0,0 +1,274 @@
+#ifndef CASM_clexmonte_events_RejectionFreeEventSelector
+#define CASM_clexmonte_events_RejectionFreeEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/CompositionRejectionTable.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/SumTree.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Rejection-free event selector for events indexed by EventIndex
+///
+/// RejectionFreeEventSelector selects events with probability proportional
+/// to their rate and samples the time increment, updating the rates of
+/// impacted events after each selected event has occurred. Events are
+/// indexed by EventIndex in the range [0, n_events), so rates are stored in
+/// a rate table (by default, a SumTree) and looked up by array access.
+///
+/// This has the same `select_event` / `total_rate` interface as
+/// `lotto::RejectionFreeEventSelector`, so it can be used with
+/// `monte::kinetic_monte_carlo` and `monte::nfold` using EventIndex as the
+/// event ID type.
+///
+/// \tparam RateCalculatorType Must have methods
+///     `double calculate_rate(EventIndex event_index)` and
+///     `void calculate_rates(EventIndexRange event_index_list,
+///     std::vector<double> &rates)`, which is used to update the rates of
+///     all events impacted by an event at once.
+/// \tparam ImpactTableType Must have an `operator[](EventIndex event_index)`
+///     returning an EventIndexRange of the events which must have their
+///     rates updated when `event_index` occurs.
+/// \tparam EngineType Random number engine type
+/// \tparam RateTableType Stores rates and selects events, SumTree
+///     (O(log N) update and selection) or CompositionRejectionTable (O(1)
+///     update and expected O(1) selection).
+template <typename RateCalculatorType, typename ImpactTableType,
+          typename EngineType = std::mt19937_64,
+          typename RateTableType = SumTree>
+class RejectionFreeEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param rate_calculator Event rate calculator
+  /// \param n_events Number of events. Events are indexed in the range
+  ///     [0, n_events), and all rates are calculated at construction.
+  /// \param impact_table Impact table. A reference is held and it must remain
+  ///     valid for the lifetime of the selector.
+  /// \param engine Random number engine
+  /// \param thread_rate_calculators Optional rate calculators, one per
+  ///     thread, used to calculate the initial rates in parallel. They must
+  ///     calculate the same rates as `rate_calculator`, and must not share
+  ///     data that is not thread-safe. Events are split between threads in
+  ///     contiguous blocks and each rate is calculated independently, so the
+  ///     result does not depend on the number of threads. If empty, the
+  ///     initial rates are calculated by `rate_calculator`.
+  RejectionFreeEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator, Index n_events,
+      ImpactTableType const &impact_table,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>(),
+      std::vector<std::shared_ptr<RateCalculatorType>> const
+          &thread_rate_calculators = {})
+      : m_rate_calculator(rate_calculator),
+        m_impact_table(impact_table),
+        m_random_number_generator(engine),
+        m_rate_table(n_events),
+        m_thread_rate_calculators(thread_rate_calculators),
+        m_parallel_update_min_size(0) {
+    std::vector<double> rates(n_events);
+    int n_threads = thread_rate_calculators.size();
+    if (n_threads <= 1) {
+      for (Index i = 0; i < n_events; ++i) {
+        rates[i] = m_rate_calculator->calculate_rate(EventIndex(i));
+      }
+      n_threads = 1;
+    } else {
+      parallel_for_blocks(n_events, n_threads,
+                          [&](int thread_index, Index begin, Index end) {
+                            RateCalculatorType &calculator =
+                                *thread_rate_calculators[thread_index];
+                            for (Index i = begin; i < end; ++i) {
+                              rates[i] =
+                                  calculator.calculate_rate(EventIndex(i));
+                            }
+                          });
+    }
+    m_rate_table.reset(rates, n_threads);
+  }
+
+  /// \brief Constructor, with given initial rates
+  ///
+  /// \param rate_calculator Event rate calculator, used to update rates
+  /// \param initial_rates The current rates of all events, by EventIndex
+  ///     (i.e. as rescaled from cached activation energies after a change of
+  ///     temperature)
+  /// \param impact_table Impact table. A reference is held and it must remain
+  ///     valid for the lifetime of the selector.
+  /// \param engine Random number engine
+  /// \param thread_rate_calculators Optional rate calculators, one per
+  ///     thread, which may be used to update rates in parallel (see
+  ///     `set_parallel_update`)
+  RejectionFreeEventSelector(
+      std::shared_ptr<RateCalculatorType> rate_calculator,
+      std::vector<double> const &initial_rates,
+      ImpactTableType const &impact_table,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>(),
+      std::vector<std::shared_ptr<RateCalculatorType>> const
+          &thread_rate_calculators = {})
+      : m_rate_calculator(rate_calculator),
+        m_impact_table(impact_table),
+        m_random_number_generator(engine),
+        m_rate_table(initial_rates),
+        m_thread_rate_calculators(thread_rate_calculators),
+        m_parallel_update_min_size(0) {}
+
+  /// \brief Update impacted event rates in parallel for large impact lists
+  ///
+  /// \param thread_pool Threads used for the update. Must have no more
+  ///     threads than the number of `thread_rate_calculators` given at
+  ///     construction. A reference is held.
+  /// \param min_size Impact lists with at least this many events are
+  ///     updated in parallel, using the `thread_rate_calculators`. Smaller
+  ///     impact lists are updated serially by `rate_calculator`. If
+  ///     `min_size < 1`, all updates are serial.
+  ///
+  /// Each thread calculates rates for a contiguous block of the impact list
+  /// with its own calculator, and then the rate table is updated serially, so
+  /// the result does not depend on the number of threads. Impact lists must
+  /// not contain duplicate events, so that no two threads calculate (and
+  /// cache) the same event, as guaranteed by CompressedEventImpactTable.
+  void set_parallel_update(std::shared_ptr<ThreadPool> thread_pool,
+                           Index min_size) {
+    if (thread_pool &&
+        thread_pool->n_threads() > m_thread_rate_calculators.size()) {
+      throw std::runtime_error(
+          "Error in RejectionFreeEventSelector::set_parallel_update: too few "
+          "thread rate calculators");
+    }
+    m_thread_pool = thread_pool;
+    m_parallel_update_min_size = min_size;
+  }
+
+  /// \brief Update impacted event rates, then select an event and sample the
+  ///     time increment
+  ///
+  /// Notes:
+  /// - The rates of events impacted by the previously selected event are
+  ///   updated at the beginning of this call, so the previously selected
+  ///   event must have been applied to the state before calling this again.
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    if (m_last_selected.has_value()) {
+      _update_impacted_event_rates(*m_last_selected);
+    }
+    double total_rate = m_rate_table.total();
+    if (!(total_rate > 0.0)) {
+      throw std::runtime_error(
+          "Error in RejectionFreeEventSelector::select_event: total rate is "
+          "zero");
+    }
+    EventIndex selected = static_cast<EventIndex>(
+        m_rate_table.select(m_random_number_generator));
+    m_last_selected = selected;
+
+    // time increment: -ln(u) / total_rate, with u in (0, 1]
+    double u = 1.0 - m_random_number_generator.random_real(1.0);
+    double time_increment = -std::log(u) / total_rate;
+    return std::make_pair(selected, time_increment);
+  }
+
+  /// \brief Total rate of all events
+  double total_rate() const { return m_rate_table.total(); }
+
+  /// \brief Current rate of an event
+  double get_rate(EventIndex event_index) const {
+    return m_rate_table.value(event_index);
+  }
+
+  /// \brief Number of events
+  Index size() const { return m_rate_table.size(); }
+
+  /// \brief Set the current rate of an event
+  ///
+  /// This may be used to temporarily exclude events from selection (i.e.
+  /// superbasin transitions). The rate is recalculated the next time the
+  /// event is impacted.
+  void set_rate(EventIndex event_index, double rate) {
+    m_rate_table.set(event_index, rate);
+  }
+
+  /// \brief Set the last selected event, as if selected by `select_event`
+  ///
+  /// This is used when an event is chosen by other means and then applied,
+  /// so that the rates of events it impacts are updated on the next call to
+  /// `select_event` or `update_impacted_event_rates`.
+  void set_last_selected(EventIndex event_index) {
+    update_impacted_event_rates();
+    m_last_selected = event_index;
+  }
+
+  /// \brief Update the rates of events impacted by the last selected event,
+  ///     if not already done
+  ///
+  /// This is done automatically by `select_event`. Call this after the last
+  /// selected event has been applied, at the end of a run, so that the rates
+  /// (and any rates stored by the rate calculator) are up-to-date.
+  void update_impacted_event_rates() {
+    if (m_last_selected.has_value()) {
+      _update_impacted_event_rates(*m_last_selected);
+      m_last_selected.reset();
+    }
+  }
+
+ private:
+  /// \brief Recalculate the rates of events impacted by an event
+  void _update_impacted_event_rates(EventIndex event_index) {
+    EventIndexRange impacted = m_impact_table[event_index];
+    if (m_thread_pool && m_parallel_update_min_size > 0 &&
+        impacted.size() >= m_parallel_update_min_size) {
+      m_impacted_rates.resize(impacted.size());
+      m_thread_rates.resize(m_thread_pool->n_threads());
+      m_thread_pool->for_blocks(
+          impacted.size(), [&](int thread_index, Index begin, Index end) {
+            EventIndexRange block;
+            block.begin_ptr = impacted.begin() + begin;
+            block.end_ptr = impacted.begin() + end;
+            std::vector<double> &rates = m_thread_rates[thread_index];
+            m_thread_rate_calculators[thread_index]->calculate_rates(block,
+                                                                     rates);
+            std::copy(rates.begin(), rates.end(),
+                      m_impacted_rates.begin() + begin);
+          });
+    } else {
+      m_rate_calculator->calculate_rates(impacted, m_impacted_rates);
+    }
+    for (Index i = 0; i < impacted.size(); ++i) {
+      m_rate_table.set(impacted[i], m_impacted_rates[i]);
+    }
+  }
+
+  std::shared_ptr<RateCalculatorType> m_rate_calculator;
+  ImpactTableType const &m_impact_table;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+  RateTableType m_rate_table;
+  std::optional<EventIndex> m_last_selected;
+
+  /// Rates of impacted events, as calculated by `calculate_rates`
+  std::vector<double> m_impacted_rates;
+
+  /// Optional, used for parallel rate updates
+  std::vector<std::shared_ptr<RateCalculatorType>> m_thread_rate_calculators;
+  std::shared_ptr<ThreadPool> m_thread_pool;
+  Index m_parallel_update_min_size;
+
+  /// Rates calculated by each thread, during parallel rate updates
+  std::vector<std::vector<double>> m_thread_rates;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef CASM_clexmonte_events_SumTree
+#define CASM_clexmonte_events_SumTree
+
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A complete binary tree of partial sums over a fixed number of leaves
+///
+/// SumTree stores non-negative values (event rates) by leaf index and keeps
+/// the partial sums of all subtrees, so that updating a value and finding
+/// the leaf containing a given cumulative value are both O(log N). Leaf
+/// values are accessed by index in O(1), so leaves can be indexed directly by
+/// EventIndex.
+///
+/// Notes:
+/// - Nodes are stored in a flat array, with the root at index 1 and the
+///   children of node `i` at `2*i` and `2*i+1`. Leaf `i` is node
+///   `capacity + i`, where `capacity` is the smallest power of 2 that is
+///   greater than or equal to the number of leaves.
+/// - Parent sums are always recalculated from their children, rather than
+///   incremented, so that rounding errors do not accumulate.
+class SumTree {
+ public:
+  /// \brief Constructor, all leaf values are initialized to 0.0
+  explicit SumTree(Index n_leaves = 0);
+
+  /// \brief Constructor, with initial leaf values
+  explicit SumTree(std::vector<double> const &values, int n_threads = 1);
+
+  /// \brief Number of leaves
+  Index size() const { return m_size; }
+
+  /// \brief Sum of all leaf values
+  double total() const { return m_tree[1]; }
+
+  /// \brief Value of a leaf
+  double value(Index leaf_index) const {
+    return m_tree[m_capacity + leaf_index];
+  }
+
+  /// \brief Set the value of a leaf and update partial sums
+  void set(Index leaf_index, double value);
+
+  /// \brief Set all leaf values and rebuild partial sums
+  void reset(std::vector<double> const &values, int n_threads = 1);
+
+  /// \brief Change the number of leaves, keeping existing leaf values
+  void resize(Index n_leaves);
+
+  /// \brief Find the leaf for which the cumulative sum of leaf values
+  ///     first exceeds `cumulative_value`
+  Index find(double cumulative_value) const;
+
+  /// \brief Select a leaf with probability proportional to its value
+  ///
+  /// \param random_number_generator Must have a method
+  ///     `double random_real(double max)`, as monte::RandomNumberGenerator
+  template <typename GeneratorType>
+  Index select(GeneratorType &random_number_generator) const {
+    return find(random_number_generator.random_real(total()));
+  }
+
+ private:
+  /// \brief Recalculate all partial sums from the leaf values
+  void _rebuild(int n_threads);
+
+  /// Number of leaves
+  Index m_size;
+
+  /// Number of leaf nodes, a power of 2 >= m_size
+  Index m_capacity;
+
+  /// Nodes; m_tree[0] is unused
+  std::vector<double> m_tree;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
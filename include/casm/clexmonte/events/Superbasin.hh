@@ -0,0 +1,90 @@
+#ifndef CASM_clexmonte_events_Superbasin
+#define CASM_clexmonte_events_Superbasin
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/global/eigen.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief A set of transient states, and the observed transitions between
+///     them, used by the mean rate method
+///
+/// States are identified by a hash of the occupation. For each state, the
+/// total rate of all events is stored, along with the rates and event
+/// indices of the observed transitions to other states in the superbasin.
+/// Events from a state that are not observed transitions to another state
+/// in the superbasin are treated as exits.
+///
+/// With `solve`, the superbasin is treated as an absorbing Markov chain
+/// (the mean rate method; Puchala, Falk, and Garikipati, J. Chem. Phys. 132,
+/// 134104 (2010)), which gives the mean time until exit and the probability
+/// of exiting from each state, without simulating the transitions inside
+/// the superbasin.
+class Superbasin {
+ public:
+  /// \brief An observed transition between states in the superbasin
+  struct Transition {
+    EventIndex event_index;
+    double rate;
+    Index to;
+  };
+
+  /// \brief A state in the superbasin
+  struct State {
+    std::uint64_t hash;
+
+    /// Total rate of all events from this state, or < 0.0 if not known
+    double total_rate = -1.0;
+
+    /// Observed transitions to other states in the superbasin
+    std::vector<Transition> transitions;
+  };
+
+  /// \brief Number of states
+  Index size() const { return m_states.size(); }
+
+  /// \brief Get a state
+  State const &state(Index index) const { return m_states[index]; }
+
+  /// \brief Index of the state with `hash`, or -1 if not in the superbasin
+  Index find(std::uint64_t hash) const;
+
+  /// \brief Add a state, if not already present, and return its index
+  Index insert(std::uint64_t hash);
+
+  /// \brief Set the total rate of all events from a state
+  void set_total_rate(Index index, double total_rate) {
+    m_states[index].total_rate = total_rate;
+  }
+
+  /// \brief Add an observed transition, if not already present
+  void add_transition(Index from, EventIndex event_index, double rate,
+                      Index to);
+
+  /// \brief Remove all states
+  void clear();
+
+  /// \brief Return true if the total rate of every state is known
+  bool is_complete() const;
+
+  /// \brief Mean rate method: mean exit time and exit probabilities
+  bool solve(Index initial, double &mean_exit_time,
+             Eigen::VectorXd &exit_probability) const;
+
+  /// \brief Events along a shortest path of observed transitions
+  std::vector<EventIndex> path(Index begin, Index end) const;
+
+ private:
+  std::vector<State> m_states;
+  std::unordered_map<std::uint64_t, Index> m_index;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
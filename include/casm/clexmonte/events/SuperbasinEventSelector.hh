@@ -0,0 +1,240 @@
+#ifndef CASM_clexmonte_events_SuperbasinEventSelector
+#define CASM_clexmonte_events_SuperbasinEventSelector
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/Superbasin.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Accelerates KMC in superbasins of states connected by frequent
+///     transitions, using the mean rate method
+///
+/// SuperbasinEventSelector wraps an event selector. It identifies the
+/// current state by a hash of the occupation and records each state
+/// visited, its total rate, and the transitions observed between states.
+/// States are collected in a Superbasin, which is cleared whenever a state
+/// is visited that would make it larger than `max_states`. If the
+/// trajectory stays in the same superbasin for `min_steps` steps (i.e. a
+/// vacancy flickering between a few states near a solute cluster), the
+/// superbasin is solved as an absorbing Markov chain, and then:
+///
+/// 1. The exit state is sampled from the exit probabilities
+/// 2. The events along a shortest path of observed transitions from the
+///    current state to the exit state are returned, one per call to
+///    `select_event`, with time increment 0.0
+/// 3. An exit event is selected from the exit state, excluding the
+///    observed transitions within the superbasin, and returned with the
+///    mean exit time as its time increment
+///
+/// Then the superbasin is cleared. The events of steps 2 and 3 are applied
+/// as usual by `monte::kinetic_monte_carlo`, so atom trajectories and
+/// sampling functions remain consistent with the occupation.
+///
+/// Notes:
+/// - The exit time and exit state are exact in mean and distribution,
+///   respectively, for the observed superbasin. Transitions within the
+///   superbasin that were never observed are treated as exits.
+/// - Displacements within the superbasin are replaced by those along the
+///   shortest path to the exit state. For flickers that return to the same
+///   state this has no effect on the long-time mean squared displacement.
+/// - Path events are counted as steps and jumps by the KMC sampling
+///   functions.
+///
+/// \tparam EventSelectorType Must have the methods
+///     `std::pair<EventIndex, double> select_event()`,
+///     `double total_rate() const`, `double get_rate(EventIndex) const`,
+///     `void set_rate(EventIndex, double)`,
+///     `void set_last_selected(EventIndex)`, and
+///     `void update_impacted_event_rates()`, as RejectionFreeEventSelector.
+/// \tparam EngineType Random number engine type
+template <typename EventSelectorType, typename EngineType = std::mt19937_64>
+class SuperbasinEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param event_selector The event selector. A reference is held and it
+  ///     must remain valid for the lifetime of this selector.
+  /// \param state_hash_f Returns a hash of the current occupation
+  /// \param min_steps Number of steps in the same superbasin before the
+  ///     mean rate method is used
+  /// \param max_states Maximum number of states in a superbasin
+  /// \param engine Random number engine, used to sample the exit state
+  SuperbasinEventSelector(
+      EventSelectorType &event_selector,
+      std::function<std::uint64_t()> state_hash_f, Index min_steps,
+      Index max_states,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>())
+      : m_event_selector(event_selector),
+        m_state_hash_f(state_hash_f),
+        m_min_steps(min_steps),
+        m_max_states(max_states),
+        m_random_number_generator(engine) {
+    if (m_min_steps < 1 || m_max_states < 2) {
+      throw std::runtime_error(
+          "Error constructing SuperbasinEventSelector: requires min_steps >= "
+          "1 and max_states >= 2");
+    }
+  }
+
+  /// \brief Select an event and return the time increment
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    // step 2: path to the exit state
+    if (!m_path.empty()) {
+      EventIndex event_index = m_path.front();
+      m_path.pop_front();
+      m_event_selector.set_last_selected(event_index);
+      ++m_n_path_events;
+      return std::make_pair(event_index, 0.0);
+    }
+
+    // step 3: exit event
+    if (m_exit_pending) {
+      m_exit_pending = false;
+      return _select_exit_event();
+    }
+
+    // record the last transition and the current state
+    std::uint64_t hash = m_state_hash_f();
+    if (m_superbasin.find(hash) == -1 &&
+        m_superbasin.size() >= m_max_states) {
+      m_superbasin.clear();
+      m_n_steps = 0;
+      m_has_last = false;
+    }
+    Index current = m_superbasin.insert(hash);
+    if (m_has_last && m_last_state != current) {
+      m_superbasin.add_transition(m_last_state, m_last_event, m_last_rate,
+                                  current);
+    }
+    ++m_n_steps;
+
+    // step 1: if trapped, solve the superbasin and sample the exit state
+    if (m_n_steps >= m_min_steps && m_superbasin.size() > 1) {
+      m_event_selector.update_impacted_event_rates();
+      m_superbasin.set_total_rate(current, m_event_selector.total_rate());
+      double mean_exit_time;
+      if (m_superbasin.solve(current, mean_exit_time, m_exit_probability)) {
+        m_exit_state = _sample_exit_state();
+        m_exit_time = mean_exit_time;
+        std::vector<EventIndex> path =
+            m_superbasin.path(current, m_exit_state);
+        m_path.assign(path.begin(), path.end());
+        m_exit_pending = true;
+        ++m_n_superbasin_exits;
+        m_superbasin_time += mean_exit_time;
+        return select_event();
+      }
+      m_n_steps = 0;
+    }
+
+    // standard step
+    std::pair<EventIndex, double> result = m_event_selector.select_event();
+    m_superbasin.set_total_rate(current, m_event_selector.total_rate());
+    m_has_last = true;
+    m_last_state = current;
+    m_last_event = result.first;
+    m_last_rate = m_event_selector.get_rate(result.first);
+    return result;
+  }
+
+  /// \brief Total rate of the current state
+  double total_rate() const { return m_event_selector.total_rate(); }
+
+  /// \brief Number of superbasin exits by the mean rate method
+  Index n_superbasin_exits() const { return m_n_superbasin_exits; }
+
+  /// \brief Number of events applied along paths to exit states
+  Index n_path_events() const { return m_n_path_events; }
+
+  /// \brief Total mean exit time of all superbasin exits
+  double superbasin_time() const { return m_superbasin_time; }
+
+ private:
+  /// \brief Sample the exit state from `m_exit_probability`
+  Index _sample_exit_state() {
+    double x = m_random_number_generator.random_real(1.0);
+    Index n = m_exit_probability.size();
+    for (Index i = 0; i < n; ++i) {
+      x -= m_exit_probability(i);
+      if (x < 0.0) {
+        return i;
+      }
+    }
+    // rounding: last state with non-zero probability
+    for (Index i = n - 1; i > 0; --i) {
+      if (m_exit_probability(i) > 0.0) {
+        return i;
+      }
+    }
+    return 0;
+  }
+
+  /// \brief Select an exit event from the exit state, excluding observed
+  ///     transitions within the superbasin
+  std::pair<EventIndex, double> _select_exit_event() {
+    m_event_selector.update_impacted_event_rates();
+    std::vector<Superbasin::Transition> const &transitions =
+        m_superbasin.state(m_exit_state).transitions;
+    std::vector<double> saved_rate;
+    for (Superbasin::Transition const &transition : transitions) {
+      saved_rate.push_back(m_event_selector.get_rate(transition.event_index));
+      m_event_selector.set_rate(transition.event_index, 0.0);
+    }
+    std::pair<EventIndex, double> result = m_event_selector.select_event();
+    for (Index i = 0; i < transitions.size(); ++i) {
+      m_event_selector.set_rate(transitions[i].event_index, saved_rate[i]);
+    }
+
+    m_superbasin.clear();
+    m_n_steps = 0;
+    m_has_last = false;
+    return std::make_pair(result.first, m_exit_time);
+  }
+
+  EventSelectorType &m_event_selector;
+  std::function<std::uint64_t()> m_state_hash_f;
+  Index m_min_steps;
+  Index m_max_states;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+
+  /// States and transitions observed since the superbasin was last cleared
+  Superbasin m_superbasin;
+
+  /// Number of steps since the superbasin was last cleared or solved
+  Index m_n_steps = 0;
+
+  /// The last standard step
+  bool m_has_last = false;
+  Index m_last_state = -1;
+  EventIndex m_last_event = 0;
+  double m_last_rate = 0.0;
+
+  /// Pending exit
+  std::deque<EventIndex> m_path;
+  bool m_exit_pending = false;
+  Index m_exit_state = -1;
+  double m_exit_time = 0.0;
+  Eigen::VectorXd m_exit_probability;
+
+  Index m_n_superbasin_exits = 0;
+  Index m_n_path_events = 0;
+  double m_superbasin_time = 0.0;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
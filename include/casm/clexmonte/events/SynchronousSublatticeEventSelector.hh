@@ -0,0 +1,396 @@
+#ifndef CASM_clexmonte_events_SynchronousSublatticeEventSelector
+#define CASM_clexmonte_events_SynchronousSublatticeEventSelector
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/SumTree.hh"
+#include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Spatially decomposed, thread-parallel KMC, by the synchronous
+///     sublattice method
+///
+/// SynchronousSublatticeEventSelector implements the synchronous sublattice
+/// algorithm (Shim and Amar, Phys. Rev. B 71, 125432 (2005)). The supercell
+/// is split into domains, and each domain into sectors, by a
+/// DomainDecomposition. Time advances in windows of length `time_window`:
+///
+/// 1. One sector index is chosen at random for the window.
+/// 2. In parallel, each domain runs rejection-free KMC for `time_window`,
+///    selecting only events anchored in the chosen sector, with its own
+///    rate table and random number engine. Sectors are at least as wide as
+///    the impact range, so these events never impact events selectable by
+///    other domains. Each sector is active in 1 of `n_sectors` windows on
+///    average, so rates are multiplied by `n_sectors` while active, and
+///    each event occurs at its own rate on average.
+/// 3. Impacted events in the active sector are updated immediately. Other
+///    impacted events (the boundary impact lists) may be impacted by more
+///    than one domain, so they are recorded and updated after the window.
+///
+/// The events of all domains in a window are then returned in time order,
+/// one per call to `select_event`, so that they are applied to the state as
+/// usual by `monte::kinetic_monte_carlo`. Events in different domains
+/// commute, so the final occupation does not depend on their order.
+///
+/// Notes:
+/// - Events are selected and applied by the domains using `apply_event_f`,
+///   which must update the occupation used by the rate calculators (i.e. a
+///   scratch copy of the state), and the events are returned afterwards to
+///   be applied to the main state. Different domains call `apply_event_f`
+///   and the rate calculators concurrently, for events that do not share
+///   sites.
+/// - The method is approximate, because events near a sector boundary
+///   cannot occur while the neighboring sector is active, and their rates
+///   are not updated until the end of the window. The error decreases with
+///   `time_window`; it is small if `time_window * n_sectors` is less than
+///   the inverse of the fastest single event rate. Larger windows give more events per
+///   synchronization, and better parallel efficiency.
+/// - Each domain has its own random number engine, seeded from `engine`,
+///   so trajectories do not depend on the number of threads.
+///
+/// \tparam RateCalculatorType Must have the method `void calculate_rates(
+///     EventIndexRange event_index_list, std::vector<double> &rates)`
+/// \tparam ImpactTableType Must have the method
+///     `EventIndexRange operator[](EventIndex) const`
+template <typename RateCalculatorType, typename ImpactTableType,
+          typename EngineType = std::mt19937_64>
+class SynchronousSublatticeEventSelector {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param thread_rate_calculators Event rate calculators, one per thread,
+  ///     which must not share data that is not thread-safe
+  /// \param domain_decomposition The domains and sectors of each unit cell
+  /// \param n_prim_events Number of prim events. Events are indexed as
+  ///     `unitcell_index * n_prim_events + prim_event_index`.
+  /// \param impact_table Impact table. A reference is held and it must
+  ///     remain valid for the lifetime of the selector.
+  /// \param apply_event_f Function `void f(int thread_index, EventIndex
+  ///     event_index)` which applies an event to the occupation used by the
+  ///     rate calculators
+  /// \param time_window Duration of each window
+  /// \param engine Random number engine, used to select sectors and to seed
+  ///     the engine of each domain
+  /// \param thread_pool Threads used to run domains, with no more threads
+  ///     than `thread_rate_calculators`. If null, domains are run serially.
+  SynchronousSublatticeEventSelector(
+      std::vector<std::shared_ptr<RateCalculatorType>> const
+          &thread_rate_calculators,
+      DomainDecomposition const &domain_decomposition, Index n_prim_events,
+      ImpactTableType const &impact_table,
+      std::function<void(int, EventIndex)> apply_event_f, double time_window,
+      std::shared_ptr<EngineType> engine = std::shared_ptr<EngineType>(),
+      std::shared_ptr<ThreadPool> thread_pool = std::shared_ptr<ThreadPool>())
+      : m_thread_rate_calculators(thread_rate_calculators),
+        m_n_prim_events(n_prim_events),
+        m_n_sectors(domain_decomposition.n_sectors),
+        m_impact_table(impact_table),
+        m_apply_event_f(apply_event_f),
+        m_time_window(time_window),
+        m_random_number_generator(engine),
+        m_thread_pool(thread_pool) {
+    if (m_thread_rate_calculators.empty()) {
+      throw std::runtime_error(
+          "Error constructing SynchronousSublatticeEventSelector: no rate "
+          "calculators");
+    }
+    if (m_thread_pool &&
+        m_thread_pool->n_threads() > m_thread_rate_calculators.size()) {
+      throw std::runtime_error(
+          "Error constructing SynchronousSublatticeEventSelector: too few "
+          "thread rate calculators");
+    }
+    if (!(m_time_window > 0.0)) {
+      throw std::runtime_error(
+          "Error constructing SynchronousSublatticeEventSelector: requires "
+          "time_window > 0.0");
+    }
+
+    // Rate table `domain * n_sectors + sector` holds the events anchored in
+    // the unit cells of that domain and sector
+    Index n_tables = domain_decomposition.n_domains * m_n_sectors;
+    Index n_unitcells = domain_decomposition.unitcell_domain.size();
+    m_table_unitcells.resize(n_tables);
+    m_unitcell_table.resize(n_unitcells);
+    m_unitcell_position.resize(n_unitcells);
+    for (Index u = 0; u < n_unitcells; ++u) {
+      Index table = domain_decomposition.unitcell_domain[u] * m_n_sectors +
+                    domain_decomposition.unitcell_sector[u];
+      m_unitcell_table[u] = table;
+      m_unitcell_position[u] = m_table_unitcells[table].size();
+      m_table_unitcells[table].push_back(u);
+    }
+    m_is_dirty.assign(n_unitcells * m_n_prim_events, false);
+
+    // Each domain has its own random number engine
+    for (Index d = 0; d < domain_decomposition.n_domains; ++d) {
+      m_domains.emplace_back(std::make_shared<EngineType>(
+          m_random_number_generator.engine->operator()()));
+    }
+
+    // Initial rates, in parallel by table
+    m_tables.resize(n_tables);
+    _for_blocks(n_tables, [&](int thread_index, Index begin, Index end) {
+      RateCalculatorType &calculator = *m_thread_rate_calculators[thread_index];
+      std::vector<EventIndex> event_index_list;
+      std::vector<double> rates;
+      for (Index table = begin; table < end; ++table) {
+        event_index_list.clear();
+        for (Index u : m_table_unitcells[table]) {
+          for (Index p = 0; p < m_n_prim_events; ++p) {
+            event_index_list.push_back(
+                static_cast<EventIndex>(u * m_n_prim_events + p));
+          }
+        }
+        calculator.calculate_rates(_range(event_index_list), rates);
+        m_tables[table] = SumTree(rates);
+      }
+    });
+  }
+
+  /// \brief Select an event and return the time increment
+  ///
+  /// Runs windows as necessary, and then returns the next event of the
+  /// current window in time order.
+  ///
+  /// \returns (selected event index, time increment)
+  std::pair<EventIndex, double> select_event() {
+    while (m_next == m_pending.size()) {
+      _run_window();
+    }
+    std::pair<double, EventIndex> const &next = m_pending[m_next++];
+    double time_increment = next.first - m_last_time;
+    m_last_time = next.first;
+    return std::make_pair(next.second, time_increment);
+  }
+
+  /// \brief Total rate of all events, as of the end of the last window
+  double total_rate() const {
+    double total = 0.0;
+    for (SumTree const &table : m_tables) {
+      total += table.total();
+    }
+    return total;
+  }
+
+  /// \brief Number of windows run
+  Index n_windows() const { return m_n_windows; }
+
+  /// \brief Number of events selected
+  Index n_events() const { return m_n_events; }
+
+  /// \brief Number of boundary rate updates (events impacted outside the
+  ///     active sector, updated at the end of each window)
+  Index n_boundary_updates() const { return m_n_boundary_updates; }
+
+ private:
+  /// \brief Data for each domain, written only by the thread running it
+  struct Domain {
+    explicit Domain(std::shared_ptr<EngineType> engine)
+        : random_number_generator(engine) {}
+
+    monte::RandomNumberGenerator<EngineType> random_number_generator;
+
+    /// (time in window, event index) of events selected in the window
+    std::vector<std::pair<double, EventIndex>> trajectory;
+
+    /// Impacted events outside the active sector
+    std::vector<EventIndex> boundary;
+
+    /// Impacted events in the active sector, and their rates
+    std::vector<EventIndex> impacted;
+    std::vector<double> impacted_rates;
+  };
+
+  static EventIndexRange _range(std::vector<EventIndex> const &v) {
+    EventIndexRange range;
+    range.begin_ptr = v.data();
+    range.end_ptr = v.data() + v.size();
+    return range;
+  }
+
+  /// \brief Call `f(thread_index, begin, end)` for blocks of [0, n), in
+  ///     parallel if there is a thread pool
+  template <typename F>
+  void _for_blocks(Index n, F f) {
+    if (!m_thread_pool) {
+      f(0, Index(0), n);
+      return;
+    }
+    m_thread_pool->for_blocks(n, f);
+  }
+
+  /// \brief Run all domains for one window, then update boundary rates and
+  ///     set `m_pending`
+  void _run_window() {
+    Index sector = static_cast<Index>(
+        m_random_number_generator.random_int(m_n_sectors - 1));
+    _for_blocks(m_domains.size(),
+                [&](int thread_index, Index begin, Index end) {
+                  for (Index d = begin; d < end; ++d) {
+                    _run_domain(thread_index, d, sector);
+                  }
+                });
+
+    // Collect events in time order
+    double window_begin = m_n_windows * m_time_window;
+    m_pending.clear();
+    m_next = 0;
+    for (Domain const &domain : m_domains) {
+      for (auto const &x : domain.trajectory) {
+        m_pending.emplace_back(window_begin + x.first, x.second);
+      }
+    }
+    std::stable_sort(
+        m_pending.begin(), m_pending.end(),
+        [](auto const &lhs, auto const &rhs) { return lhs.first < rhs.first; });
+    ++m_n_windows;
+    m_n_events += m_pending.size();
+
+    // Update boundary rates: calculate in parallel, then set serially
+    m_boundary.clear();
+    for (Domain const &domain : m_domains) {
+      for (EventIndex event_index : domain.boundary) {
+        if (!m_is_dirty[event_index]) {
+          m_is_dirty[event_index] = true;
+          m_boundary.push_back(event_index);
+        }
+      }
+    }
+    m_boundary_rates.resize(m_boundary.size());
+    _for_blocks(m_boundary.size(),
+                [&](int thread_index, Index begin, Index end) {
+                  EventIndexRange block;
+                  block.begin_ptr = m_boundary.data() + begin;
+                  block.end_ptr = m_boundary.data() + end;
+                  std::vector<double> rates;
+                  m_thread_rate_calculators[thread_index]->calculate_rates(
+                      block, rates);
+                  std::copy(rates.begin(), rates.end(),
+                            m_boundary_rates.begin() + begin);
+                });
+    for (Index i = 0; i < m_boundary.size(); ++i) {
+      EventIndex event_index = m_boundary[i];
+      Index u = event_index / m_n_prim_events;
+      m_tables[m_unitcell_table[u]].set(_leaf(event_index),
+                                        m_boundary_rates[i]);
+      m_is_dirty[event_index] = false;
+    }
+    m_n_boundary_updates += m_boundary.size();
+
+    if (m_pending.empty() && !(total_rate() > 0.0)) {
+      throw std::runtime_error(
+          "Error in SynchronousSublatticeEventSelector::select_event: total "
+          "rate is zero");
+    }
+  }
+
+  /// \brief Leaf index of an event in its rate table
+  Index _leaf(EventIndex event_index) const {
+    Index u = event_index / m_n_prim_events;
+    return m_unitcell_position[u] * m_n_prim_events +
+           event_index % m_n_prim_events;
+  }
+
+  /// \brief Run rejection-free KMC in sector `sector` of domain `d` for one
+  ///     window
+  void _run_domain(int thread_index, Index d, Index sector) {
+    Domain &domain = m_domains[d];
+    Index table_index = d * m_n_sectors + sector;
+    SumTree &table = m_tables[table_index];
+    std::vector<Index> const &unitcells = m_table_unitcells[table_index];
+    RateCalculatorType &calculator = *m_thread_rate_calculators[thread_index];
+    domain.trajectory.clear();
+    domain.boundary.clear();
+
+    double time = 0.0;
+    while (true) {
+      double total_rate = table.total();
+      if (!(total_rate > 0.0)) {
+        return;
+      }
+      // time increment: -ln(u) / total_rate, with u in (0, 1]
+      double u = 1.0 - domain.random_number_generator.random_real(1.0);
+      time += -std::log(u) / (total_rate * m_n_sectors);
+      if (time >= m_time_window) {
+        return;
+      }
+      Index leaf = table.select(domain.random_number_generator);
+      EventIndex selected = static_cast<EventIndex>(
+          unitcells[leaf / m_n_prim_events] * m_n_prim_events +
+          leaf % m_n_prim_events);
+      m_apply_event_f(thread_index, selected);
+      domain.trajectory.emplace_back(time, selected);
+
+      // update impacted events in the active sector, defer the others
+      domain.impacted.clear();
+      for (EventIndex event_index : m_impact_table[selected]) {
+        if (m_unitcell_table[event_index / m_n_prim_events] == table_index) {
+          domain.impacted.push_back(event_index);
+        } else {
+          domain.boundary.push_back(event_index);
+        }
+      }
+      calculator.calculate_rates(_range(domain.impacted),
+                                 domain.impacted_rates);
+      for (Index i = 0; i < domain.impacted.size(); ++i) {
+        table.set(_leaf(domain.impacted[i]), domain.impacted_rates[i]);
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<RateCalculatorType>> m_thread_rate_calculators;
+  Index m_n_prim_events;
+  Index m_n_sectors;
+  ImpactTableType const &m_impact_table;
+  std::function<void(int, EventIndex)> m_apply_event_f;
+  double m_time_window;
+  monte::RandomNumberGenerator<EngineType> m_random_number_generator;
+  std::shared_ptr<ThreadPool> m_thread_pool;
+
+  /// Rate table of each (domain, sector)
+  std::vector<SumTree> m_tables;
+
+  /// Unit cells of each rate table, in leaf order
+  std::vector<std::vector<Index>> m_table_unitcells;
+
+  /// Rate table of each unit cell
+  std::vector<Index> m_unitcell_table;
+
+  /// Position of each unit cell in its rate table
+  std::vector<Index> m_unitcell_position;
+
+  std::vector<Domain> m_domains;
+
+  /// Boundary events to update at the end of a window, without duplicates
+  std::vector<EventIndex> m_boundary;
+  std::vector<double> m_boundary_rates;
+  std::vector<bool> m_is_dirty;
+
+  /// Events of the current window, (time, event index), in time order
+  std::vector<std::pair<double, EventIndex>> m_pending;
+  Index m_next = 0;
+  double m_last_time = 0.0;
+
+  Index m_n_windows = 0;
+  Index m_n_events = 0;
+  Index m_n_boundary_updates = 0;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
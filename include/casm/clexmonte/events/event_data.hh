@@ -1,6 +1,7 @@
 #ifndef CASM_clexmonte_events_event_data
 #define CASM_clexmonte_events_event_data
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -106,6 +107,14 @@ struct EventID {
 
 bool operator<(EventID const &lhs, EventID const &rhs);
 
+/// \brief Packed linear index of an event in some supercell
+///
+/// Events are indexed as `unitcell_index * n_prim_events + prim_event_index`,
+/// the same layout used by SupercellEventImpactTable, so event data, rates,
+/// and impact lists can be stored in flat arrays and accessed in O(1). A
+/// 32-bit index is used to keep impact tables compact.
+typedef std::uint32_t EventIndex;
+
 // -- Inline definitions --
 
 inline bool operator<(RelativeEventID const &lhs, RelativeEventID const &rhs) {
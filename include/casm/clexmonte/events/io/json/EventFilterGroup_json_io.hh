@@ -10,9 +10,15 @@ class InputParser;
 namespace clexmonte {
 
 struct EventFilterGroup;
+struct UnitCellRegion;
 
 }  // namespace clexmonte
 
+jsonParser &to_json(clexmonte::UnitCellRegion const &region,
+                    jsonParser &json);
+
+void parse(InputParser<clexmonte::UnitCellRegion> &parser);
+
 jsonParser &to_json(clexmonte::EventFilterGroup const &filter,
                     jsonParser &json);
 
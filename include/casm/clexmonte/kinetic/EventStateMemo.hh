@@ -0,0 +1,120 @@
+#ifndef CASM_clexmonte_kinetic_EventStateMemo
+#define CASM_clexmonte_kinetic_EventStateMemo
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "casm/clexmonte/events/EventSiteTable.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
+#include "casm/clexmonte/events/event_data.hh"
+
+namespace CASM {
+class Log;
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Memoizes event energies by the occupation of the event's update
+///     neighborhood
+///
+/// The final state energy, KRA, and attempt frequency of an event depend only
+/// on the prim event and on the occupation of the sites in its
+/// `required_update_neighborhood`. In ordered or dilute alloys the same
+/// local environment occurs many times, so EventStateMemo stores these
+/// values keyed by (prim_event_index, neighborhood occupation) to avoid
+/// evaluating the cluster expansions again.
+///
+/// Notes:
+/// - Keys store the full neighborhood occupation, so there are no false hits
+///   from hash collisions
+/// - Values are independent of temperature, so the memo may be kept between
+///   runs in the same supercell, but it must be cleared if the supercell or
+///   cluster expansions change
+/// - When the table has `max_size` entries, it is cleared before the next
+///   insertion, so memory is bounded
+/// - If `validate_every` > 0, every `validate_every`-th hit is re-calculated
+///   in full and compared with the memoized values
+/// - Not thread-safe
+class EventStateMemo {
+ public:
+  /// \brief Memoized event values
+  struct Value {
+    double dE_final;
+    double Ekra;
+    double freq;
+  };
+
+  EventStateMemo(std::vector<EventImpactInfo> const &prim_impact_info_list,
+                 xtal::UnitCellIndexConverter const &unitcell_converter,
+                 Index _max_size = 1000000, Index _validate_every = 0);
+
+  /// \brief Find memoized values for an event, given the current occupation
+  ///
+  /// The key for the event is kept, so that if nullptr is returned, the
+  /// calculated values can be stored with `insert`.
+  Value const *find(Index unitcell_index, Index prim_event_index,
+                    PackedOccupation const &occupation);
+
+  /// \brief Store values for the key of the last `find`
+  void insert(Value const &value);
+
+  /// \brief Return true if the last hit should be validated
+  bool validate_hit() const {
+    return validate_every > 0 && (n_hits % validate_every) == 0;
+  }
+
+  /// \brief Compare memoized and fully calculated values for a hit
+  void validate(Value const &memoized, Value const &calculated);
+
+  /// \brief Number of entries
+  Index size() const { return m_table.size(); }
+
+  /// \brief Remove all entries (counters are not reset)
+  void clear() { m_table.clear(); }
+
+  /// Maximum number of entries
+  Index max_size;
+
+  /// If > 0, validate every `validate_every`-th hit
+  Index validate_every;
+
+  /// Relative tolerance used by `validate`
+  double validation_tol = 1e-10;
+
+  /// Number of `find` which returned values
+  Index n_hits = 0;
+
+  /// Number of `find` which did not return values
+  Index n_misses = 0;
+
+  /// Number of times the table was cleared because it was full
+  Index n_clears = 0;
+
+  /// Number of validated hits
+  Index n_validated = 0;
+
+  /// Number of validated hits with values that did not match
+  Index n_validation_failures = 0;
+
+  /// Maximum absolute difference found by `validate`
+  double max_validation_error = 0.0;
+
+ private:
+  /// Neighborhood sites, for each prim event
+  EventSiteTable m_neighborhood_table;
+
+  /// Holds the key of the last `find`
+  std::string m_key;
+
+  std::unordered_map<std::string, Value> m_table;
+};
+
+/// \brief Print EventStateMemo counters
+void print_summary(Log &log, EventStateMemo const &memo);
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
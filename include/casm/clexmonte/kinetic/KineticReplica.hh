@@ -0,0 +1,246 @@
+#ifndef CASM_clexmonte_kinetic_KineticReplica
+#define CASM_clexmonte_kinetic_KineticReplica
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/events/OccupationHash.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
+#include "casm/clexmonte/events/RejectionFreeEventSelector.hh"
+#include "casm/clexmonte/kinetic/kinetic_events.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+
+namespace CASM {
+namespace clexulator {
+class OrderParameter;
+}
+
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Identifies the basin of an occupation, for parallel replica
+///     dynamics
+///
+/// Two methods are supported:
+/// - Occupation hash: a hash of the occupation, ignoring sites with
+///   selected occupants (i.e. vacancies and the host species, so that only
+///   solute configurations are distinguished). The hash is updated
+///   incrementally as events occur, in O(1) per site, as by
+///   OccupationHash.
+/// - Order parameter: the order parameter values, binned with width `tol`.
+///   The order parameter is re-calculated after each event.
+///
+/// Copies are independent, so each replica may use its own copy.
+class ReplicaBasin {
+ public:
+  /// \brief Constructor, basin by occupation hash
+  ///
+  /// \param is_ignored Occupants ignored by the hash, as
+  ///     `is_ignored[sublattice_index][occupant_index]` (i.e. as from
+  ///     `make_is_defect`)
+  /// \param n_unitcells Number of unit cells in the supercell
+  ReplicaBasin(std::vector<std::vector<bool>> const &is_ignored,
+               Index n_unitcells);
+
+  /// \brief Constructor, basin by binned order parameter values
+  ///
+  /// \param order_parameter Order parameter calculator, which is copied
+  /// \param tol Bin width
+  ReplicaBasin(clexulator::OrderParameter const &order_parameter, double tol);
+
+  ReplicaBasin(ReplicaBasin const &other);
+  ReplicaBasin &operator=(ReplicaBasin const &other);
+  ~ReplicaBasin();
+
+  /// \brief Reset for the occupation of `state`, which must remain valid
+  void reset(state_type const &state);
+
+  /// \brief Update for a change of occupation on site `l`
+  void update(Index l, int old_occ, int new_occ) {
+    if (!m_order_parameter) {
+      m_value ^= _site_value(l, old_occ) ^ _site_value(l, new_occ);
+    }
+  }
+
+  /// \brief Basin of the current occupation
+  std::uint64_t value() const;
+
+ private:
+  std::uint64_t _site_value(Index l, int occ) const {
+    if (m_is_ignored[l / m_n_unitcells][occ]) {
+      return 0;
+    }
+    return OccupationHash::site_value(l, occ);
+  }
+
+  std::vector<std::vector<bool>> m_is_ignored;
+  Index m_n_unitcells;
+  std::uint64_t m_value;
+
+  std::unique_ptr<clexulator::OrderParameter> m_order_parameter;
+  double m_tol;
+};
+
+/// \brief A replica of the state of a kinetic Monte Carlo calculation,
+///     for parallel replica dynamics
+///
+/// KineticReplica holds a copy of the main state, with its own event
+/// calculators, packed occupation, event rates, and random number engine,
+/// so that replicas can run in separate threads. The system, prim event
+/// list, complete event list, and impact table of `event_data` are shared
+/// and not copied. The event calculators use independent copies of the
+/// cluster expansion calculators, as for thread event calculators.
+///
+/// Satisfies the `ReplicaType` requirements of
+/// ParallelReplicaEventSelector.
+template <typename EngineType = std::mt19937_64>
+class KineticReplica {
+ public:
+  typedef RejectionFreeEventSelector<CompleteEventCalculator,
+                                     CompressedEventImpactTable, EngineType>
+      event_selector_type;
+
+  /// \brief Constructor
+  ///
+  /// \param event_data KMC event data, shared by all replicas
+  /// \param main_state The main state, copied by `synchronize`. A reference
+  ///     is held.
+  /// \param conditions Conditions, shared by all replicas
+  /// \param basin Identifies the basin of the replica's occupation
+  /// \param engine Random number engine, independent of other replicas
+  KineticReplica(std::shared_ptr<KineticEventData> event_data,
+                 state_type const &main_state,
+                 std::shared_ptr<Conditions> conditions,
+                 ReplicaBasin const &basin,
+                 std::shared_ptr<EngineType> engine)
+      : m_event_data(event_data),
+        m_main_state(main_state),
+        m_state(main_state),
+        m_basin(basin),
+        m_engine(engine) {
+    m_prim_event_calculators = make_prim_event_calculators(
+        m_event_data->system, m_state, m_event_data->prim_event_list,
+        conditions, true /*independent_clex*/);
+    m_event_calculator = std::make_shared<CompleteEventCalculator>(
+        m_event_data->prim_event_list, m_prim_event_calculators,
+        m_event_data->event_list, CASM::null_log());
+    m_packed_occupation = std::make_shared<PackedOccupation>(
+        get_occupation(m_state),
+        max_n_occupants(*get_prim_basicstructure(*m_event_data->system)));
+    m_event_calculator->packed_occupation = m_packed_occupation;
+    m_basin.reset(m_state);
+  }
+
+  KineticReplica(KineticReplica const &) = delete;
+  KineticReplica &operator=(KineticReplica const &) = delete;
+
+  /// \brief Set the replica's occupation to the main state's occupation and
+  ///     update event rates
+  ///
+  /// The first time, all event rates are calculated. After that, only the
+  /// rates of events impacted by `changed_events` are re-calculated.
+  ///
+  /// \param changed_events Events applied to the replica, or to the main
+  ///     state, since the replica was last synchronized. The replica and
+  ///     main state must differ only on sites changed by these events.
+  void synchronize(std::vector<EventIndex> const &changed_events) {
+    Eigen::VectorXi &occupation = get_occupation(m_state);
+    Eigen::VectorXi const &main_occupation = get_occupation(m_main_state);
+    if (!m_event_selector) {
+      occupation = main_occupation;
+      m_packed_occupation->reset(occupation);
+      m_basin.reset(m_state);
+      m_event_selector = std::make_unique<event_selector_type>(
+          m_event_calculator, m_event_data->event_list.size(),
+          m_event_data->event_list.impact_table, m_engine);
+      return;
+    }
+
+    for (Index l = 0; l < occupation.size(); ++l) {
+      if (occupation(l) != main_occupation(l)) {
+        m_basin.update(l, occupation(l), main_occupation(l));
+        occupation(l) = main_occupation(l);
+        m_packed_occupation->set(l, main_occupation(l));
+      }
+    }
+
+    CompressedEventImpactTable const &impact_table =
+        m_event_data->event_list.impact_table;
+    m_impacted.clear();
+    for (EventIndex event_index : changed_events) {
+      auto const &impacted = impact_table[event_index];
+      m_impacted.insert(m_impacted.end(), impacted.begin(), impacted.end());
+    }
+    std::sort(m_impacted.begin(), m_impacted.end());
+    m_impacted.erase(std::unique(m_impacted.begin(), m_impacted.end()),
+                     m_impacted.end());
+    for (EventIndex event_index : m_impacted) {
+      m_event_selector->set_rate(
+          event_index, m_event_calculator->calculate_rate(event_index));
+    }
+  }
+
+  /// \brief Update impacted event rates, then select an event and sample
+  ///     the time increment
+  std::pair<EventIndex, double> select_event() {
+    return m_event_selector->select_event();
+  }
+
+  /// \brief Apply an event to the replica's occupation
+  void apply(EventIndex event_index) {
+    CompleteEventList const &event_list = m_event_data->event_list;
+    Index prim_event_index = event_index % event_list.n_prim_events;
+    Index unitcell_index = event_index / event_list.n_prim_events;
+    event_list.site_table.set_linear_site_index(
+        m_linear_site_index, unitcell_index, prim_event_index);
+    std::vector<int> const &occ_final =
+        m_event_data->prim_event_list[prim_event_index].occ_final;
+    Eigen::VectorXi &occupation = get_occupation(m_state);
+    for (Index i = 0; i < m_linear_site_index.size(); ++i) {
+      Index l = m_linear_site_index[i];
+      m_basin.update(l, occupation(l), occ_final[i]);
+      occupation(l) = occ_final[i];
+      m_packed_occupation->set(l, occ_final[i]);
+    }
+  }
+
+  /// \brief Basin of the replica's occupation
+  std::uint64_t basin() const { return m_basin.value(); }
+
+  /// \brief Number of events that were not normal
+  Index not_normal_count() const {
+    return m_event_calculator->not_normal_count;
+  }
+
+ private:
+  std::shared_ptr<KineticEventData> m_event_data;
+  state_type const &m_main_state;
+
+  /// The replica's state
+  state_type m_state;
+
+  ReplicaBasin m_basin;
+  std::shared_ptr<EngineType> m_engine;
+  std::vector<EventStateCalculator> m_prim_event_calculators;
+  std::shared_ptr<CompleteEventCalculator> m_event_calculator;
+  std::shared_ptr<PackedOccupation> m_packed_occupation;
+  std::unique_ptr<event_selector_type> m_event_selector;
+
+  /// Holds linear site indices of the event being applied
+  std::vector<Index> m_linear_site_index;
+
+  /// Holds events impacted by changed events, during `synchronize`
+  std::vector<EventIndex> m_impacted;
+};
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
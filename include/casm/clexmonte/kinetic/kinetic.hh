@@ -19,7 +19,8 @@ struct Kinetic {
   typedef EngineType engine_type;
 
   explicit Kinetic(std::shared_ptr<system_type> _system,
-                   std::vector<EventFilterGroup> _event_filters = {});
+                   std::vector<EventFilterGroup> _event_filters = {},
+                   int _n_threads = 1, std::string _event_cache_dir = "");
 
   /// System data
   std::shared_ptr<system_type> system;
@@ -27,15 +28,120 @@ struct Kinetic {
   /// Event filters
   std::vector<EventFilterGroup> event_filters;
 
+  /// Number of threads used to construct the event list and calculate
+  /// initial event rates. If < 1, the number of hardware threads is used.
+  int n_threads;
+
+  /// If > 0 and n_threads > 1, after each event, the rates of impacted
+  /// events are updated in parallel if there are at least this many
+  int parallel_update_min_size = 0;
+
+  /// If not empty, directory used to cache prim event impact information
+  std::string event_cache_dir;
+
+  /// If not empty, names of the defect occupants (i.e. "Va") used to
+  /// enumerate active events. Then only events with a defect on a site
+  /// whose initial occupant is a defect are included in event selection.
+  std::vector<std::string> active_event_defects;
+
+  /// Opt-in: if true, keep the state of every event in
+  /// `event_data->event_state_cache`, updated as rates are calculated. Then
+  /// if a run begins with the same supercell and occupation as the previous
+  /// run ended (i.e. only the temperature changed), initial rates are
+  /// rescaled from the cached activation energies and attempt frequencies.
+  /// Only used by rejection-free KMC with the complete event list. Off by
+  /// default, because it requires ~41 bytes per event.
+  bool keep_event_states = false;
+
+  /// If true, memoize event energies by the occupation of each event's
+  /// update neighborhood, in `event_data->event_state_memo`
+  bool use_event_state_memo = false;
+
+  /// Maximum number of event state memo entries
+  Index event_state_memo_max_size = 1000000;
+
+  /// If > 0, validate every `event_state_memo_validate_every`-th memo hit
+  Index event_state_memo_validate_every = 0;
+
   /// Update species in monte::OccLocation tracker
   bool update_species = true;
 
   /// Method allows time-based sampling
   bool time_sampling_allowed = true;
 
-  // TODO:
-  // /// If true: rejection-free KMC, if false: rejection-KMC
-  // bool rejection_free = true;
+  /// Rejection-free KMC event rate table: "sum_tree" (O(log N) selection
+  /// and update), "composition_rejection" (O(1) expected selection and
+  /// update), or "next_reaction" (next reaction method, supports
+  /// `temperature_schedule_time`)
+  std::string event_selector_type = "sum_tree";
+
+  /// If not empty, times (from the beginning of each run) at which the
+  /// temperature changes to the corresponding value in
+  /// `temperature_schedule_temperature`. Requires
+  /// `event_selector_type=="next_reaction"`.
+  std::vector<double> temperature_schedule_time;
+
+  /// Temperatures for `temperature_schedule_time`
+  std::vector<double> temperature_schedule_temperature;
+
+  /// If true, accelerate superbasins (i.e. flickering defects) with the mean
+  /// rate method, using SuperbasinEventSelector
+  bool use_superbasin = false;
+
+  /// Number of steps in the same superbasin before the mean rate method is
+  /// used
+  Index superbasin_min_steps = 1000;
+
+  /// Maximum number of states in a superbasin
+  Index superbasin_max_states = 16;
+
+  /// If > 0, use parallel replica dynamics with this many replicas, using
+  /// ParallelReplicaEventSelector
+  Index parallel_replica_n_replicas = 0;
+
+  /// Parallel replica dynamics: duration of the correlation and dephasing
+  /// stages
+  double parallel_replica_correlation_time = 0.0;
+
+  /// Parallel replica dynamics: duration of each block of the parallel
+  /// stage. Must be > 0.0 if `parallel_replica_n_replicas > 0`.
+  double parallel_replica_block_time = 0.0;
+
+  /// Parallel replica dynamics: if not empty, the basin is identified by
+  /// the binned values of this order parameter (key in `system->dof_spaces`)
+  std::string parallel_replica_order_parameter;
+
+  /// Parallel replica dynamics: order parameter bin width
+  double parallel_replica_order_parameter_tol = 0.1;
+
+  /// Parallel replica dynamics: if the basin is identified by occupation
+  /// hash, names of the occupants ignored by the hash (i.e. "Va" and the
+  /// host species)
+  std::vector<std::string> parallel_replica_ignored_occupants;
+
+  /// If not empty, the number of domains along each supercell lattice
+  /// vector, for spatially decomposed parallel KMC using
+  /// SynchronousSublatticeEventSelector
+  std::vector<Index> domain_decomposition_n_domains;
+
+  /// Spatially decomposed parallel KMC: simulated time per synchronization
+  /// window
+  double domain_decomposition_time_window = 0.0;
+
+  /// If true: rejection-free KMC, if false: rejection-KMC
+  ///
+  /// Rejection-KMC does not require an impact table, so the memory and time
+  /// needed to construct the event list are much smaller for large
+  /// supercells, at the cost of rejected trials.
+  bool rejection_free = true;
+
+  /// Rejection-KMC: event rate upper bounds, by event type name. Event types
+  /// not included are calibrated at the beginning of each run from the
+  /// maximum rate of all events of that type.
+  std::map<std::string, double> rate_upper_bound;
+
+  /// Rejection-KMC: factor multiplying the calibrated rate upper bounds
+  double rate_upper_bound_factor = 2.0;
 
   /// \brief KMC event data and calculators
   std::shared_ptr<KineticEventData> event_data;
@@ -3,9 +3,13 @@
 
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
 #include "casm/clexmonte/events/event_data.hh"
+#include "casm/clexmonte/kinetic/EventStateMemo.hh"
 #include "casm/clexulator/ClusterExpansion.hh"
 #include "casm/clexulator/LocalClusterExpansion.hh"
+#include "casm/clexulator/LocalCorrelations.hh"
+#include "casm/clexulator/SparseCoefficients.hh"
 
 namespace CASM {
 namespace clexmonte {
@@ -22,6 +26,108 @@ struct EventState {
   double rate;          ///< Occurance rate
 };
 
+/// \brief Set `dE_activated` and `is_normal` from `dE_final` and `Ekra`
+///
+/// The activated state energy is `dE_final / 2 + Ekra`, bounded below by
+/// `dE_final` and by 0.0. An event is "normal" if the unbounded value is
+/// greater than both.
+inline void set_activation_energy(EventState &state) {
+  state.dE_activated = state.dE_final * 0.5 + state.Ekra;
+  state.is_normal =
+      (state.dE_activated > 0.0) && (state.dE_activated > state.dE_final);
+  if (state.dE_activated < state.dE_final) state.dE_activated = state.dE_final;
+  if (state.dE_activated < 0.0) state.dE_activated = 0.0;
+}
+
+/// \brief Stores the EventState of every event, as a structure of arrays
+///
+/// If an EventStateCache is given to a CompleteEventCalculator, the state of
+/// each event is stored whenever its rate is calculated, so the current
+/// states of all events are available for analysis (i.e. the distribution
+/// of rates or barriers) without re-calculating them. Values other than
+/// `rate` and the flags are only meaningful for allowed events.
+///
+/// Activation energies and attempt frequencies do not depend on
+/// temperature, so if the cache is complete for the current occupation, the
+/// rates for a new temperature can be calculated with `rescale_rates`
+/// instead of re-evaluating the cluster expansions.
+///
+/// Requires n_events * 41 bytes.
+struct EventStateCache {
+  EventStateCache() = default;
+
+  explicit EventStateCache(Index n_events) { resize(n_events); }
+
+  /// \brief Flag bits
+  enum Flags : unsigned char { allowed = 1, normal = 2 };
+
+  std::vector<double> dE_final;
+  std::vector<double> Ekra;
+  std::vector<double> dE_activated;
+  std::vector<double> freq;
+  std::vector<double> rate;
+
+  /// \brief Bitwise or of `Flags`
+  std::vector<unsigned char> flags;
+
+  /// \brief If true, the states of all events are stored and are
+  ///     consistent with `occupation`
+  bool is_complete = false;
+
+  /// \brief The occupation for which the stored states are complete
+  Eigen::VectorXi occupation;
+
+  /// \brief Number of events
+  Index size() const { return rate.size(); }
+
+  /// \brief Return true if the stored states are complete for `_occupation`
+  bool is_complete_for(Eigen::VectorXi const &_occupation) const {
+    return is_complete && occupation.size() == _occupation.size() &&
+           occupation == _occupation;
+  }
+
+  /// \brief Re-calculate all rates for a new temperature
+  void rescale_rates(double beta);
+
+  /// \brief Resize, setting all events not allowed
+  void resize(Index n_events) {
+    is_complete = false;
+    dE_final.assign(n_events, 0.0);
+    Ekra.assign(n_events, 0.0);
+    dE_activated.assign(n_events, 0.0);
+    freq.assign(n_events, 0.0);
+    rate.assign(n_events, 0.0);
+    flags.assign(n_events, 0);
+  }
+
+  /// \brief Store the state of an event
+  void set(EventIndex event_index, EventState const &state) {
+    flags[event_index] =
+        (state.is_allowed ? allowed : 0) |
+        (state.is_allowed && state.is_normal ? normal : 0);
+    rate[event_index] = state.rate;
+    if (state.is_allowed) {
+      dE_final[event_index] = state.dE_final;
+      Ekra[event_index] = state.Ekra;
+      dE_activated[event_index] = state.dE_activated;
+      freq[event_index] = state.freq;
+    }
+  }
+
+  /// \brief Get the stored state of an event
+  EventState get(EventIndex event_index) const {
+    EventState state;
+    state.is_allowed = flags[event_index] & allowed;
+    state.is_normal = flags[event_index] & normal;
+    state.dE_final = dE_final[event_index];
+    state.Ekra = Ekra[event_index];
+    state.dE_activated = dE_activated[event_index];
+    state.freq = freq[event_index];
+    state.rate = rate[event_index];
+    return state;
+  }
+};
+
 /// \brief Event rate calculation for a particular KMC event
 ///
 /// EventStateCalculator is used to separate the event calculation from the
@@ -43,7 +149,8 @@ class EventStateCalculator {
                        std::string _event_type_name);
 
   /// \brief Reset pointer to state currently being calculated
-  void set(state_type const *state, std::shared_ptr<Conditions> conditions);
+  void set(state_type const *state, std::shared_ptr<Conditions> conditions,
+           bool independent_clex = false);
 
   /// \brief Pointer to current state
   state_type const *state() const;
@@ -52,9 +159,29 @@ class EventStateCalculator {
   std::shared_ptr<Conditions> const &conditions() const;
 
   /// \brief Calculate the state of an event
-  void calculate_event_state(EventState &state, EventData const &event_data,
+  void calculate_event_state(EventState &state, Index unitcell_index,
+                             std::vector<Index> const &linear_site_index,
                              PrimEventData const &prim_event_data) const;
 
+  /// \brief Calculate the state of an event, except for the rate
+  bool calculate_activation(EventState &state, Index unitcell_index,
+                            std::vector<Index> const &linear_site_index,
+                            PrimEventData const &prim_event_data) const;
+
+  /// \brief Calculate the state of an event that is known to be allowed,
+  ///     except for the rate
+  void calculate_allowed_activation(
+      EventState &state, Index unitcell_index,
+      std::vector<Index> const &linear_site_index,
+      PrimEventData const &prim_event_data) const;
+
+  /// \brief Calculate the state of an event
+  void calculate_event_state(EventState &state, EventData const &event_data,
+                             PrimEventData const &prim_event_data) const {
+    calculate_event_state(state, event_data.unitcell_index,
+                          event_data.event.linear_site_index, prim_event_data);
+  }
+
  private:
   /// System pointer
   std::shared_ptr<system_type> m_system;
@@ -69,9 +196,25 @@ class EventStateCalculator {
   std::shared_ptr<Conditions> m_conditions;
 
   std::shared_ptr<clexulator::ClusterExpansion> m_formation_energy_clex;
-  std::shared_ptr<clexulator::MultiLocalClusterExpansion> m_event_clex;
-  Index m_kra_index;
-  Index m_freq_index;
+
+  /// Local correlations, shared by the KRA and attempt frequency
+  std::shared_ptr<clexulator::LocalCorrelations> m_event_corr;
+
+  /// KRA coefficients, non-zero values only
+  clexulator::SparseCoefficients m_kra_coefficients;
+
+  /// Attempt frequency coefficients, non-zero values only
+  clexulator::SparseCoefficients m_freq_coefficients;
+
+  /// If true, the attempt frequency is `m_constant_freq` for all events
+  bool m_is_constant_freq = false;
+
+  /// Attempt frequency, if `m_is_constant_freq`
+  double m_constant_freq = 0.0;
+
+  /// Indices of the local correlations needed by the KRA and attempt
+  /// frequency (sorted, unique)
+  std::vector<unsigned int> m_corr_indices;
 };
 
 /// \brief Construct a vector EventStateCalculator, one per event in a
@@ -79,7 +222,7 @@ class EventStateCalculator {
 std::vector<EventStateCalculator> make_prim_event_calculators(
     std::shared_ptr<system_type> system, state_type const &state,
     std::vector<PrimEventData> const &prim_event_list,
-    std::shared_ptr<Conditions> conditions);
+    std::shared_ptr<Conditions> conditions, bool independent_clex = false);
 
 /// \brief CompleteEventCalculator is an event calculator with the required
 /// interface for the
@@ -97,35 +240,93 @@ struct CompleteEventCalculator {
   std::vector<EventStateCalculator> const &prim_event_calculators;
 
   /// \brief Complete event list
-  std::map<EventID, EventData> const &event_list;
+  CompleteEventList const &event_list;
 
   /// \brief Write to warn about non-normal events
   Log &event_log;
 
-  // Note: to keep all event state calculations, comment out this:
   /// \brief Holds last calculated event state
   EventState event_state;
 
   /// \brief Count not-normal events
   Index not_normal_count;
 
+  /// \brief Holds linear site indices of the event being calculated
+  std::vector<Index> linear_site_index;
+
+  /// \brief Optional packed copy of the occupation, used to check if events
+  ///     are allowed before evaluating any cluster expansion. If set, it
+  ///     must be kept up-to-date with the state.
+  std::shared_ptr<PackedOccupation const> packed_occupation;
+
+  /// \brief Packed initial occupation of each prim event, compared with
+  ///     `packed_occupation` - order must match prim_event_list
+  std::vector<PackedOccSignature> occ_init_signatures;
+
+  /// \brief Optional cache, which stores the state of each event as its
+  ///     rate is calculated
+  std::shared_ptr<EventStateCache> event_state_cache;
+
+  /// \brief Optional memo of event energies by local environment. Only used
+  ///     if `packed_occupation` is also set.
+  std::shared_ptr<EventStateMemo> event_state_memo;
+
   CompleteEventCalculator(
       std::vector<PrimEventData> const &_prim_event_list,
       std::vector<EventStateCalculator> const &_prim_event_calculators,
-      std::map<EventID, EventData> const &_event_list,
+      CompleteEventList const &_event_list,
       Log &_event_log = CASM::err_log());
 
-  /// \brief Get CASM::monte::OccEvent corresponding to given event ID
-  double calculate_rate(EventID const &id);
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventIndex event_index);
+
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventID const &id) {
+    return calculate_rate(event_list.event_index(id));
+  }
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(EventIndexRange event_index_list,
+                       std::vector<double> &rates);
+
+  /// \brief Log and count the non-normal events stored in an event state
+  ///     cache, as if their rates were calculated
+  void log_not_normal(EventStateCache const &cache);
+
+ private:
+  /// \brief Check if an event is included and allowed, and if so calculate
+  ///     `event_state` except for the rate
+  bool _calculate_activation(EventIndex event_index);
+
+  /// \brief Log and count a non-normal event
+  void _log_not_normal(EventState const &state, Index unitcell_index,
+                       PrimEventData const &prim_event_data);
+
+  /// Batch buffers: -beta * dE_activated, then exp(-beta * dE_activated)
+  std::vector<double> m_batch_exponent;
+
+  /// Batch buffers: attempt frequency
+  std::vector<double> m_batch_freq;
+
+  /// Batch buffers: position in the batch of allowed events
+  std::vector<Index> m_batch_position;
 };
 
 struct KineticEventData {
-  KineticEventData(std::shared_ptr<system_type> _system);
+  KineticEventData(std::shared_ptr<system_type> _system,
+                   std::string const &event_cache_dir = "");
 
   /// \brief Update for given state, conditions, and occupants
   void update(state_type const &state, std::shared_ptr<Conditions> conditions,
               monte::OccLocation const &occ_location,
-              std::vector<EventFilterGroup> const &event_filters);
+              std::vector<EventFilterGroup> const &event_filters,
+              int n_threads = 1, bool with_impact_table = true);
+
+  /// \brief Construct event calculators for use by separate threads
+  std::vector<std::shared_ptr<CompleteEventCalculator>>
+  make_thread_event_calculators(state_type const &state,
+                                std::shared_ptr<Conditions> conditions,
+                                int n_threads);
 
   /// The system
   std::shared_ptr<system_type> system;
@@ -137,6 +338,9 @@ struct KineticEventData {
   /// Information about what sites may impact each prim event
   std::vector<clexmonte::EventImpactInfo> prim_impact_info_list;
 
+  /// Events impacted by each prim event, relative to the origin unit cell
+  std::vector<std::vector<clexmonte::RelativeEventID>> relative_impact_table;
+
   /// All supercell events, and which events must be updated
   /// when one occurs
   clexmonte::CompleteEventList event_list;
@@ -148,8 +352,25 @@ struct KineticEventData {
 
   /// Calculator for KMC event selection
   std::shared_ptr<CompleteEventCalculator> event_calculator;
+
+  /// Functions for calculating event states, one vector for each thread,
+  /// used by the calculators constructed by `make_thread_event_calculators`
+  std::vector<std::vector<EventStateCalculator>> thread_prim_event_calculators;
+
+  /// Optional cache of all event states, shared by the event calculators
+  std::shared_ptr<EventStateCache> event_state_cache;
+
+  /// Optional memo of event energies by local environment, used by
+  /// `event_calculator` only
+  std::shared_ptr<EventStateMemo> event_state_memo;
 };
 
+/// \brief Make rejection KMC rate upper bounds, by prim event index
+std::vector<double> make_prim_event_rate_upper_bound(
+    std::vector<PrimEventData> const &prim_event_list,
+    std::map<std::string, double> const &event_type_rate_upper_bound,
+    std::vector<double> const &calibrated_rate, double calibration_factor);
+
 }  // namespace kinetic
 }  // namespace clexmonte
 }  // namespace CASM
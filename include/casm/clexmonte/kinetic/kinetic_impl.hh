@@ -1,9 +1,19 @@
 #ifndef CASM_clexmonte_kinetic_impl
 #define CASM_clexmonte_kinetic_impl
 
+#include "casm/casm_io/Log.hh"
 #include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/ActiveEventSelector.hh"
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+#include "casm/clexmonte/events/NextReactionEventSelector.hh"
+#include "casm/clexmonte/events/OccupationHash.hh"
+#include "casm/clexmonte/events/ParallelReplicaEventSelector.hh"
+#include "casm/clexmonte/events/RejectionEventSelector.hh"
+#include "casm/clexmonte/events/RejectionFreeEventSelector.hh"
+#include "casm/clexmonte/events/SuperbasinEventSelector.hh"
+#include "casm/clexmonte/events/SynchronousSublatticeEventSelector.hh"
 #include "casm/clexmonte/events/event_methods.hh"
-#include "casm/clexmonte/events/lotto.hh"
+#include "casm/clexmonte/kinetic/KineticReplica.hh"
 #include "casm/clexmonte/kinetic/kinetic.hh"
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 #include "casm/clexmonte/run/analysis_functions.hh"
@@ -32,10 +42,13 @@ namespace kinetic {
 /// \brief Implements kinetic Monte Carlo calculations
 template <typename EngineType>
 Kinetic<EngineType>::Kinetic(std::shared_ptr<system_type> _system,
-                             std::vector<EventFilterGroup> _event_filters)
+                             std::vector<EventFilterGroup> _event_filters,
+                             int _n_threads, std::string _event_cache_dir)
     : system(_system),
       event_filters(_event_filters),
-      event_data(std::make_shared<KineticEventData>(system)),
+      n_threads(_n_threads),
+      event_cache_dir(_event_cache_dir),
+      event_data(std::make_shared<KineticEventData>(system, event_cache_dir)),
       state(nullptr),
       transformation_matrix_to_super(Eigen::Matrix3l::Zero(3, 3)),
       occ_location(nullptr) {
@@ -75,7 +88,8 @@ void Kinetic<EngineType>::run(state_type &state,
         get_transformation_matrix_to_super(state);
     n_unitcells = this->transformation_matrix_to_super.determinant();
     this->event_data->update(state, this->conditions, occ_location,
-                             this->event_filters);
+                             this->event_filters, this->n_threads,
+                             this->rejection_free /*with_impact_table*/);
   }
 
   // Random number generator
@@ -91,19 +105,83 @@ void Kinetic<EngineType>::run(state_type &state,
       get_composition_calculator(*system), semigrand_canonical_swaps,
       occ_location, random_number_generator);
 
-  // Used to apply selected events: EventID -> monte::OccEvent
-  auto get_event_f = [&](EventID const &selected_event_id) {
-    // returns a monte::OccEvent
-    return this->event_data->event_list.events.at(selected_event_id).event;
+  // Packed copy of the occupation, used to skip events that are not allowed
+  // - Re-made each run, because the state may have changed between runs
+  auto packed_occupation = std::make_shared<PackedOccupation>(
+      get_occupation(state),
+      max_n_occupants(*get_prim_basicstructure(*this->system)));
+  this->event_data->event_calculator->packed_occupation = packed_occupation;
+
+  // Optional cache of all event states
+  // - Kept between runs in the same supercell, so that if only the
+  //   conditions change, rates can be rescaled from the cached activation
+  //   energies without evaluating cluster expansions
+  // - Only used by rejection-free KMC with the complete event list; the
+  //   other modes do not keep the state of every event, so the cache is
+  //   not allocated
+  bool is_complete_rejection_free =
+      this->rejection_free && this->active_event_defects.empty() &&
+      this->parallel_replica_n_replicas == 0 &&
+      this->domain_decomposition_n_domains.empty();
+  std::shared_ptr<EventStateCache> &event_state_cache =
+      this->event_data->event_state_cache;
+  if (!this->keep_event_states || !is_complete_rejection_free) {
+    event_state_cache.reset();
+  } else if (!event_state_cache) {
+    event_state_cache = std::make_shared<EventStateCache>(
+        this->event_data->event_list.size());
+  }
+  this->event_data->event_calculator->event_state_cache = event_state_cache;
+
+  // Optional memo of event energies by local environment
+  // - Kept between runs in the same supercell
+  std::shared_ptr<EventStateMemo> &event_state_memo =
+      this->event_data->event_state_memo;
+  if (!this->use_event_state_memo) {
+    event_state_memo.reset();
+  } else if (!event_state_memo) {
+    event_state_memo = std::make_shared<EventStateMemo>(
+        this->event_data->prim_impact_info_list,
+        occ_location.convert().unitcell_index_converter(),
+        this->event_state_memo_max_size,
+        this->event_state_memo_validate_every);
+  } else {
+    event_state_memo->max_size = this->event_state_memo_max_size;
+    event_state_memo->validate_every = this->event_state_memo_validate_every;
+  }
+  this->event_data->event_calculator->event_state_memo = event_state_memo;
+  auto print_event_state_memo_summary = [&]() {
+    if (event_state_memo) {
+      print_summary(CASM::log(), *event_state_memo);
+    }
   };
 
-  // Make selector
-  lotto::RejectionFreeEventSelector event_selector(
-      this->event_data->event_calculator,
-      clexmonte::make_complete_event_id_list(n_unitcells,
-                                             this->event_data->prim_event_list),
-      this->event_data->event_list.impact_table,
-      std::make_shared<lotto::RandomGenerator>(run_manager.engine));
+  // Optional hash of the occupation, used to identify superbasin states
+  std::unique_ptr<OccupationHash> occupation_hash;
+  if (this->use_superbasin) {
+    occupation_hash = std::make_unique<OccupationHash>(get_occupation(state));
+  }
+
+  // Used to apply selected events: EventIndex -> monte::OccEvent
+  // - The selected event is constructed as needed in `selected_event`
+  // - The packed occupation (and occupation hash) is updated as each
+  //   selected event is applied
+  monte::OccEvent selected_event;
+  auto get_event_f =
+      [&](EventIndex selected_event_index) -> monte::OccEvent const & {
+    set_event(selected_event, selected_event_index,
+              this->event_data->event_list, this->event_data->prim_event_list,
+              occ_location);
+    for (Index i = 0; i < selected_event.linear_site_index.size(); ++i) {
+      Index l = selected_event.linear_site_index[i];
+      if (occupation_hash) {
+        occupation_hash->update(l, packed_occupation->get(l),
+                                selected_event.new_occ[i]);
+      }
+      packed_occupation->set(l, selected_event.new_occ[i]);
+    }
+    return selected_event;
+  };
 
   // Update atom_name_index_list -- These do not change --
   // TODO: KMC with atoms that move to/from resevoir will need to update this
@@ -111,8 +189,408 @@ void Kinetic<EngineType>::run(state_type &state,
   this->kmc_data.atom_name_index_list =
       make_atom_name_index_list(occ_location, *event_system);
 
-  monte::kinetic_monte_carlo<EventID>(state, occ_location, this->kmc_data,
-                                      event_selector, get_event_f, run_manager);
+  if (!this->temperature_schedule_time.empty() &&
+      (!this->rejection_free || !this->active_event_defects.empty() ||
+       this->event_selector_type != "next_reaction")) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: \"temperature_schedule\" requires "
+        "rejection-free KMC with event_selector_type \"next_reaction\"");
+  }
+  if (this->use_superbasin &&
+      (!this->rejection_free || !this->active_event_defects.empty() ||
+       this->event_selector_type == "next_reaction")) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: \"superbasin\" requires rejection-free KMC "
+        "with event_selector_type \"sum_tree\" or \"composition_rejection\"");
+  }
+  if (!this->domain_decomposition_n_domains.empty() &&
+      (!this->rejection_free || !this->active_event_defects.empty() ||
+       this->use_superbasin || !this->temperature_schedule_time.empty() ||
+       this->parallel_replica_n_replicas > 0)) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: \"domain_decomposition\" requires "
+        "rejection-free KMC, without \"active_event_defects\", "
+        "\"superbasin\", \"temperature_schedule\", or "
+        "\"parallel_replica\"");
+  }
+  if (this->parallel_replica_n_replicas > 0 &&
+      (!this->rejection_free || !this->active_event_defects.empty() ||
+       this->use_superbasin || !this->temperature_schedule_time.empty())) {
+    throw std::runtime_error(
+        "Error in Kinetic::run: \"parallel_replica\" requires rejection-free "
+        "KMC, without \"active_event_defects\", \"superbasin\", or "
+        "\"temperature_schedule\"");
+  }
+
+  // Rejection KMC: no impact table, rates are calculated for candidates only
+  if (!this->rejection_free) {
+    if (!this->active_event_defects.empty()) {
+      throw std::runtime_error(
+          "Error in Kinetic::run: \"active_event_defects\" is not supported "
+          "for rejection KMC");
+    }
+    std::vector<double> calibrated_rate;
+    for (auto const &prim_event_data : this->event_data->prim_event_list) {
+      if (!this->rate_upper_bound.count(prim_event_data.event_type_name)) {
+        calibrated_rate = calibrate_prim_event_rate_upper_bound(
+            *this->event_data->event_calculator,
+            this->event_data->event_list.n_unitcells,
+            this->event_data->event_list.n_prim_events);
+        break;
+      }
+    }
+    RejectionEventSelector event_selector(
+        this->event_data->event_calculator,
+        this->event_data->event_list.n_unitcells,
+        make_prim_event_rate_upper_bound(this->event_data->prim_event_list,
+                                         this->rate_upper_bound,
+                                         calibrated_rate,
+                                         this->rate_upper_bound_factor),
+        run_manager.engine);
+    monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                           this->kmc_data, event_selector,
+                                           get_event_f, run_manager);
+
+    Log &log = CASM::log();
+    log.custom<Log::standard>("Rejection KMC summary");
+    log.indent() << "n_trials: " << event_selector.n_trials() << std::endl;
+    log.indent() << "n_accepted: " << event_selector.n_accepted()
+                 << std::endl;
+    log.indent() << "rejection_fraction: "
+                 << event_selector.rejection_fraction() << std::endl;
+    log.indent() << "n_bound_exceeded: "
+                 << event_selector.n_bound_exceeded() << std::endl;
+    log.indent() << std::endl;
+    if (event_selector.n_bound_exceeded() > 0) {
+      log.custom<Log::quiet>("Warning");
+      log.indent() << "Event rates exceeded \"rate_upper_bound\" "
+                   << event_selector.n_bound_exceeded()
+                   << " times. Trials were repeated with the raised bounds. "
+                   << "Consider increasing \"rate_upper_bound\" or "
+                   << "\"rate_upper_bound_factor\"." << std::endl;
+      log.indent() << std::endl;
+    }
+    print_event_state_memo_summary();
+    return;
+  }
+
+  // Active event mode: only events anchored by defects are selectable
+  if (!this->active_event_defects.empty()) {
+    ActiveEventList active_event_list(
+        this->event_data->prim_event_list, this->event_data->event_list,
+        occ_location.convert().unitcell_index_converter(),
+        make_is_defect(*get_prim_basicstructure(*this->system),
+                       this->active_event_defects));
+    active_event_list.initialize(get_occupation(state));
+    ActiveEventSelector event_selector(
+        this->event_data->event_calculator, active_event_list,
+        this->event_data->event_list.impact_table, run_manager.engine);
+    monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                           this->kmc_data, event_selector,
+                                           get_event_f, run_manager);
+    print_event_state_memo_summary();
+    return;
+  }
+
+  // Parallel replica dynamics: replicas share the system, event list, and
+  // impact table, and have their own occupation, event rates, and random
+  // number engine, seeded from the run's engine
+  if (this->parallel_replica_n_replicas > 0) {
+    std::unique_ptr<ReplicaBasin> basin;
+    if (!this->parallel_replica_order_parameter.empty()) {
+      basin = std::make_unique<ReplicaBasin>(
+          *get_order_parameter(*this->system, state,
+                               this->parallel_replica_order_parameter),
+          this->parallel_replica_order_parameter_tol);
+    } else {
+      basin = std::make_unique<ReplicaBasin>(
+          make_is_defect(*get_prim_basicstructure(*this->system),
+                         this->parallel_replica_ignored_occupants),
+          this->event_data->event_list.n_unitcells);
+    }
+    std::vector<std::shared_ptr<KineticReplica<EngineType>>> replicas;
+    for (Index k = 0; k < this->parallel_replica_n_replicas; ++k) {
+      replicas.push_back(std::make_shared<KineticReplica<EngineType>>(
+          this->event_data, state, this->conditions, *basin,
+          std::make_shared<EngineType>((*run_manager.engine)())));
+    }
+    std::shared_ptr<ThreadPool> thread_pool;
+    int _n_threads = std::min<Index>(resolve_n_threads(this->n_threads),
+                                     this->parallel_replica_n_replicas);
+    if (_n_threads > 1) {
+      thread_pool = std::make_shared<ThreadPool>(_n_threads);
+    }
+    ParallelReplicaEventSelector<KineticReplica<EngineType>> event_selector(
+        replicas, this->parallel_replica_correlation_time,
+        this->parallel_replica_block_time, thread_pool);
+    monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                           this->kmc_data, event_selector,
+                                           get_event_f, run_manager);
+    for (auto const &replica : replicas) {
+      this->event_data->event_calculator->not_normal_count +=
+          replica->not_normal_count();
+    }
+
+    Log &log = CASM::log();
+    log.custom<Log::standard>("Parallel replica summary");
+    log.indent() << "n_replicas: " << event_selector.n_replicas() << std::endl;
+    log.indent() << "n_escapes: " << event_selector.n_escapes() << std::endl;
+    log.indent() << "n_correlated_escapes: "
+                 << event_selector.n_correlated_escapes() << std::endl;
+    log.indent() << "n_path_events: " << event_selector.n_path_events()
+                 << std::endl;
+    log.indent() << "n_replica_events: " << event_selector.n_replica_events()
+                 << std::endl;
+    log.indent() << "total_time: " << event_selector.total_time() << std::endl;
+    log.indent() << std::endl;
+    print_event_state_memo_summary();
+    return;
+  }
+
+  // Spatially decomposed parallel KMC: domains select and apply events to
+  // a scratch copy of the state, using one event calculator per thread,
+  // and then the events of each window are applied to `state` in time order
+  // - The thread event calculators do not use the packed occupation, which
+  //   follows `state`, not the scratch state
+  if (!this->domain_decomposition_n_domains.empty()) {
+    CompleteEventList const &event_list = this->event_data->event_list;
+    std::vector<Index> const &n_domains = this->domain_decomposition_n_domains;
+    DomainDecomposition domain_decomposition(
+        this->transformation_matrix_to_super,
+        occ_location.convert().unitcell_index_converter(),
+        Eigen::Vector3l(n_domains[0], n_domains[1], n_domains[2]),
+        this->event_data->relative_impact_table);
+
+    state_type scratch_state(state);
+    Eigen::VectorXi &scratch_occupation = get_occupation(scratch_state);
+    int _n_threads = resolve_n_threads(this->n_threads);
+    std::vector<std::shared_ptr<CompleteEventCalculator>>
+        thread_event_calculators =
+            this->event_data->make_thread_event_calculators(
+                scratch_state, this->conditions, _n_threads);
+    std::shared_ptr<ThreadPool> thread_pool;
+    if (_n_threads > 1) {
+      thread_pool = std::make_shared<ThreadPool>(_n_threads);
+    }
+
+    std::vector<std::vector<Index>> thread_linear_site_index(_n_threads);
+    auto apply_event_f = [&](int thread_index, EventIndex event_index) {
+      std::vector<Index> &linear_site_index =
+          thread_linear_site_index[thread_index];
+      Index prim_event_index = event_index % event_list.n_prim_events;
+      event_list.site_table.set_linear_site_index(
+          linear_site_index, event_index / event_list.n_prim_events,
+          prim_event_index);
+      std::vector<int> const &occ_final =
+          this->event_data->prim_event_list[prim_event_index].occ_final;
+      for (Index i = 0; i < linear_site_index.size(); ++i) {
+        scratch_occupation(linear_site_index[i]) = occ_final[i];
+      }
+    };
+
+    SynchronousSublatticeEventSelector<CompleteEventCalculator,
+                                       CompressedEventImpactTable, EngineType>
+        event_selector(thread_event_calculators, domain_decomposition,
+                       event_list.n_prim_events, event_list.impact_table,
+                       apply_event_f, this->domain_decomposition_time_window,
+                       run_manager.engine, thread_pool);
+    monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                           this->kmc_data, event_selector,
+                                           get_event_f, run_manager);
+    for (auto const &thread_event_calculator : thread_event_calculators) {
+      this->event_data->event_calculator->not_normal_count +=
+          thread_event_calculator->not_normal_count;
+    }
+
+    Log &log = CASM::log();
+    log.custom<Log::standard>("Domain decomposition summary");
+    log.indent() << "n_domains: " << domain_decomposition.n_domains
+                 << std::endl;
+    log.indent() << "n_sectors: " << domain_decomposition.n_sectors
+                 << std::endl;
+    log.indent() << "n_windows: " << event_selector.n_windows() << std::endl;
+    log.indent() << "n_events: " << event_selector.n_events() << std::endl;
+    log.indent() << "n_boundary_updates: "
+                 << event_selector.n_boundary_updates() << std::endl;
+    log.indent() << std::endl;
+    print_event_state_memo_summary();
+    return;
+  }
+
+  // Event calculators for use by separate threads, to calculate initial
+  // event rates and, optionally, to update rates of large impact lists
+  int _n_threads = resolve_n_threads(this->n_threads);
+  std::vector<std::shared_ptr<CompleteEventCalculator>>
+      thread_event_calculators;
+  if (_n_threads > 1) {
+    thread_event_calculators = this->event_data->make_thread_event_calculators(
+        state, this->conditions, _n_threads);
+    for (auto const &thread_event_calculator : thread_event_calculators) {
+      thread_event_calculator->packed_occupation = packed_occupation;
+      thread_event_calculator->event_state_cache = event_state_cache;
+    }
+  }
+
+  // Rescale initial rates from the complete event state cache, reporting
+  // non-normal events as a full calculation would
+  auto rescale_initial_rates = [&]() {
+    event_state_cache->rescale_rates(this->conditions->beta);
+    this->event_data->event_calculator->log_not_normal(*event_state_cache);
+  };
+
+  // Make selector and run, with rate table of type `rate_table_type`
+  // - If the event state cache is complete for the current occupation, only
+  //   the conditions have changed, so initial event rates are rescaled from
+  //   the cached activation energies and attempt frequencies
+  // - Else, initial event rates are calculated, in parallel if n_threads > 1
+  auto run_rejection_free = [&](auto const *rate_table_tag) {
+    typedef std::remove_cv_t<std::remove_pointer_t<decltype(rate_table_tag)>>
+        rate_table_type;
+    typedef RejectionFreeEventSelector<CompleteEventCalculator,
+                                       CompressedEventImpactTable, EngineType,
+                                       rate_table_type>
+        selector_type;
+    std::unique_ptr<selector_type> event_selector;
+    if (event_state_cache &&
+        event_state_cache->is_complete_for(get_occupation(state))) {
+      rescale_initial_rates();
+      event_selector = std::make_unique<selector_type>(
+          this->event_data->event_calculator, event_state_cache->rate,
+          this->event_data->event_list.impact_table, run_manager.engine,
+          thread_event_calculators);
+      CASM::log().custom<Log::verbose>(
+          "Event rates rescaled from event state cache");
+      CASM::log() << std::endl;
+    } else {
+      event_selector = std::make_unique<selector_type>(
+          this->event_data->event_calculator,
+          this->event_data->event_list.size(),
+          this->event_data->event_list.impact_table, run_manager.engine,
+          thread_event_calculators);
+    }
+
+    // Optionally, update the rates of large impact lists in parallel
+    if (_n_threads > 1 && this->parallel_update_min_size > 0) {
+      event_selector->set_parallel_update(
+          std::make_shared<ThreadPool>(_n_threads),
+          this->parallel_update_min_size);
+    }
+
+    if (occupation_hash) {
+      // Optionally, accelerate superbasins with the mean rate method
+      SuperbasinEventSelector superbasin_selector(
+          *event_selector, [&]() { return occupation_hash->value(); },
+          this->superbasin_min_steps, this->superbasin_max_states,
+          run_manager.engine);
+      monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                             this->kmc_data,
+                                             superbasin_selector, get_event_f,
+                                             run_manager);
+
+      Log &log = CASM::log();
+      log.custom<Log::standard>("Superbasin summary");
+      log.indent() << "n_superbasin_exits: "
+                   << superbasin_selector.n_superbasin_exits() << std::endl;
+      log.indent() << "n_path_events: " << superbasin_selector.n_path_events()
+                   << std::endl;
+      log.indent() << "superbasin_time: "
+                   << superbasin_selector.superbasin_time() << std::endl;
+      log.indent() << std::endl;
+    } else {
+      monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                             this->kmc_data, *event_selector,
+                                             get_event_f, run_manager);
+    }
+
+    // Leave the event state cache complete for the final occupation
+    if (event_state_cache) {
+      event_selector->update_impacted_event_rates();
+      event_state_cache->occupation = get_occupation(state);
+      event_state_cache->is_complete = true;
+    }
+  };
+
+  // Make next reaction method selector and run
+  // - Initial event rates are rescaled from the cache or calculated, as for
+  //   the other selectors
+  // - If there is a temperature schedule, at each change of temperature all
+  //   event rates are rescaled from the event state cache (or re-calculated
+  //   if there is no cache) and firing times are rescheduled
+  auto run_next_reaction = [&]() {
+    typedef NextReactionEventSelector<CompleteEventCalculator,
+                                      CompressedEventImpactTable, EngineType>
+        selector_type;
+    std::unique_ptr<selector_type> event_selector;
+    if (event_state_cache &&
+        event_state_cache->is_complete_for(get_occupation(state))) {
+      rescale_initial_rates();
+      event_selector = std::make_unique<selector_type>(
+          this->event_data->event_calculator, event_state_cache->rate,
+          this->event_data->event_list.impact_table, run_manager.engine);
+    } else {
+      event_selector = std::make_unique<selector_type>(
+          this->event_data->event_calculator,
+          this->event_data->event_list.size(),
+          this->event_data->event_list.impact_table, run_manager.engine,
+          thread_event_calculators);
+    }
+
+    if (!this->temperature_schedule_time.empty()) {
+      event_selector->set_rate_changes(
+          this->temperature_schedule_time,
+          [&](Index change_index, std::vector<double> &rates) {
+            double temperature =
+                this->temperature_schedule_temperature[change_index];
+            this->conditions->set_temperature(temperature);
+            state.conditions.scalar_values["temperature"] = temperature;
+            if (event_state_cache) {
+              event_state_cache->rescale_rates(this->conditions->beta);
+              rates = event_state_cache->rate;
+            } else {
+              rates.resize(this->event_data->event_list.size());
+              for (Index i = 0; i < rates.size(); ++i) {
+                rates[i] = this->event_data->event_calculator->calculate_rate(
+                    EventIndex(i));
+              }
+            }
+          });
+    }
+
+    monte::kinetic_monte_carlo<EventIndex>(state, occ_location,
+                                           this->kmc_data, *event_selector,
+                                           get_event_f, run_manager);
+
+    // Leave the event state cache complete for the final occupation
+    if (event_state_cache) {
+      event_selector->update_impacted_event_rates();
+      event_state_cache->occupation = get_occupation(state);
+      event_state_cache->is_complete = true;
+    }
+    if (!this->temperature_schedule_time.empty()) {
+      CASM::log().custom<Log::verbose>("Temperature schedule");
+      CASM::log().indent() << "n_changes_applied: "
+                           << event_selector->n_rate_changes_applied()
+                           << std::endl;
+      CASM::log() << std::endl;
+    }
+  };
+
+  if (this->event_selector_type == "sum_tree") {
+    run_rejection_free(static_cast<SumTree const *>(nullptr));
+  } else if (this->event_selector_type == "composition_rejection") {
+    run_rejection_free(static_cast<CompositionRejectionTable const *>(nullptr));
+  } else if (this->event_selector_type == "next_reaction") {
+    run_next_reaction();
+  } else {
+    throw std::runtime_error(
+        "Error in Kinetic::run: invalid event_selector_type \"" +
+        this->event_selector_type + "\"");
+  }
+  for (auto const &thread_event_calculator : thread_event_calculators) {
+    this->event_data->event_calculator->not_normal_count +=
+        thread_event_calculator->not_normal_count;
+  }
+  print_event_state_memo_summary();
 }
 
 /// \brief Construct functions that may be used to sample various quantities
@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_kinetic_json_io
 #define CASM_clexmonte_kinetic_json_io
 
+#include <algorithm>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/events/io/json/EventFilterGroup_json_io.hh"
@@ -36,11 +38,194 @@ namespace kinetic {
 ///     "unitcell_index": array of int
 ///         Specifies by linear unitcell index the unit cells for the
 ///         events are allowed or not allowed.
+///     "regions": array of object (optional)
+///         Specifies unit cells by region, in addition to
+///         "unitcell_index". Each region is either a box,
+///         `{"min": [i, j, k], "max": [i, j, k]}`, or a slab,
+///         `{"axis": int, "min": int, "max": int}`, with inclusive bounds in
+///         unit cell coordinates. Unbounded if "min" or "max" is omitted.
 ///     "include_by_default: bool, (optional, default=true)
 ///         If `true`, the events not listed explicitly in "include" or
 ///         "exclude" are allowed. If `false`, the events not listed in
 ///         "include" or "exclude" are not allowed.
 ///
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to construct the event list and calculate
+///       initial event rates at the beginning of each run. If < 1, the
+///       number of hardware threads is used. Results do not depend on the
+///       number of threads.
+///
+///   "parallel_update_min_size": int (optional, default=0)
+///       If > 0, and "n_threads" gives more than one thread, then after each
+///       event the rates of impacted events are calculated in parallel if
+///       the impact list has at least this many events. Useful for large
+///       local cluster expansion neighborhoods, where impact lists contain
+///       hundreds of events. Results do not depend on the number of
+///       threads.
+///
+///   "event_selector_type": string (optional, default="sum_tree")
+///       For rejection-free KMC, how event rates are stored and events are
+///       selected. One of:
+///       - "sum_tree": A binary tree of partial sums, with O(log N)
+///         selection and update, for N events.
+///       - "composition_rejection": Events are grouped by rate, in factors
+///         of 2. A group is selected by linear search and then an event in
+///         the group by rejection, with O(1) expected selection and update.
+///         Faster for very large event lists.
+///       - "next_reaction": The next reaction method, with putative firing
+///         times of all events in a binary heap. Selection and update are
+///         O(log N). Supports "temperature_schedule".
+///       All select events with probability proportional to their rates,
+///       but they use random numbers differently, so trajectories differ.
+///
+///   "temperature_schedule": object (optional)
+///       If given, the temperature changes during each run, at the given
+///       times from the beginning of the run. At each change, all event
+///       rates are rescaled from the event state cache and firing times are
+///       rescheduled, without re-constructing the event list. Requires
+///       "event_selector_type" = "next_reaction". The state's "temperature"
+///       condition is updated as it changes. Format:
+///
+///     "time": array of float
+///         Times at which the temperature changes. Must be increasing.
+///     "temperature": array of float
+///         Temperature after each change. Same size as "time".
+///
+///   "superbasin": object (optional)
+///       If given, rejection-free KMC (with "event_selector_type" =
+///       "sum_tree" or "composition_rejection") detects superbasins, sets of
+///       a few states that the trajectory visits repeatedly (i.e. a vacancy
+///       flickering near a solute cluster), by a hash of the occupation.
+///       After "min_steps" steps in the same superbasin, the mean exit time
+///       and exit state are calculated by the mean rate method, and the
+///       trajectory jumps to the exit: the events along a shortest path to
+///       the exit state are applied with time increment 0.0, and then an
+///       exit event is applied with the mean exit time. A summary is
+///       printed at the end of each run. Format:
+///
+///     "min_steps": int (optional, default=1000)
+///         Number of steps in the same superbasin before the mean rate
+///         method is used.
+///     "max_states": int (optional, default=16)
+///         Maximum number of states in a superbasin. When a new state would
+///         exceed this, the superbasin is cleared.
+///
+///   "parallel_replica": object (optional)
+///       If given, rejection-free KMC uses parallel replica dynamics, for
+///       rare-event systems where most events do not change the basin of the
+///       state. "n_replicas" independent replicas of the state, each with its
+///       own occupation, event rates, and random number engine, run on up to
+///       "n_threads" threads until one escapes from the current basin. The
+///       events of the first escape are applied to the state, and the
+///       simulated time is accumulated across replicas. The system, event
+///       list, and impact table are shared by all replicas. A summary is
+///       printed at the end of each run. Format:
+///
+///     "n_replicas": int
+///         Number of replicas. Must be >= 1.
+///     "correlation_time": float
+///         Duration of the correlation and dephasing stages. Should be long
+///         compared to the time needed to lose memory of how the basin was
+///         entered.
+///     "block_time": float
+///         Duration of each block of the parallel stage, after which the
+///         replicas are checked for escapes. Must be > 0.0.
+///     "order_parameter": string (optional)
+///         If given, the basin is identified by the values of this order
+///         parameter, by key in the system "dof_spaces", binned with width
+///         "order_parameter_tol". Otherwise, the basin is identified by a
+///         hash of the occupation.
+///     "order_parameter_tol": float (optional, default=0.1)
+///         Order parameter bin width.
+///     "ignored_occupants": array of string (optional)
+///         For the occupation hash, names of occupants that are ignored
+///         (i.e. ["Va", "Al"], so that only the solute configuration
+///         identifies the basin, and vacancy hops that do not move a solute
+///         stay in the basin).
+///
+///   "domain_decomposition": object (optional)
+///       If given, rejection-free KMC is run in parallel on "n_threads"
+///       threads by the synchronous sublattice method. The supercell is
+///       split into domains, and each domain into up to 8 sectors, which
+///       must be at least as wide as the range of the impact table. In each
+///       time window, every domain selects events in the same sector, in
+///       parallel, and rates on sector boundaries are updated at the end of
+///       the window. This is approximate: events near sector boundaries are
+///       delayed by up to one window, so smaller windows are more accurate
+///       and larger windows are more efficient. A summary is printed at the
+///       end of each run. Format:
+///
+///     "n_domains": array of int
+///         Number of domains along each supercell lattice vector, i.e.
+///         [4, 4, 2]. Use more domains than threads for load balancing.
+///     "time_window": float
+///         Simulated time per window. Should be small compared to the
+///         inverse of the fastest single event rate, divided by the number
+///         of sectors per domain.
+///
+///   "event_cache_dir": string (optional)
+///       If given, prim event impact information is cached in this
+///       directory, and re-used by later runs with the same prim, events,
+///       coefficients, and basis sets.
+///
+///   "active_event_defects": array of string (optional)
+///       If given, the names of defect occupants (i.e. ["Va"]). Then only
+///       events with a defect on a site whose initial occupant is a defect
+///       are considered during event selection, and they are updated
+///       incrementally as the defects move. This is much faster for
+///       dilute defect systems. Every event must have a site whose initial
+///       occupant is a defect.
+///
+///   "keep_event_states": bool (optional, default=false)
+///       Opt-in. If true, the state (barriers, attempt frequency, rate) of every
+///       event is stored as it is calculated, so the current states of all
+///       events are available for analysis. Then if a run in the same
+///       supercell begins with the occupation the previous run ended with
+///       (i.e. a temperature scan with no state modification between runs),
+///       the initial rates are rescaled from the cached activation energies
+///       instead of re-evaluating cluster expansions. Requires ~41 bytes
+///       per event. Only used by rejection-free KMC with the complete event
+///       list; ignored, and no memory is allocated, for rejection KMC,
+///       "active_event_defects", "parallel_replica", and
+///       "domain_decomposition".
+///
+///   "event_state_memo": object (optional)
+///       If given, event energies (dE_final, Ekra, freq) are memoized by the
+///       occupation of each event's update neighborhood, and re-used when
+///       the same local environment occurs again. This is useful for
+///       ordered or dilute alloys. A summary of hits and misses is printed
+///       at the end of each run. Format:
+///
+///     "max_size": int (optional, default=1000000)
+///         Maximum number of entries. When full, the memo is cleared.
+///     "validate_every": int (optional, default=0)
+///         If > 0, every "validate_every"-th hit is re-calculated in full
+///         and compared with the memoized values, and validation failures
+///         are counted in the summary.
+///
+///   "rejection_free": bool (optional, default=true)
+///       If true, use rejection-free KMC. If false, use rejection KMC, which
+///       does not construct an impact table. Rejection KMC needs much less
+///       memory and setup time for large supercells, but rejects trials,
+///       so it is efficient only if the rate upper bounds are tight. The
+///       number of trials and the rejection fraction are printed at the end
+///       of each run.
+///
+///   "rate_upper_bound": dict of float (optional)
+///       For rejection KMC, the rate upper bound for each event type, by
+///       event type name. Event types that are not included are calibrated
+///       at the beginning of each run as "rate_upper_bound_factor" times
+///       the maximum rate of all events of that type in the initial state.
+///       If a rate exceeds its upper bound during the run, the bound is
+///       raised, "n_bound_exceeded" is incremented, and the trial is
+///       repeated with the raised bound. A warning is printed at the end of
+///       the run if this occurred, because bounds that are too small or too
+///       large make rejection KMC slow.
+///
+///   "rate_upper_bound_factor": float (optional, default=2.0)
+///       For rejection KMC, the factor multiplying calibrated rate upper
+///       bounds.
+///
 /// \endcode
 ///
 template <typename EngineType>
@@ -58,8 +243,198 @@ void parse(InputParser<Kinetic<EngineType>> &parser,
     }
   }
 
+  // "n_threads"
+  int n_threads = 1;
+  parser.optional(n_threads, "n_threads");
+
+  // "parallel_update_min_size"
+  int parallel_update_min_size = 0;
+  parser.optional(parallel_update_min_size, "parallel_update_min_size");
+
+  // "event_selector_type"
+  std::string event_selector_type = "sum_tree";
+  parser.optional(event_selector_type, "event_selector_type");
+  if (event_selector_type != "sum_tree" &&
+      event_selector_type != "composition_rejection" &&
+      event_selector_type != "next_reaction") {
+    parser.insert_error("event_selector_type",
+                        "Must be \"sum_tree\", \"composition_rejection\", or "
+                        "\"next_reaction\"");
+  }
+
+  // "temperature_schedule"
+  std::vector<double> temperature_schedule_time;
+  std::vector<double> temperature_schedule_temperature;
+  if (parser.self.contains("temperature_schedule")) {
+    parser.require(temperature_schedule_time,
+                   fs::path("temperature_schedule") / "time");
+    parser.require(temperature_schedule_temperature,
+                   fs::path("temperature_schedule") / "temperature");
+    if (temperature_schedule_time.size() !=
+        temperature_schedule_temperature.size()) {
+      parser.insert_error("temperature_schedule",
+                          "\"time\" and \"temperature\" sizes differ");
+    }
+    if (event_selector_type != "next_reaction") {
+      parser.insert_error(
+          "temperature_schedule",
+          "Requires \"event_selector_type\" = \"next_reaction\"");
+    }
+  }
+
+  // "superbasin"
+  bool use_superbasin = parser.self.contains("superbasin");
+  Index superbasin_min_steps = 1000;
+  Index superbasin_max_states = 16;
+  if (use_superbasin) {
+    parser.optional(superbasin_min_steps,
+                    fs::path("superbasin") / "min_steps");
+    parser.optional(superbasin_max_states,
+                    fs::path("superbasin") / "max_states");
+    if (superbasin_min_steps < 1) {
+      parser.insert_error(fs::path("superbasin") / "min_steps",
+                          "Must be >= 1");
+    }
+    if (superbasin_max_states < 2) {
+      parser.insert_error(fs::path("superbasin") / "max_states",
+                          "Must be >= 2");
+    }
+  }
+
+  // "parallel_replica"
+  Index parallel_replica_n_replicas = 0;
+  double parallel_replica_correlation_time = 0.0;
+  double parallel_replica_block_time = 0.0;
+  std::string parallel_replica_order_parameter;
+  double parallel_replica_order_parameter_tol = 0.1;
+  std::vector<std::string> parallel_replica_ignored_occupants;
+  if (parser.self.contains("parallel_replica")) {
+    fs::path base("parallel_replica");
+    parser.require(parallel_replica_n_replicas, base / "n_replicas");
+    parser.require(parallel_replica_correlation_time,
+                   base / "correlation_time");
+    parser.require(parallel_replica_block_time, base / "block_time");
+    parser.optional(parallel_replica_order_parameter,
+                    base / "order_parameter");
+    parser.optional(parallel_replica_order_parameter_tol,
+                    base / "order_parameter_tol");
+    parser.optional(parallel_replica_ignored_occupants,
+                    base / "ignored_occupants");
+    if (parallel_replica_n_replicas < 1) {
+      parser.insert_error(base / "n_replicas", "Must be >= 1");
+    }
+    if (!(parallel_replica_correlation_time >= 0.0)) {
+      parser.insert_error(base / "correlation_time", "Must be >= 0.0");
+    }
+    if (!(parallel_replica_block_time > 0.0)) {
+      parser.insert_error(base / "block_time", "Must be > 0.0");
+    }
+    if (!(parallel_replica_order_parameter_tol > 0.0)) {
+      parser.insert_error(base / "order_parameter_tol", "Must be > 0.0");
+    }
+    if (!parallel_replica_order_parameter.empty() &&
+        !system->dof_spaces.count(parallel_replica_order_parameter)) {
+      parser.insert_error(base / "order_parameter",
+                          "No order parameter \"" +
+                              parallel_replica_order_parameter + "\"");
+    }
+  }
+
+  // "domain_decomposition"
+  std::vector<Index> domain_decomposition_n_domains;
+  double domain_decomposition_time_window = 0.0;
+  if (parser.self.contains("domain_decomposition")) {
+    fs::path base("domain_decomposition");
+    parser.require(domain_decomposition_n_domains, base / "n_domains");
+    parser.require(domain_decomposition_time_window, base / "time_window");
+    if (domain_decomposition_n_domains.size() != 3 ||
+        std::any_of(domain_decomposition_n_domains.begin(),
+                    domain_decomposition_n_domains.end(),
+                    [](Index n) { return n < 1; })) {
+      parser.insert_error(base / "n_domains",
+                          "Must be an array of 3 int, each >= 1");
+    }
+    if (!(domain_decomposition_time_window > 0.0)) {
+      parser.insert_error(base / "time_window", "Must be > 0.0");
+    }
+  }
+
+  // "event_cache_dir"
+  std::string event_cache_dir;
+  parser.optional(event_cache_dir, "event_cache_dir");
+
+  // "active_event_defects"
+  std::vector<std::string> active_event_defects;
+  parser.optional(active_event_defects, "active_event_defects");
+
+  // "keep_event_states"
+  bool keep_event_states = false;
+  parser.optional(keep_event_states, "keep_event_states");
+
+  // "event_state_memo"
+  bool use_event_state_memo = parser.self.contains("event_state_memo");
+  Index event_state_memo_max_size = 1000000;
+  Index event_state_memo_validate_every = 0;
+  if (use_event_state_memo) {
+    parser.optional(event_state_memo_max_size,
+                    fs::path("event_state_memo") / "max_size");
+    parser.optional(event_state_memo_validate_every,
+                    fs::path("event_state_memo") / "validate_every");
+    if (event_state_memo_max_size < 1) {
+      parser.insert_error(fs::path("event_state_memo") / "max_size",
+                          "Must be >= 1");
+    }
+  }
+
+  // "rejection_free"
+  bool rejection_free = true;
+  parser.optional(rejection_free, "rejection_free");
+
+  // "rate_upper_bound"
+  std::map<std::string, double> rate_upper_bound;
+  parser.optional(rate_upper_bound, "rate_upper_bound");
+
+  // "rate_upper_bound_factor"
+  double rate_upper_bound_factor = 2.0;
+  parser.optional(rate_upper_bound_factor, "rate_upper_bound_factor");
+  if (!(rate_upper_bound_factor >= 1.0)) {
+    parser.insert_error("rate_upper_bound_factor", "Must be >= 1.0");
+  }
+
   if (parser.valid()) {
-    parser.value = std::make_unique<Kinetic<EngineType>>(system, event_filters);
+    parser.value = std::make_unique<Kinetic<EngineType>>(
+        system, event_filters, n_threads, event_cache_dir);
+    parser.value->active_event_defects = active_event_defects;
+    parser.value->keep_event_states = keep_event_states;
+    parser.value->parallel_update_min_size = parallel_update_min_size;
+    parser.value->event_selector_type = event_selector_type;
+    parser.value->temperature_schedule_time = temperature_schedule_time;
+    parser.value->temperature_schedule_temperature =
+        temperature_schedule_temperature;
+    parser.value->use_superbasin = use_superbasin;
+    parser.value->superbasin_min_steps = superbasin_min_steps;
+    parser.value->superbasin_max_states = superbasin_max_states;
+    parser.value->parallel_replica_n_replicas = parallel_replica_n_replicas;
+    parser.value->parallel_replica_correlation_time =
+        parallel_replica_correlation_time;
+    parser.value->parallel_replica_block_time = parallel_replica_block_time;
+    parser.value->parallel_replica_order_parameter =
+        parallel_replica_order_parameter;
+    parser.value->parallel_replica_order_parameter_tol =
+        parallel_replica_order_parameter_tol;
+    parser.value->parallel_replica_ignored_occupants =
+        parallel_replica_ignored_occupants;
+    parser.value->domain_decomposition_n_domains =
+        domain_decomposition_n_domains;
+    parser.value->domain_decomposition_time_window =
+        domain_decomposition_time_window;
+    parser.value->use_event_state_memo = use_event_state_memo;
+    parser.value->event_state_memo_max_size = event_state_memo_max_size;
+    parser.value->event_state_memo_validate_every =
+        event_state_memo_validate_every;
+    parser.value->rejection_free = rejection_free;
+    parser.value->rate_upper_bound = rate_upper_bound;
+    parser.value->rate_upper_bound_factor = rate_upper_bound_factor;
   }
 }
 
@@ -0,0 +1,248 @@
+/// An implementation of a checkerboard-parallel occupation Metropolis Monte
+/// Carlo main loop, for single-site occupation changes, that makes use of
+/// the RunManager provided by casm/monte/run_management to implement
+/// sampling fixtures and results data structures and input/output methods.
+
+#ifndef CASM_clexmonte_methods_checkerboard_metropolis
+#define CASM_clexmonte_methods_checkerboard_metropolis
+
+#include <memory>
+#include <vector>
+
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/monte/Conversions.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/run_management/Results.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+template <typename PotentialOccDeltaPerSupercellF, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void checkerboard_occupation_metropolis(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature,
+    std::vector<PotentialOccDeltaPerSupercellF> const
+        &thread_potential_occ_delta_per_supercell_f,
+    DomainDecomposition const &domain_decomposition,
+    std::vector<std::vector<std::vector<int>>> const &allowed_new_occ,
+    ThreadPool &thread_pool,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager);
+
+// --- Implementation ---
+
+/// \brief Run a checkerboard-parallel occupation Metropolis Monte Carlo
+///     calculation, with single-site occupation changes
+///
+/// The supercell is split into domains, and each domain into sectors, by
+/// `domain_decomposition`, so that sites in the same sector of different
+/// domains do not interact. Each sub-sweep:
+///
+/// 1. A sector is chosen at random.
+/// 2. In parallel, for each domain, one Metropolis attempt is made per site
+///    in that sector of the domain, each at a site chosen at random from
+///    the sector. Each domain has its own random number engine, seeded from
+///    `run_manager.engine`, so results do not depend on the number of
+///    threads.
+/// 3. The attempts are replayed in order, domain by domain: accepted changes
+///    are applied to `occ_location`, each attempt is counted as a step, and
+///    samples and completion checks are made after each step, as for
+///    sequential Metropolis.
+///
+/// Each sub-sweep is a product of independent Metropolis updates of
+/// non-interacting regions, so it satisfies detailed balance, and the
+/// random choice of sector keeps the Boltzmann distribution stationary.
+/// Because domains do not interact, replaying the attempts domain by domain
+/// gives the same trajectory as making them sequentially, so samples taken
+/// during the replay see the state after each step.
+///
+/// \param state The state. Consists of both the initial
+///     configuration and conditions.
+/// \param occ_location An occupant location tracker. It must already be
+///     initialized with the input state.
+/// \param temperature The temperature, in K.
+/// \param thread_potential_occ_delta_per_supercell_f One function per
+///     thread, with signature
+///     `double f(std::vector<Index> const &linear_site_index,
+///     std::vector<int> const &new_occ)`, which calculates the change in
+///     potential energy due to a proposed occupation change. They must not
+///     share data that is not thread-safe (i.e. Clexulator).
+/// \param domain_decomposition Domains and sectors, by unit cell, with
+///     sectors at least as wide as the range of the potential
+/// \param allowed_new_occ Allowed new occupation values, as
+///     `allowed_new_occ[sublattice][current occupation]`. A new occupation
+///     value is proposed uniformly from these. For detailed balance, the
+///     number of choices must be the same for all occupation values on a
+///     sublattice.
+/// \param thread_pool Threads, no more than the number of potential
+///     functions
+/// \param run_manager Contains random number engine, sampling fixtures, and
+///     after completion holds final results
+///
+/// Notes:
+/// - Linear site index `l = sublattice * n_unitcells + unitcell_index`
+/// - If the run completes during the replay of a sub-sweep, the remaining
+///   attempts of the sub-sweep are discarded
+template <typename PotentialOccDeltaPerSupercellF, typename ConfigType,
+          typename StatisticsType, typename EngineType>
+void checkerboard_occupation_metropolis(
+    monte::State<ConfigType> &state, monte::OccLocation &occ_location,
+    double temperature,
+    std::vector<PotentialOccDeltaPerSupercellF> const
+        &thread_potential_occ_delta_per_supercell_f,
+    DomainDecomposition const &domain_decomposition,
+    std::vector<std::vector<std::vector<int>>> const &allowed_new_occ,
+    ThreadPool &thread_pool,
+    monte::RunManager<ConfigType, StatisticsType, EngineType> &run_manager) {
+  if (thread_pool.n_threads() >
+      thread_potential_occ_delta_per_supercell_f.size()) {
+    throw std::runtime_error(
+        "Error in checkerboard_occupation_metropolis: too few thread "
+        "potential functions");
+  }
+  Eigen::VectorXi &occupation = get_occupation(state);
+  monte::Conversions const &convert = occ_location.convert();
+  Index n_domains = domain_decomposition.n_domains;
+  Index n_sectors = domain_decomposition.n_sectors;
+  Index n_unitcells = domain_decomposition.unitcell_domain.size();
+
+  // Sites with allowed changes, by domain and sector
+  std::vector<std::vector<Index>> sites(n_domains * n_sectors);
+  for (Index b = 0; b < allowed_new_occ.size(); ++b) {
+    bool is_flexible = false;
+    for (auto const &options : allowed_new_occ[b]) {
+      is_flexible = is_flexible || !options.empty();
+    }
+    if (!is_flexible) {
+      continue;
+    }
+    for (Index u = 0; u < n_unitcells; ++u) {
+      sites[domain_decomposition.unitcell_domain[u] * n_sectors +
+            domain_decomposition.unitcell_sector[u]]
+          .push_back(b * n_unitcells + u);
+    }
+  }
+
+  // Random number generators, by domain
+  monte::RandomNumberGenerator<EngineType> random_number_generator(
+      run_manager.engine);
+  std::vector<monte::RandomNumberGenerator<EngineType>> domain_generators;
+  for (Index d = 0; d < n_domains; ++d) {
+    auto seed = (*random_number_generator.engine)();
+    domain_generators.emplace_back(std::make_shared<EngineType>(seed));
+  }
+
+  // Accepted changes, by domain, as (attempt index, linear site index, old
+  // occ, new occ)
+  struct Change {
+    Index attempt;
+    Index l;
+    int old_occ;
+    int new_occ;
+  };
+  std::vector<std::vector<Change>> changes(n_domains);
+  std::vector<Index> n_attempts(n_domains);
+
+  // Used to apply accepted changes to occ_location
+  monte::OccEvent event;
+  event.linear_site_index.resize(1);
+  event.new_occ.resize(1);
+  event.occ_transform.resize(1);
+
+  Index steps_per_pass = occ_location.mol_size();
+  double beta = 1.0 / (CASM::KB * temperature);
+
+  // Main loop
+  run_manager.initialize(steps_per_pass);
+  run_manager.sample_data_by_count_if_due(state);
+  while (!run_manager.is_complete()) {
+    // Write run status, if due
+    run_manager.write_status_if_due();
+
+    // Choose a sector
+    Index sector = random_number_generator.random_int(n_sectors - 1);
+
+    // Metropolis attempts, in parallel by domain
+    thread_pool.for_blocks(n_domains, [&](int thread_index, Index begin,
+                                          Index end) {
+      auto const &potential_occ_delta_per_supercell_f =
+          thread_potential_occ_delta_per_supercell_f[thread_index];
+      std::vector<Index> linear_site_index(1);
+      std::vector<int> new_occ(1);
+      for (Index d = begin; d < end; ++d) {
+        std::vector<Index> const &domain_sites =
+            sites[d * n_sectors + sector];
+        monte::RandomNumberGenerator<EngineType> &domain_generator =
+            domain_generators[d];
+        changes[d].clear();
+        n_attempts[d] = domain_sites.size();
+        for (Index i = 0; i < n_attempts[d]; ++i) {
+          Index l = domain_sites[domain_generator.random_int(
+              domain_sites.size() - 1)];
+          int old_occ = occupation(l);
+          auto const &options = allowed_new_occ[l / n_unitcells][old_occ];
+          if (options.empty()) {
+            continue;
+          }
+          linear_site_index[0] = l;
+          new_occ[0] =
+              options[domain_generator.random_int(options.size() - 1)];
+          double delta_potential_energy =
+              potential_occ_delta_per_supercell_f(linear_site_index, new_occ);
+          if (metropolis_acceptance(delta_potential_energy, beta,
+                                    domain_generator)) {
+            occupation(l) = new_occ[0];
+            changes[d].push_back({i, l, old_occ, new_occ[0]});
+          }
+        }
+      }
+    });
+
+    // Restore the previous occupation
+    for (Index d = 0; d < n_domains; ++d) {
+      for (auto it = changes[d].rbegin(); it != changes[d].rend(); ++it) {
+        occupation(it->l) = it->old_occ;
+      }
+    }
+
+    // Replay attempts in order, domain by domain: apply accepted changes to
+    // occ_location, count attempts, and sample data if due by count
+    for (Index d = 0; d < n_domains && !run_manager.is_complete(); ++d) {
+      auto change_it = changes[d].begin();
+      for (Index i = 0; i < n_attempts[d] && !run_manager.is_complete();
+           ++i) {
+        if (change_it != changes[d].end() && change_it->attempt == i) {
+          Change const &change = *change_it;
+          Index asym = convert.l_to_asym(change.l);
+          event.linear_site_index[0] = change.l;
+          event.new_occ[0] = change.new_occ;
+          monte::OccTransform &transform = event.occ_transform[0];
+          transform.mol_id = occ_location.l_to_mol_id(change.l);
+          transform.l = change.l;
+          transform.asym = asym;
+          transform.from_species = convert.species_index(asym, change.old_occ);
+          transform.to_species = convert.species_index(asym, change.new_occ);
+          occ_location.apply(event, occupation);
+          run_manager.increment_n_accept();
+          ++change_it;
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(state);
+      }
+    }
+  }
+
+  run_manager.finalize(state);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
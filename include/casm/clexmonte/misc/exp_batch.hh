@@ -0,0 +1,66 @@
+#ifndef CASM_clexmonte_misc_exp_batch
+#define CASM_clexmonte_misc_exp_batch
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Calculate `y[i] = exp(x[i])` for `i` in [0, n)
+///
+/// This is written without branches or library calls, so that the compiler
+/// can vectorize the loop. It is used to evaluate the Arrhenius step for a
+/// batch of event rates at once.
+///
+/// Notes:
+/// - `x` and `y` may be the same array
+/// - `x` is clamped to [-700.0, 700.0], so results for `x < -700.0` are
+///   ~1e-304 rather than 0.0
+/// - The range reduction is `x = k*ln(2) + r`, with `|r| <= ln(2)/2`, and
+///   `exp(r)` is evaluated by its degree 13 Taylor polynomial, so results
+///   agree with `std::exp` to within a few ulp
+inline void exp_batch(double const *x, double *y, Index n) {
+  const double log2e = 1.4426950408889634;
+  const double ln2_hi = 6.93145751953125e-1;
+  const double ln2_lo = 1.42860682030941723212e-6;
+  const double round_shift = 6755399441055744.0;
+  for (Index i = 0; i < n; ++i) {
+    double v = std::min(std::max(x[i], -700.0), 700.0);
+
+    // v = k*ln(2) + r, with k = round(v * log2e); adding and subtracting
+    // 1.5 * 2^52 rounds to the nearest integer
+    double k = (v * log2e + round_shift) - round_shift;
+    double r = (v - k * ln2_hi) - k * ln2_lo;
+
+    // exp(r), Horner form of sum_{j=0}^{13} r^j / j!
+    double p = 1.6059043836821613e-10;
+    p = p * r + 2.08767569878681e-09;
+    p = p * r + 2.505210838544172e-08;
+    p = p * r + 2.755731922398589e-07;
+    p = p * r + 2.7557319223985893e-06;
+    p = p * r + 2.48015873015873e-05;
+    p = p * r + 1.984126984126984e-04;
+    p = p * r + 1.388888888888889e-03;
+    p = p * r + 8.333333333333333e-03;
+    p = p * r + 4.1666666666666664e-02;
+    p = p * r + 1.6666666666666666e-01;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // 2^k
+    std::int64_t bits = (static_cast<std::int64_t>(k) + 1023) << 52;
+    double two_k;
+    std::memcpy(&two_k, &bits, sizeof(double));
+    y[i] = p * two_k;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
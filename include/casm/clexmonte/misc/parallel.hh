@@ -0,0 +1,204 @@
+#ifndef CASM_clexmonte_misc_parallel
+#define CASM_clexmonte_misc_parallel
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "casm/global/definitions.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Return the number of threads to use
+///
+/// \param n_threads Requested number of threads. If `n_threads < 1`, the
+///     number of hardware threads is used.
+///
+/// \returns The number of threads to use, always >= 1
+inline int resolve_n_threads(int n_threads) {
+  if (n_threads < 1) {
+    n_threads = std::thread::hardware_concurrency();
+  }
+  return std::max(n_threads, 1);
+}
+
+/// \brief Split the range [0, n) into contiguous blocks and call
+///     `f(thread_index, begin, end)` for each block in a separate thread
+///
+/// Notes:
+/// - Block `i` is `[i * n / n_blocks, (i + 1) * n / n_blocks)`, so the
+///   partition depends only on `n` and `n_threads` and results written by
+///   index are independent of thread scheduling
+/// - If `n_threads <= 1` or `n` is small, `f(0, 0, n)` is called in the
+///   calling thread
+/// - If any block throws, the first exception (by block index) is rethrown
+///   after all threads have joined
+///
+/// \param n Size of the range
+/// \param n_threads Number of threads, as resolved by `resolve_n_threads`
+/// \param f Function with signature `void f(int thread_index, Index begin,
+///     Index end)`
+template <typename F>
+void parallel_for_blocks(Index n, int n_threads, F f) {
+  int n_blocks = static_cast<int>(std::min<Index>(n_threads, n));
+  if (n_blocks <= 1) {
+    f(0, Index(0), n);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> errors(n_blocks);
+  threads.reserve(n_blocks);
+  for (int i = 0; i < n_blocks; ++i) {
+    Index begin = (n * i) / n_blocks;
+    Index end = (n * (i + 1)) / n_blocks;
+    threads.emplace_back([&, i, begin, end]() {
+      try {
+        f(i, begin, end);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+  for (auto const &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+/// \brief A fixed set of worker threads, for running many small parallel
+///     loops without creating threads for each
+///
+/// `for_blocks` has the same semantics as `parallel_for_blocks`, but the
+/// `n_threads - 1` worker threads are created once, at construction, and
+/// block 0 is run by the calling thread. This is used for parallel work that
+/// is repeated often and is too small to amortize creating threads, such as
+/// updating the rates of events impacted by each KMC event.
+///
+/// Notes:
+/// - `for_blocks` must not be called concurrently, or from within `f`
+class ThreadPool {
+ public:
+  /// \brief Constructor
+  ///
+  /// \param n_threads Number of threads, including the calling thread, as
+  ///     resolved by `resolve_n_threads`
+  explicit ThreadPool(int n_threads)
+      : m_n_threads(std::max(n_threads, 1)),
+        m_generation(0),
+        m_n_pending(0),
+        m_stop(false) {
+    for (int i = 1; i < m_n_threads; ++i) {
+      m_workers.emplace_back([this, i]() { _work(i); });
+    }
+  }
+
+  ThreadPool(ThreadPool const &) = delete;
+  ThreadPool &operator=(ThreadPool const &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_start_cv.notify_all();
+    for (auto &t : m_workers) {
+      t.join();
+    }
+  }
+
+  /// \brief Number of threads, including the calling thread
+  int n_threads() const { return m_n_threads; }
+
+  /// \brief Split the range [0, n) into contiguous blocks and call
+  ///     `f(thread_index, begin, end)` for each block in a separate thread
+  ///
+  /// Blocks are as in `parallel_for_blocks`. If any block throws, the first
+  /// exception (by block index) is rethrown after all blocks are done.
+  template <typename F>
+  void for_blocks(Index n, F f) {
+    int n_blocks = static_cast<int>(std::min<Index>(m_n_threads, n));
+    if (n_blocks <= 1) {
+      f(0, Index(0), n);
+      return;
+    }
+
+    m_errors.assign(n_blocks, nullptr);
+    m_job = [&, n, n_blocks](int i) {
+      if (i >= n_blocks) {
+        return;
+      }
+      try {
+        f(i, (n * i) / n_blocks, (n * (i + 1)) / n_blocks);
+      } catch (...) {
+        m_errors[i] = std::current_exception();
+      }
+    };
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_n_pending = m_n_threads - 1;
+      ++m_generation;
+    }
+    m_start_cv.notify_all();
+    m_job(0);
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_done_cv.wait(lock, [this]() { return m_n_pending == 0; });
+    }
+    for (auto const &e : m_errors) {
+      if (e) {
+        std::rethrow_exception(e);
+      }
+    }
+  }
+
+ private:
+  void _work(int thread_index) {
+    Index seen_generation = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_start_cv.wait(lock, [&]() {
+          return m_stop || m_generation != seen_generation;
+        });
+        if (m_stop) {
+          return;
+        }
+        seen_generation = m_generation;
+      }
+      m_job(thread_index);
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_n_pending;
+        if (m_n_pending == 0) {
+          m_done_cv.notify_one();
+        }
+      }
+    }
+  }
+
+  int m_n_threads;
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  std::function<void(int)> m_job;
+  std::vector<std::exception_ptr> m_errors;
+  Index m_generation;
+  int m_n_pending;
+  bool m_stop;
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
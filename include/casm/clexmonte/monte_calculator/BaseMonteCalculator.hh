@@ -163,6 +163,9 @@ class BaseMonteCalculator {
   /// KMC data for sampling functions, for the current state (if applicable)
   std::shared_ptr<kmc_data_type> kmc_data;
 
+  /// Method-specific information about the last run (empty object if none)
+  jsonParser run_info;
+
   // --- Run method: ---
 
   /// \brief Perform a single run, evolving current state
@@ -188,6 +191,13 @@ class BaseMonteCalculator {
                    std::vector<monte::OccLocation> &occ_locations,
                    run_manager_type<engine_type> &run_manager) = 0;
 
+  /// \brief Perform a single run, evolving multiple states, each sampled by
+  ///     its own run manager
+  virtual void run(std::vector<state_type> &states,
+                   std::vector<monte::OccLocation> &occ_locations,
+                   std::vector<std::shared_ptr<run_manager_type<engine_type>>>
+                       &run_managers);
+
   /// \brief Clone the BaseMonteCalculator
   std::unique_ptr<BaseMonteCalculator> clone() const;
 
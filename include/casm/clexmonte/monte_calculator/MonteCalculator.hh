@@ -164,6 +164,9 @@ class MonteCalculator {
     return m_calc->kmc_data;
   }
 
+  /// Method-specific information about the last run (empty object if none)
+  jsonParser const &run_info() const { return m_calc->run_info; }
+
   /// \brief Perform a single run, evolving current state
   void run(state_type &state, monte::OccLocation &occ_location,
            run_manager_type<engine_type> &run_manager) {
@@ -242,6 +245,15 @@ class MonteCalculator {
     m_calc->run(current_state, states, occ_locations, run_manager);
   }
 
+  /// \brief Perform a single run, evolving multiple states, each sampled by
+  ///     its own run manager
+  void run(std::vector<state_type> &states,
+           std::vector<monte::OccLocation> &occ_locations,
+           std::vector<std::shared_ptr<run_manager_type<engine_type>>>
+               &run_managers) {
+    m_calc->run(states, occ_locations, run_managers);
+  }
+
  private:
   notstd::cloneable_ptr<BaseMonteCalculator> m_calc;
   std::shared_ptr<RuntimeLibrary> m_lib;
@@ -0,0 +1,71 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold
+#define CASM_clexmonte_nfold_canonical_nfold
+
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/nfold/nfold_events.hh"
+#include "casm/monte/methods/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Implements canonical N-fold way Monte Carlo calculations
+///
+/// Events are exchanges of the occupants of pairs of sites no more than
+/// `max_length` apart, one event type for each canonical swap type and pair
+/// orbit. Each step is an accepted exchange, selected with probability
+/// proportional to its Metropolis acceptance probability, and the
+/// residence time is sampled, so this samples the same distribution as
+/// Metropolis Monte Carlo with nearby-pair exchanges without rejected steps.
+template <typename EngineType>
+struct CanonicalNfold : public canonical::Canonical<EngineType> {
+  typedef EngineType engine_type;
+
+  explicit CanonicalNfold(std::shared_ptr<system_type> _system,
+                          double _max_length, int _n_threads = 1,
+                          std::string _event_cache_dir = "");
+
+  /// Method allows time-based sampling
+  bool time_sampling_allowed = true;
+
+  /// Maximum distance between the sites of an exchange event
+  double max_length;
+
+  /// Number of threads used to construct the event list and calculate
+  /// initial event rates. If < 1, the number of hardware threads is used.
+  int n_threads;
+
+  /// If not empty, directory used to cache prim event impact information
+  std::string event_cache_dir;
+
+  /// Event rate table: "sum_tree" (O(log N) selection and update),
+  /// "composition_rejection" (O(1) expected selection and update), or
+  /// "rate_class" (O(1) expected selection and update, with BKL-style rate
+  /// classes)
+  std::string event_selector_type = "sum_tree";
+
+  /// Data for N-fold way implementation
+  std::shared_ptr<CanonicalNfoldEventData> event_data;
+
+  /// Data for sampling functions
+  monte::NfoldData<config_type, statistics_type, engine_type> nfold_data;
+
+  /// \brief Perform a single run, evolving current state
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<EngineType> &run_manager);
+
+  typedef canonical::Canonical<EngineType> Base;
+  using Base::standard_analysis_functions;
+  using Base::standard_json_sampling_functions;
+  using Base::standard_modifying_functions;
+  using Base::standard_sampling_functions;
+};
+
+/// \brief Explicitly instantiated CanonicalNfold calculator
+typedef CanonicalNfold<std::mt19937_64> CanonicalNfold_mt19937_64;
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,102 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold_impl
+#define CASM_clexmonte_nfold_canonical_nfold_impl
+
+#include "casm/clexmonte/canonical/canonical_impl.hh"
+#include "casm/clexmonte/nfold/canonical_nfold.hh"
+#include "casm/clexmonte/nfold/run_nfold.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/state/enforce_composition.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/methods/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+template <typename EngineType>
+CanonicalNfold<EngineType>::CanonicalNfold(
+    std::shared_ptr<system_type> _system, double _max_length, int _n_threads,
+    std::string _event_cache_dir)
+    : canonical::Canonical<EngineType>(_system),
+      max_length(_max_length),
+      n_threads(_n_threads),
+      event_cache_dir(_event_cache_dir) {}
+
+/// \brief Perform a single run, evolving current state
+///
+/// Notes:
+/// - state and occ_location are evolved and end in modified states
+/// - The composition is enforced at the beginning of the run, as for
+///   canonical::Canonical
+/// - For time-based sampling, time is measured in Metropolis attempts,
+///   each choosing uniformly among all exchange events in the supercell
+template <typename EngineType>
+void CanonicalNfold<EngineType>::run(
+    state_type &state, monte::OccLocation &occ_location,
+    run_manager_type<EngineType> &run_manager) {
+  if (!state.conditions.scalar_values.count("temperature")) {
+    throw std::runtime_error(
+        "Error in CanonicalNfold::run: state `temperature` not set.");
+  }
+  if (!state.conditions.vector_values.count("mol_composition")) {
+    throw std::runtime_error(
+        "Error in CanonicalNfold::run: state `mol_composition` conditions "
+        "not set.");
+  }
+
+  // Store state info / pointers
+  this->state = &state;
+  this->occ_location = &occ_location;
+  this->conditions = clexmonte::make_conditions(*this->system, state);
+
+  // Make potential calculator
+  this->potential =
+      std::make_shared<canonical::CanonicalPotential>(this->system);
+  this->potential->set(this->state, this->conditions);
+  this->formation_energy = this->potential->formation_energy();
+
+  // Get swaps
+  std::vector<monte::OccSwap> const &canonical_swaps =
+      get_canonical_swaps(*this->system);
+  std::vector<monte::OccSwap> const &semigrand_canonical_swaps =
+      get_semigrand_canonical_swaps(*this->system);
+
+  // Enforce composition
+  monte::RandomNumberGenerator<EngineType> random_number_generator(
+      run_manager.engine);
+  clexmonte::enforce_composition(
+      get_occupation(state),
+      state.conditions.vector_values.at("mol_composition"),
+      get_composition_calculator(*this->system), semigrand_canonical_swaps,
+      occ_location, random_number_generator);
+
+  // if same supercell
+  // -> just re-set potential & avoid re-constructing event list
+  if (this->transformation_matrix_to_super ==
+          get_transformation_matrix_to_super(state) &&
+      this->event_data != nullptr) {
+    this->event_data->event_calculator->potential = this->potential;
+  } else {
+    this->transformation_matrix_to_super =
+        get_transformation_matrix_to_super(state);
+
+    // Event data
+    this->event_data = std::make_shared<CanonicalNfoldEventData>(
+        this->system, state, occ_location, canonical_swaps, this->potential,
+        this->max_length, this->n_threads, this->event_cache_dir);
+
+    // Nfold data
+    this->nfold_data.n_events_possible =
+        static_cast<double>(this->event_data->event_list.size());
+  }
+
+  run_nfold(this->system, state, occ_location, this->conditions,
+            *this->event_data, this->nfold_data, this->n_threads,
+            this->event_selector_type, "CanonicalNfold::run", run_manager);
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef CASM_clexmonte_nfold_canonical_nfold_json_io
+#define CASM_clexmonte_nfold_canonical_nfold_json_io
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/nfold/canonical_nfold_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Parse CanonicalNfold "calculation_options"
+///
+/// Expected format:
+/// \code
+///   "max_length": number (required)
+///       Maximum distance between the two sites of an exchange event. Events
+///       are made for each canonical swap type and each pair of sites no
+///       more than this far apart.
+///
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to construct the event list and calculate
+///       initial event rates at the beginning of each run. If < 1, the
+///       number of hardware threads is used. Results do not depend on the
+///       number of threads.
+///
+///   "event_selector_type": string (optional, default="sum_tree")
+///       How event rates are stored and events are selected. One of
+///       "sum_tree", "composition_rejection", or "rate_class", as for the
+///       semi-grand canonical N-fold way.
+///
+///   "event_cache_dir": string (optional)
+///       If given, prim event impact information is cached in this
+///       directory, and re-used by later runs with the same prim, events,
+///       coefficients, and basis sets.
+/// \endcode
+template <typename EngineType>
+void parse(InputParser<CanonicalNfold<EngineType>> &parser,
+           std::shared_ptr<system_type> system,
+           std::shared_ptr<EngineType> random_number_engine =
+               std::shared_ptr<EngineType>()) {
+  // "max_length"
+  double max_length = 0.0;
+  parser.require(max_length, "max_length");
+  if (parser.valid() && !(max_length > 0.0)) {
+    parser.insert_error("max_length", "Must be > 0.0");
+  }
+
+  // "n_threads"
+  int n_threads = 1;
+  parser.optional(n_threads, "n_threads");
+
+  // "event_selector_type"
+  std::string event_selector_type = "sum_tree";
+  parser.optional(event_selector_type, "event_selector_type");
+  if (event_selector_type != "sum_tree" &&
+      event_selector_type != "composition_rejection" &&
+      event_selector_type != "rate_class") {
+    parser.insert_error("event_selector_type",
+                        "Must be \"sum_tree\", \"composition_rejection\", or "
+                        "\"rate_class\"");
+  }
+
+  // "event_cache_dir"
+  std::string event_cache_dir;
+  parser.optional(event_cache_dir, "event_cache_dir");
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<CanonicalNfold<EngineType>>(
+        system, max_length, n_threads, event_cache_dir);
+    parser.value->event_selector_type = event_selector_type;
+  }
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef CASM_clexmonte_nfold_hybrid
+#define CASM_clexmonte_nfold_hybrid
+
+#include "casm/clexmonte/nfold/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Semi-grand canonical Monte Carlo, switching between Metropolis
+///     and the N-fold way by acceptance rate
+///
+/// The calculation begins with Metropolis steps. The acceptance rate is
+/// measured over windows of one pass (one attempt per site). If it drops
+/// below `nfold_acceptance_threshold`, the calculation switches to the
+/// N-fold way; if the N-fold way acceptance rate (the total rate divided
+/// by the number of possible events) rises above
+/// `metropolis_acceptance_threshold`, it switches back. Each mode lasts at
+/// least one pass.
+///
+/// Steps count Metropolis attempts in both modes: each N-fold step counts
+/// as the accepted attempt plus a number of rejected attempts sampled from
+/// the geometric distribution, and samples due during rejected attempts
+/// are taken, so sampling by count or pass is consistent across switches.
+///
+/// Time-based sampling is not supported. Metropolis steps have no time
+/// scale, and the N-fold residence times are not accumulated into a
+/// simulated time, so sampling and completion checks must use "step" or
+/// "pass", not "time". The constructor sets the inherited
+/// `time_sampling_allowed` to false, so that the run parameters parser
+/// rejects time-based sampling fixtures.
+///
+/// The N-fold event list (`event_data`) is constructed once per supercell
+/// and re-used by every switch and run. Rates are recalculated from scratch
+/// when switching to the N-fold way.
+template <typename EngineType>
+struct HybridNfold : public Nfold<EngineType> {
+  typedef EngineType engine_type;
+
+  explicit HybridNfold(std::shared_ptr<system_type> _system,
+                       int _n_threads = 1, std::string _event_cache_dir = "");
+
+  /// Switch from Metropolis to N-fold if the acceptance rate is less than
+  /// this
+  double nfold_acceptance_threshold = 0.05;
+
+  /// Switch from N-fold to Metropolis if the acceptance rate is greater
+  /// than this
+  double metropolis_acceptance_threshold = 0.2;
+
+  /// Number of switches in the last run
+  Index n_switches = 0;
+
+  /// Number of N-fold steps (accepted events) in the last run
+  Index n_nfold_steps = 0;
+
+  /// \brief Perform a single run, evolving current state
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<EngineType> &run_manager);
+};
+
+/// \brief Explicitly instantiated HybridNfold calculator
+typedef HybridNfold<std::mt19937_64> HybridNfold_mt19937_64;
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
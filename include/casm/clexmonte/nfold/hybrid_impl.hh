@@ -0,0 +1,253 @@
+#ifndef CASM_clexmonte_nfold_hybrid_impl
+#define CASM_clexmonte_nfold_hybrid_impl
+
+#include <cmath>
+#include <memory>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/nfold/hybrid.hh"
+#include "casm/clexmonte/nfold/nfold_impl.hh"
+#include "casm/clexmonte/nfold/run_nfold.hh"
+#include "casm/clexmonte/semigrand_canonical/event_generator.hh"
+#include "casm/monte/methods/metropolis.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+template <typename EngineType>
+HybridNfold<EngineType>::HybridNfold(std::shared_ptr<system_type> _system,
+                                     int _n_threads,
+                                     std::string _event_cache_dir)
+    : Nfold<EngineType>(_system, _n_threads, _event_cache_dir) {
+  // N-fold residence times and Metropolis attempts are counted as steps only
+  this->time_sampling_allowed = false;
+}
+
+/// \brief Perform a single run, evolving current state
+///
+/// Notes:
+/// - state and occ_location are evolved and end in modified states
+/// - Metropolis steps propose single-site semi-grand canonical swaps only,
+///   the same events as the N-fold way
+/// - Metropolis and the N-fold way sample the same distribution of
+///   attempts if every site has the same number of allowed swaps, so that
+///   proposals are uniform over the N-fold event list
+template <typename EngineType>
+void HybridNfold<EngineType>::run(state_type &state,
+                                  monte::OccLocation &occ_location,
+                                  run_manager_type<EngineType> &run_manager) {
+  if (!state.conditions.scalar_values.count("temperature")) {
+    throw std::runtime_error(
+        "Error in HybridNfold::run: state `temperature` not set.");
+  }
+  if (!state.conditions.vector_values.count("param_chem_pot")) {
+    throw std::runtime_error(
+        "Error in HybridNfold::run: state `param_chem_pot` conditions not "
+        "set.");
+  }
+  if (!(this->nfold_acceptance_threshold <
+        this->metropolis_acceptance_threshold)) {
+    throw std::runtime_error(
+        "Error in HybridNfold::run: nfold_acceptance_threshold must be less "
+        "than metropolis_acceptance_threshold.");
+  }
+
+  // Store state info / pointers
+  this->state = &state;
+  this->occ_location = &occ_location;
+  this->conditions =
+      std::make_shared<semigrand_canonical::SemiGrandCanonicalConditions>(
+          get_composition_converter(*this->system));
+  this->conditions->set_all(state.conditions, false);
+
+  // Make potential calculator
+  this->potential =
+      std::make_shared<semigrand_canonical::SemiGrandCanonicalPotential>(
+          this->system);
+  this->potential->set(this->state, this->conditions);
+  this->formation_energy = this->potential->formation_energy();
+
+  // Get swaps
+  std::vector<monte::OccSwap> const &semigrand_canonical_swaps =
+      get_semigrand_canonical_swaps(*this->system);
+
+  // if same supercell
+  // -> just re-set potential & avoid re-constructing event list
+  if (this->transformation_matrix_to_super ==
+          get_transformation_matrix_to_super(state) &&
+      this->event_data != nullptr) {
+    this->event_data->event_calculator->potential = this->potential;
+  } else {
+    this->transformation_matrix_to_super =
+        get_transformation_matrix_to_super(state);
+    Index n_unitcells = this->transformation_matrix_to_super.determinant();
+
+    // Event data
+    this->event_data = std::make_shared<NfoldEventData>(
+        this->system, state, occ_location, semigrand_canonical_swaps,
+        this->potential, this->n_threads, this->event_cache_dir);
+
+    // Nfold data
+    monte::Conversions const &convert =
+        get_index_conversions(*this->system, state);
+    Index n_allowed_per_unitcell =
+        get_n_allowed_per_unitcell(convert, semigrand_canonical_swaps);
+    this->nfold_data.n_events_possible =
+        static_cast<double>(n_unitcells) * n_allowed_per_unitcell;
+  }
+  double n_events_possible = this->nfold_data.n_events_possible;
+
+  // Event calculators for use by separate threads
+  // - Rates are recalculated in parallel at each switch if n_threads > 1
+  std::vector<std::shared_ptr<CompleteEventCalculator>>
+      thread_event_calculators =
+          make_thread_event_calculators<
+              semigrand_canonical::SemiGrandCanonicalPotential>(
+              this->system, this->state, this->conditions,
+              this->event_data->prim_event_list, this->event_data->event_list,
+              this->n_threads);
+
+  // Metropolis event generator, single swaps only
+  semigrand_canonical::SemiGrandCanonicalEventGenerator<EngineType>
+      event_generator(semigrand_canonical_swaps, {});
+  event_generator.set(&state, &occ_location);
+
+  // Used to apply N-fold events: EventIndex -> monte::OccEvent
+  // - The packed occupation is updated as each selected event is applied
+  std::shared_ptr<PackedOccupation> packed_occupation;
+  monte::OccEvent selected_event;
+  auto apply_nfold_event_f = [&](EventIndex selected_event_index) {
+    event_generator.apply(set_selected_event(
+        selected_event, *packed_occupation, selected_event_index,
+        this->event_data->event_list, this->event_data->prim_event_list,
+        occ_location));
+  };
+
+  // Run, with N-fold rate table of type `rate_table_type`
+  auto run_hybrid = [&](auto const *rate_table_tag) {
+    typedef std::remove_cv_t<std::remove_pointer_t<decltype(rate_table_tag)>>
+        rate_table_type;
+    typedef RejectionFreeEventSelector<CompleteEventCalculator,
+                                       CompressedEventImpactTable, EngineType,
+                                       rate_table_type>
+        selector_type;
+
+    monte::RandomNumberGenerator<EngineType> random_number_generator(
+        run_manager.engine);
+    double beta = this->conditions->beta;
+    Index steps_per_pass = occ_location.mol_size();
+
+    // Null in Metropolis mode; rates are calculated from the current state
+    // when constructed, on each switch to N-fold
+    std::unique_ptr<selector_type> event_selector;
+    auto make_event_selector = [&]() {
+      packed_occupation = set_packed_occupation(
+          *this->system, state, *this->event_data->event_calculator,
+          thread_event_calculators);
+      event_selector = std::make_unique<selector_type>(
+          this->event_data->event_calculator,
+          this->event_data->event_list.size(),
+          this->event_data->event_list.impact_table, run_manager.engine,
+          thread_event_calculators);
+    };
+
+    // Attempts and accepted attempts in the current mode window
+    Index n_window_attempts = 0;
+    Index n_window_accepts = 0;
+    this->n_switches = 0;
+    this->n_nfold_steps = 0;
+
+    run_manager.initialize(steps_per_pass);
+    run_manager.sample_data_by_count_if_due(state);
+    while (!run_manager.is_complete()) {
+      run_manager.write_status_if_due();
+
+      // --- Metropolis mode ---
+      if (!event_selector) {
+        monte::OccEvent const &event =
+            event_generator.propose(random_number_generator);
+        double delta_potential_energy =
+            this->potential->occ_delta_per_supercell(event.linear_site_index,
+                                                     event.new_occ);
+        bool accept = metropolis_acceptance(delta_potential_energy, beta,
+                                            random_number_generator);
+        if (accept) {
+          run_manager.increment_n_accept();
+          event_generator.apply(event);
+          ++n_window_accepts;
+        } else {
+          run_manager.increment_n_reject();
+        }
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(state);
+
+        if (++n_window_attempts >= steps_per_pass) {
+          double acceptance = double(n_window_accepts) / n_window_attempts;
+          n_window_attempts = 0;
+          n_window_accepts = 0;
+          if (acceptance < this->nfold_acceptance_threshold) {
+            make_event_selector();
+            ++this->n_switches;
+          }
+        }
+        continue;
+      }
+
+      // --- N-fold mode ---
+      // - Updates the rates impacted by the previous event, then selects
+      EventIndex event_index = event_selector->select_event().first;
+      double acceptance = event_selector->total_rate() / n_events_possible;
+      if (n_window_attempts >= steps_per_pass &&
+          acceptance > this->metropolis_acceptance_threshold) {
+        event_selector.reset();
+        n_window_attempts = 0;
+        n_window_accepts = 0;
+        ++this->n_switches;
+        continue;
+      }
+
+      // Rejected Metropolis attempts preceding the event: geometric
+      // distribution, with success probability `acceptance`
+      double n_rejected = 0.0;
+      if (acceptance < 1.0) {
+        double u = 1.0 - random_number_generator.random_real(1.0);
+        n_rejected = std::floor(std::log(u) / std::log1p(-acceptance));
+      }
+      for (double i = 0.0; i < n_rejected && !run_manager.is_complete();
+           i += 1.0) {
+        run_manager.increment_n_reject();
+        run_manager.increment_step();
+        run_manager.sample_data_by_count_if_due(state);
+        ++n_window_attempts;
+      }
+      if (run_manager.is_complete()) {
+        break;
+      }
+
+      // Accepted attempt
+      run_manager.increment_n_accept();
+      apply_nfold_event_f(event_index);
+      run_manager.increment_step();
+      run_manager.sample_data_by_count_if_due(state);
+      ++n_window_attempts;
+      ++n_window_accepts;
+      ++this->n_nfold_steps;
+    }
+    run_manager.finalize(state);
+  };
+  with_rate_table_type(this->event_selector_type, "HybridNfold::run",
+                       run_hybrid);
+
+  Log &log = CASM::log();
+  log.custom<Log::standard>("Hybrid Metropolis / N-fold summary");
+  log.indent() << "n_switches: " << this->n_switches << std::endl;
+  log.indent() << "n_nfold_steps: " << this->n_nfold_steps << std::endl;
+  log.indent() << std::endl;
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
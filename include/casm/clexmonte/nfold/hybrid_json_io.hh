@@ -0,0 +1,90 @@
+#ifndef CASM_clexmonte_nfold_hybrid_json_io
+#define CASM_clexmonte_nfold_hybrid_json_io
+
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/nfold/hybrid_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Parse HybridNfold "calculation_options"
+///
+/// Expected format:
+/// \code
+///   "nfold_acceptance_threshold": number (optional, default=0.05)
+///       Switch from Metropolis to the N-fold way if the Metropolis
+///       acceptance rate over a pass is less than this.
+///
+///   "metropolis_acceptance_threshold": number (optional, default=0.2)
+///       Switch from the N-fold way to Metropolis if the N-fold way
+///       acceptance rate (total rate / number of possible events) is greater
+///       than this. Must be greater than "nfold_acceptance_threshold".
+///
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to construct the event list and calculate
+///       event rates on each switch to the N-fold way. If < 1, the number of
+///       hardware threads is used. Results do not depend on the number of
+///       threads.
+///
+///   "event_selector_type": string (optional, default="sum_tree")
+///       How N-fold way event rates are stored and events are selected. One
+///       of "sum_tree", "composition_rejection", or "rate_class", as for
+///       Nfold.
+///
+///   "event_cache_dir": string (optional)
+///       If given, prim event impact information is cached in this
+///       directory, and re-used by later runs with the same prim, events,
+///       coefficients, and basis sets.
+/// \endcode
+template <typename EngineType>
+void parse(InputParser<HybridNfold<EngineType>> &parser,
+           std::shared_ptr<system_type> system,
+           std::shared_ptr<EngineType> random_number_engine =
+               std::shared_ptr<EngineType>()) {
+  // "nfold_acceptance_threshold", "metropolis_acceptance_threshold"
+  double nfold_acceptance_threshold = 0.05;
+  parser.optional(nfold_acceptance_threshold, "nfold_acceptance_threshold");
+  double metropolis_acceptance_threshold = 0.2;
+  parser.optional(metropolis_acceptance_threshold,
+                  "metropolis_acceptance_threshold");
+  if (!(nfold_acceptance_threshold < metropolis_acceptance_threshold)) {
+    parser.insert_error("metropolis_acceptance_threshold",
+                        "Must be greater than nfold_acceptance_threshold");
+  }
+
+  // "n_threads"
+  int n_threads = 1;
+  parser.optional(n_threads, "n_threads");
+
+  // "event_selector_type"
+  std::string event_selector_type = "sum_tree";
+  parser.optional(event_selector_type, "event_selector_type");
+  if (event_selector_type != "sum_tree" &&
+      event_selector_type != "composition_rejection" &&
+      event_selector_type != "rate_class") {
+    parser.insert_error("event_selector_type",
+                        "Must be \"sum_tree\", \"composition_rejection\", or "
+                        "\"rate_class\"");
+  }
+
+  // "event_cache_dir"
+  std::string event_cache_dir;
+  parser.optional(event_cache_dir, "event_cache_dir");
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<HybridNfold<EngineType>>(
+        system, n_threads, event_cache_dir);
+    parser.value->nfold_acceptance_threshold = nfold_acceptance_threshold;
+    parser.value->metropolis_acceptance_threshold =
+        metropolis_acceptance_threshold;
+    parser.value->event_selector_type = event_selector_type;
+  }
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
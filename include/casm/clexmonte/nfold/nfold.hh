@@ -17,11 +17,25 @@ template <typename EngineType>
 struct Nfold : public semigrand_canonical::SemiGrandCanonical<EngineType> {
   typedef EngineType engine_type;
 
-  explicit Nfold(std::shared_ptr<system_type> _system);
+  explicit Nfold(std::shared_ptr<system_type> _system, int _n_threads = 1,
+                 std::string _event_cache_dir = "");
 
   /// Method allows time-based sampling
   bool time_sampling_allowed = true;
 
+  /// Number of threads used to construct the event list and calculate
+  /// initial event rates. If < 1, the number of hardware threads is used.
+  int n_threads;
+
+  /// If not empty, directory used to cache prim event impact information
+  std::string event_cache_dir;
+
+  /// Event rate table: "sum_tree" (O(log N) selection and update),
+  /// "composition_rejection" (O(1) expected selection and update), or
+  /// "rate_class" (O(1) expected selection and update, with BKL-style rate
+  /// classes)
+  std::string event_selector_type = "sum_tree";
+
   /// Data for N-fold way implementation
   std::shared_ptr<NfoldEventData> event_data;
 
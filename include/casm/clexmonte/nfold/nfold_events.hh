@@ -1,12 +1,17 @@
 #ifndef CASM_clexmonte_nfold_events
 #define CASM_clexmonte_nfold_events
 
+#include <cmath>
 #include <random>
 
+#include "casm/clexmonte/canonical/canonical.hh"
 #include "casm/clexmonte/definitions.hh"
 #include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
 #include "casm/clexmonte/events/event_data.hh"
 #include "casm/clexmonte/semigrand_canonical/potential.hh"
+#include "casm/clexmonte/state/Conditions.hh"
+#include "casm/clexulator/ConfigDoFValues.hh"
 
 namespace CASM {
 namespace clexmonte {
@@ -19,43 +24,89 @@ struct EventState {
   double rate;      ///< Occurance rate
 };
 
-/// \brief CompleteEventCalculator is an event calculator with the required
-///     interface for the classes `lotto::RejectionFree` and `lotto::Rejection`.
+/// \brief BasicCompleteEventCalculator is an N-fold way event calculator,
+///     with the required interface for RejectionFreeEventSelector
 ///
 /// Notes:
+/// - Event rates are 1.0 if the change in potential energy, dE, is <= 0.0,
+///   else exp(-beta * dE)
 /// - Expected to be constructed as shared_ptr
 /// - Mostly holds references to external data structures
 /// - Stores one `EventState` which is used to perform the calculations
-struct CompleteEventCalculator {
+///
+/// \tparam PotentialType The potential, which gives the change in energy
+///     due to an event: semigrand_canonical::SemiGrandCanonicalPotential for
+///     the semi-grand canonical N-fold way, or canonical::CanonicalPotential
+///     for the canonical N-fold way.
+template <typename PotentialType>
+struct BasicCompleteEventCalculator {
+  typedef PotentialType potential_type;
+
   /// \brief Prim event list
   std::vector<PrimEventData> const &prim_event_list;
 
   /// \brief Complete event list
-  std::map<EventID, EventData> const &event_list;
+  CompleteEventList const &event_list;
 
   /// \brief Holds last calculated event state
   EventState event_state;
 
+  /// \brief Holds linear site indices of the event being calculated
+  std::vector<Index> linear_site_index;
+
   /// \brief Potential
-  std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential> potential;
+  std::shared_ptr<PotentialType> potential;
 
-  CompleteEventCalculator(
-      std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
-          _potential,
-      std::vector<PrimEventData> const &_prim_event_list,
-      std::map<EventID, EventData> const &_event_list);
+  /// \brief Optional packed copy of the occupation, used to check if events
+  ///     are allowed. If set, it must be kept up-to-date with the state.
+  std::shared_ptr<PackedOccupation const> packed_occupation;
+
+  /// \brief Packed initial occupation of each prim event, compared with
+  ///     `packed_occupation` - order must match prim_event_list
+  std::vector<PackedOccSignature> occ_init_signatures;
 
-  /// \brief Get CASM::monte::OccEvent corresponding to given event ID
-  double calculate_rate(EventID const &id);
+  BasicCompleteEventCalculator(
+      std::shared_ptr<PotentialType> _potential,
+      std::vector<PrimEventData> const &_prim_event_list,
+      CompleteEventList const &_event_list);
+
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventIndex event_index);
+
+  /// \brief Calculate the rate of an event
+  double calculate_rate(EventID const &id) {
+    return calculate_rate(event_list.event_index(id));
+  }
+
+  /// \brief Calculate the rates of a batch of events
+  void calculate_rates(EventIndexRange event_index_list,
+                       std::vector<double> &rates) {
+    rates.resize(event_index_list.size());
+    for (Index i = 0; i < event_index_list.size(); ++i) {
+      rates[i] = calculate_rate(event_index_list[i]);
+    }
+  }
 };
 
+/// \brief Event calculator for the semi-grand canonical N-fold way
+typedef BasicCompleteEventCalculator<
+    semigrand_canonical::SemiGrandCanonicalPotential>
+    CompleteEventCalculator;
+
+/// \brief Event calculator for the canonical N-fold way
+///
+/// Events are pairwise exchanges of occupants.
+typedef BasicCompleteEventCalculator<canonical::CanonicalPotential>
+    CanonicalCompleteEventCalculator;
+
 struct NfoldEventData {
   NfoldEventData(
       std::shared_ptr<system_type> system, state_type const &state,
       monte::OccLocation const &occ_location,
       std::vector<monte::OccSwap> const &semigrand_canonical_swaps,
       std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
-          potential);
+          potential,
+      int n_threads = 1, std::string const &event_cache_dir = "");
 
   /// The `prim events`, one translationally distinct instance
   /// of each event, associated with origin primitive cell
@@ -64,6 +115,9 @@ struct NfoldEventData {
   /// Information about what sites may impact each prim event
   std::vector<clexmonte::EventImpactInfo> prim_impact_info_list;
 
+  /// Events impacted by each prim event, relative to the origin unit cell
+  std::vector<std::vector<clexmonte::RelativeEventID>> relative_impact_table;
+
   /// All supercell events, and which events must be updated
   /// when one occurs
   clexmonte::CompleteEventList event_list;
@@ -72,6 +126,112 @@ struct NfoldEventData {
   std::shared_ptr<CompleteEventCalculator> event_calculator;
 };
 
+/// \brief Event data for the canonical N-fold way
+///
+/// Events are exchanges of the occupants of two sites, one for each
+/// canonical swap type and pair of sites no more than `max_length` apart.
+/// Symmetrically equivalent exchanges are grouped into event types named
+/// "exchange-<asym_a>-<species_a>-<asym_b>-<species_b>-<n>", where `n`
+/// distinguishes pair orbits of the same swap type.
+struct CanonicalNfoldEventData {
+  CanonicalNfoldEventData(
+      std::shared_ptr<system_type> system, state_type const &state,
+      monte::OccLocation const &occ_location,
+      std::vector<monte::OccSwap> const &canonical_swaps,
+      std::shared_ptr<canonical::CanonicalPotential> potential,
+      double max_length, int n_threads = 1,
+      std::string const &event_cache_dir = "");
+
+  /// The `prim events`, one translationally distinct instance
+  /// of each event, associated with origin primitive cell
+  std::vector<clexmonte::PrimEventData> prim_event_list;
+
+  /// Information about what sites may impact each prim event
+  std::vector<clexmonte::EventImpactInfo> prim_impact_info_list;
+
+  /// Events impacted by each prim event, relative to the origin unit cell
+  std::vector<std::vector<clexmonte::RelativeEventID>> relative_impact_table;
+
+  /// All supercell events, and which events must be updated
+  /// when one occurs
+  clexmonte::CompleteEventList event_list;
+
+  /// Calculator for event selection
+  std::shared_ptr<CanonicalCompleteEventCalculator> event_calculator;
+};
+
+// --- Implementation ---
+
+template <typename PotentialType>
+BasicCompleteEventCalculator<PotentialType>::BasicCompleteEventCalculator(
+    std::shared_ptr<PotentialType> _potential,
+    std::vector<PrimEventData> const &_prim_event_list,
+    CompleteEventList const &_event_list)
+    : prim_event_list(_prim_event_list),
+      event_list(_event_list),
+      potential(_potential) {
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    occ_init_signatures.emplace_back(prim_event_data.occ_init);
+  }
+}
+
+/// \brief Calculate the rate of an event
+template <typename PotentialType>
+double BasicCompleteEventCalculator<PotentialType>::calculate_rate(
+    EventIndex event_index) {
+  if (!event_list.is_included[event_index]) {
+    event_state.is_allowed = false;
+    event_state.rate = 0.0;
+    return event_state.rate;
+  }
+  Index prim_event_index = event_index % event_list.n_prim_events;
+  Index unitcell_index = event_index / event_list.n_prim_events;
+  event_list.site_table.set_linear_site_index(linear_site_index,
+                                              unitcell_index, prim_event_index);
+  PrimEventData const &prim_event_data = prim_event_list[prim_event_index];
+
+  /// ---
+
+  if (packed_occupation) {
+    if (!packed_occupation->matches(linear_site_index,
+                                    occ_init_signatures[prim_event_index])) {
+      event_state.is_allowed = false;
+      event_state.rate = 0.0;
+      return event_state.rate;
+    }
+  } else {
+    clexulator::ConfigDoFValues const *dof_values =
+        potential->formation_energy()->get();
+
+    int i = 0;
+    for (Index l : linear_site_index) {
+      if (dof_values->occupation(l) != prim_event_data.occ_init[i]) {
+        event_state.is_allowed = false;
+        event_state.rate = 0.0;
+        return event_state.rate;
+      }
+      ++i;
+    }
+  }
+  event_state.is_allowed = true;
+
+  // calculate change in energy to final state
+  event_state.dE_final = potential->occ_delta_per_supercell(
+      linear_site_index, prim_event_data.occ_final);
+
+  // calculate rate
+  if (event_state.dE_final <= 0.0) {
+    event_state.rate = 1.0;
+  } else {
+    event_state.rate =
+        exp(-potential->conditions()->beta * event_state.dE_final);
+  }
+
+  /// ---
+
+  return event_state.rate;
+}
+
 }  // namespace nfold
 }  // namespace clexmonte
 }  // namespace CASM
@@ -2,6 +2,7 @@
 #define CASM_clexmonte_nfold_impl
 
 #include "casm/clexmonte/nfold/nfold.hh"
+#include "casm/clexmonte/nfold/run_nfold.hh"
 #include "casm/clexmonte/semigrand_canonical/calculator_impl.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/clexmonte/system/System.hh"
@@ -12,8 +13,11 @@ namespace clexmonte {
 namespace nfold {
 
 template <typename EngineType>
-Nfold<EngineType>::Nfold(std::shared_ptr<system_type> _system)
-    : semigrand_canonical::SemiGrandCanonical<EngineType>(_system) {}
+Nfold<EngineType>::Nfold(std::shared_ptr<system_type> _system,
+                         int _n_threads, std::string _event_cache_dir)
+    : semigrand_canonical::SemiGrandCanonical<EngineType>(_system),
+      n_threads(_n_threads),
+      event_cache_dir(_event_cache_dir) {}
 
 /// \brief Perform a single run, evolving current state
 ///
@@ -65,7 +69,7 @@ void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
     // Event data
     this->event_data = std::make_shared<NfoldEventData>(
         this->system, state, occ_location, semigrand_canonical_swaps,
-        this->potential);
+        this->potential, this->n_threads, this->event_cache_dir);
 
     // Nfold data
     monte::Conversions const &convert =
@@ -76,23 +80,9 @@ void Nfold<EngineType>::run(state_type &state, monte::OccLocation &occ_location,
         static_cast<double>(n_unitcells) * n_allowed_per_unitcell;
   }
 
-  // Make selector
-  lotto::RejectionFreeEventSelector event_selector(
-      this->event_data->event_calculator,
-      clexmonte::make_complete_event_id_list(n_unitcells,
-                                             this->event_data->prim_event_list),
-      this->event_data->event_list.impact_table,
-      std::make_shared<lotto::RandomGenerator>(run_manager.engine));
-
-  // Used to apply selected events: EventID -> monte::OccEvent
-  auto get_event_f = [&](EventID const &selected_event_id) {
-    // returns a monte::OccEvent
-    return this->event_data->event_list.events.at(selected_event_id).event;
-  };
-
-  // Run nfold-way
-  monte::nfold<EventID>(state, occ_location, this->nfold_data, event_selector,
-                        get_event_f, run_manager);
+  run_nfold(this->system, state, occ_location, this->conditions,
+            *this->event_data, this->nfold_data, this->n_threads,
+            this->event_selector_type, "Nfold::run", run_manager);
 }
 
 }  // namespace nfold
@@ -9,13 +9,68 @@ namespace CASM {
 namespace clexmonte {
 namespace nfold {
 
+/// \brief Parse Nfold "calculation_options"
+///
+/// Expected format:
+/// \code
+///   "n_threads": int (optional, default=1)
+///       Number of threads used to construct the event list and calculate
+///       initial event rates at the beginning of each run. If < 1, the
+///       number of hardware threads is used. Results do not depend on the
+///       number of threads.
+///
+///   "event_selector_type": string (optional, default="sum_tree")
+///       How event rates are stored and events are
+///       selected. One of:
+///       - "sum_tree": A binary tree of partial sums, with O(log N)
+///         selection and update, for N events.
+///       - "composition_rejection": Events are grouped by rate, in factors
+///         of 2. A group is selected by linear search and then an event in
+///         the group by rejection, with O(1) expected selection and update.
+///         Faster for very large event lists.
+///       - "rate_class": Bortz-Kalos-Lebowitz style rate classes. Events are
+///         grouped by rate, in factors of 2^(1/4) (i.e. by quantized
+///         beta * dE). A class is selected by linear search, fastest first,
+///         and then an event in the class by rejection, with O(1) expected
+///         selection and update. Events with rate 1.0 (dE <= 0) are never
+///         rejected. Usually the fastest choice at low temperature.
+///       All select events with probability proportional to their rates,
+///       but they use random numbers differently, so trajectories differ.
+///
+///   "event_cache_dir": string (optional)
+///       If given, prim event impact information is cached in this
+///       directory, and re-used by later runs with the same prim, events,
+///       coefficients, and basis sets.
+/// \endcode
 template <typename EngineType>
 void parse(InputParser<Nfold<EngineType>> &parser,
            std::shared_ptr<system_type> system,
            std::shared_ptr<EngineType> random_number_engine =
                std::shared_ptr<EngineType>()) {
-  parser.value =
-      std::make_unique<Nfold<EngineType>>(system, random_number_engine);
+  // "n_threads"
+  int n_threads = 1;
+  parser.optional(n_threads, "n_threads");
+
+  // "event_selector_type"
+  std::string event_selector_type = "sum_tree";
+  parser.optional(event_selector_type, "event_selector_type");
+  if (event_selector_type != "sum_tree" &&
+      event_selector_type != "composition_rejection" &&
+      event_selector_type != "rate_class") {
+    parser.insert_error("event_selector_type",
+                        "Must be \"sum_tree\", \"composition_rejection\", or "
+                        "\"rate_class\"");
+  }
+
+  // "event_cache_dir"
+  std::string event_cache_dir;
+  parser.optional(event_cache_dir, "event_cache_dir");
+
+  if (parser.valid()) {
+    parser.value =
+        std::make_unique<Nfold<EngineType>>(system, n_threads, event_cache_dir);
+    parser.value->event_selector_type = event_selector_type;
+  }
 }
 
 }  // namespace nfold
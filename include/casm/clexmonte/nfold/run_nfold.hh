@@ -0,0 +1,185 @@
+#ifndef CASM_clexmonte_nfold_run_nfold
+#define CASM_clexmonte_nfold_run_nfold
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "casm/clexmonte/definitions.hh"
+#include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/CompositionRejectionTable.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
+#include "casm/clexmonte/events/RateClassTable.hh"
+#include "casm/clexmonte/events/RejectionFreeEventSelector.hh"
+#include "casm/clexmonte/events/SumTree.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/clexmonte/nfold/nfold_events.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/events/OccLocation.hh"
+#include "casm/monte/methods/nfold.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+/// \brief Call `f` with a null pointer to the rate table type named by
+///     `event_selector_type`
+///
+/// \param event_selector_type One of "sum_tree" (SumTree),
+///     "composition_rejection" (CompositionRejectionTable), or "rate_class"
+///     (RateClassTable)
+/// \param caller Name used in the error message if `event_selector_type` is
+///     not valid
+/// \param f Generic function, called as
+///     `f(static_cast<RateTableType const *>(nullptr))`
+template <typename F>
+void with_rate_table_type(std::string const &event_selector_type,
+                          std::string const &caller, F f) {
+  if (event_selector_type == "sum_tree") {
+    f(static_cast<SumTree const *>(nullptr));
+  } else if (event_selector_type == "composition_rejection") {
+    f(static_cast<CompositionRejectionTable const *>(nullptr));
+  } else if (event_selector_type == "rate_class") {
+    f(static_cast<RateClassTable const *>(nullptr));
+  } else {
+    throw std::runtime_error("Error in " + caller +
+                             ": invalid event_selector_type \"" +
+                             event_selector_type + "\"");
+  }
+}
+
+/// \brief Make N-fold way event calculators for use by separate threads
+///
+/// Each calculator has its own potential, with independent Clexulator, so
+/// that event rates may be calculated in parallel.
+///
+/// \returns One calculator per thread, or none if `n_threads` resolves to 1
+template <typename PotentialType, typename ConditionsType>
+std::vector<std::shared_ptr<BasicCompleteEventCalculator<PotentialType>>>
+make_thread_event_calculators(
+    std::shared_ptr<system_type> const &system, state_type const *state,
+    std::shared_ptr<ConditionsType> const &conditions,
+    std::vector<PrimEventData> const &prim_event_list,
+    CompleteEventList const &event_list, int n_threads) {
+  int _n_threads = resolve_n_threads(n_threads);
+  std::vector<std::shared_ptr<BasicCompleteEventCalculator<PotentialType>>>
+      thread_event_calculators;
+  for (int i = 0; _n_threads > 1 && i < _n_threads; ++i) {
+    auto thread_potential = std::make_shared<PotentialType>(system);
+    thread_potential->set(state, conditions, true /*independent_clex*/);
+    thread_event_calculators.push_back(
+        std::make_shared<BasicCompleteEventCalculator<PotentialType>>(
+            thread_potential, prim_event_list, event_list));
+  }
+  return thread_event_calculators;
+}
+
+/// \brief Make a packed copy of the occupation, and set it for event
+///     calculators, which use it to skip events that are not allowed
+///
+/// The packed occupation must be updated as events are applied, i.e. with
+/// `set_selected_event`.
+template <typename CalculatorType>
+std::shared_ptr<PackedOccupation> set_packed_occupation(
+    system_type const &system, state_type const &state,
+    CalculatorType &event_calculator,
+    std::vector<std::shared_ptr<CalculatorType>> const
+        &thread_event_calculators) {
+  auto packed_occupation = std::make_shared<PackedOccupation>(
+      get_occupation(state), max_n_occupants(*get_prim_basicstructure(system)));
+  event_calculator.packed_occupation = packed_occupation;
+  for (auto const &calculator : thread_event_calculators) {
+    calculator->packed_occupation = packed_occupation;
+  }
+  return packed_occupation;
+}
+
+/// \brief Set `selected_event` to the event with index `event_index`, and
+///     update `packed_occupation` to the occupation after the event
+inline monte::OccEvent const &set_selected_event(
+    monte::OccEvent &selected_event, PackedOccupation &packed_occupation,
+    EventIndex event_index, CompleteEventList const &event_list,
+    std::vector<PrimEventData> const &prim_event_list,
+    monte::OccLocation const &occ_location) {
+  set_event(selected_event, event_index, event_list, prim_event_list,
+            occ_location);
+  for (Index i = 0; i < selected_event.linear_site_index.size(); ++i) {
+    packed_occupation.set(selected_event.linear_site_index[i],
+                          selected_event.new_occ[i]);
+  }
+  return selected_event;
+}
+
+/// \brief Run the N-fold way, using RejectionFreeEventSelector
+///
+/// Used by Nfold and CanonicalNfold, after the event data is constructed.
+///
+/// Notes:
+/// - A packed copy of the occupation is made each run, because the state
+///   may have changed between runs
+/// - Initial event rates are calculated in parallel if n_threads > 1
+/// - Selected events are constructed as needed
+///
+/// \param system System data
+/// \param state The state, evolved by the run
+/// \param occ_location Occupant location tracker, initialized for `state`
+/// \param conditions Conditions, used by the thread event calculators
+/// \param event_data Event data, with `prim_event_list`, `event_list`, and
+///     `event_calculator`
+/// \param nfold_data N-fold way data
+/// \param n_threads Number of threads, as for `resolve_n_threads`
+/// \param event_selector_type Rate table type, as for `with_rate_table_type`
+/// \param caller Name used in error messages
+/// \param run_manager Contains random number engine, sampling fixtures, and
+///     after completion holds final results
+template <typename EventDataType, typename ConditionsType,
+          typename EngineType>
+void run_nfold(
+    std::shared_ptr<system_type> const &system, state_type &state,
+    monte::OccLocation &occ_location,
+    std::shared_ptr<ConditionsType> const &conditions,
+    EventDataType &event_data,
+    monte::NfoldData<config_type, statistics_type, EngineType> &nfold_data,
+    int n_threads, std::string const &event_selector_type,
+    std::string const &caller, run_manager_type<EngineType> &run_manager) {
+  typedef typename decltype(event_data.event_calculator)::element_type
+      calculator_type;
+  typedef typename calculator_type::potential_type potential_type;
+
+  std::vector<std::shared_ptr<calculator_type>> thread_event_calculators =
+      make_thread_event_calculators<potential_type>(
+          system, &state, conditions, event_data.prim_event_list,
+          event_data.event_list, n_threads);
+  std::shared_ptr<PackedOccupation> packed_occupation = set_packed_occupation(
+      *system, state, *event_data.event_calculator, thread_event_calculators);
+
+  monte::OccEvent selected_event;
+  auto get_event_f =
+      [&](EventIndex selected_event_index) -> monte::OccEvent const & {
+    return set_selected_event(selected_event, *packed_occupation,
+                              selected_event_index, event_data.event_list,
+                              event_data.prim_event_list, occ_location);
+  };
+
+  with_rate_table_type(
+      event_selector_type, caller, [&](auto const *rate_table_tag) {
+        typedef std::remove_cv_t<
+            std::remove_pointer_t<decltype(rate_table_tag)>>
+            rate_table_type;
+        RejectionFreeEventSelector<calculator_type, CompressedEventImpactTable,
+                                   EngineType, rate_table_type>
+            event_selector(event_data.event_calculator,
+                           event_data.event_list.size(),
+                           event_data.event_list.impact_table,
+                           run_manager.engine, thread_event_calculators);
+        monte::nfold<EventIndex>(state, occ_location, nfold_data,
+                                 event_selector, get_event_f, run_manager);
+      });
+}
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
+
+#endif
@@ -64,6 +64,9 @@ MethodParserMap<state_generator_type> standard_state_generator_methods(
 ///         run to be completed.
 /// }
 /// \endcode
+///
+/// If `time_sampling_allowed` is false, sampling fixtures which sample by
+/// time, or have a time cutoff, are an error.
 template <typename EngineType, typename ConditionsType>
 void parse(InputParser<RunParams<EngineType>> &parser,
            std::vector<fs::path> search_path,
@@ -107,7 +110,21 @@ void parse(InputParser<RunParams<EngineType>> &parser,
           continue;
         }
         if (subparser->valid()) {
-          sampling_fixture_params.push_back(*subparser->value);
+          sampling_fixture_params_type const &params = *subparser->value;
+          auto const &cutoff_params =
+              params.completion_check_params.cutoff_params;
+          if (!time_sampling_allowed &&
+              (params.sampling_params.sample_mode ==
+                   monte::SAMPLE_MODE::BY_TIME ||
+               cutoff_params.min_time.has_value() ||
+               cutoff_params.max_time.has_value())) {
+            parser.insert_error(
+                fs::path(key) / label,
+                "Error: this calculation method does not allow time-based "
+                "sampling or time cutoffs. Use \"step\" or \"pass\".");
+            continue;
+          }
+          sampling_fixture_params.push_back(params);
         }
       }
     } else if (is_required) {
@@ -43,6 +43,15 @@ struct SemiGrandCanonical {
   /// Method does not allow time-based sampling
   bool time_sampling_allowed = false;
 
+  /// If not empty, the number of domains along each supercell lattice
+  /// vector, for checkerboard-parallel Metropolis sweeps with single-site
+  /// swaps
+  std::vector<Index> checkerboard_n_domains;
+
+  /// Number of threads used for checkerboard-parallel Metropolis sweeps. If
+  /// < 1, the number of hardware threads is used.
+  int checkerboard_n_threads = 1;
+
   /// Current state
   state_type const *state;
 
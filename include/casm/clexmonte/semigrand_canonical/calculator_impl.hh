@@ -1,7 +1,10 @@
 #ifndef CASM_clexmonte_semigrand_canonical_impl
 #define CASM_clexmonte_semigrand_canonical_impl
 
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
 #include "casm/clexmonte/events/lotto.hh"
+#include "casm/clexmonte/methods/checkerboard_metropolis.hh"
 #include "casm/clexmonte/methods/occupation_metropolis.hh"
 #include "casm/clexmonte/run/analysis_functions.hh"
 #include "casm/clexmonte/run/functions.hh"
@@ -40,6 +43,9 @@ SemiGrandCanonical<EngineType>::SemiGrandCanonical(
 ///
 /// Notes:
 /// - state and occ_location are evolved and end in modified states
+/// - If `checkerboard_n_domains` is not empty, sweeps are
+///   checkerboard-parallel and use single-site swaps only (multi-swaps are
+///   not proposed)
 template <typename EngineType>
 void SemiGrandCanonical<EngineType>::run(
     state_type &state, monte::OccLocation &occ_location,
@@ -58,6 +64,83 @@ void SemiGrandCanonical<EngineType>::run(
   this->potential->set(this->state, this->conditions);
   this->formation_energy = this->potential->formation_energy();
 
+  // Checkerboard-parallel Metropolis, with single-site swaps
+  if (!this->checkerboard_n_domains.empty()) {
+    monte::Conversions const &convert = occ_location.convert();
+    xtal::BasicStructure const &prim = *get_prim_basicstructure(*this->system);
+    Index n_sublat = prim.basis().size();
+
+    // Sites that interact with a site in the origin unit cell, via the
+    // formation energy, as translations of a single "prim event"
+    ClexData const &clex_data =
+        get_clex_data(*this->system, "formation_energy");
+    if (!clex_data.cluster_info) {
+      throw std::runtime_error(
+          "Error in SemiGrandCanonical::run: checkerboard sweeps require "
+          "'formation_energy' cluster_info");
+    }
+    std::set<xtal::UnitCellCoord> neighborhood;
+    for (Index b = 0; b < n_sublat; ++b) {
+      clust::IntegralCluster phenom({xtal::UnitCellCoord(b, 0, 0, 0)});
+      neighborhood.insert(phenom.elements().begin(), phenom.elements().end());
+      expand(phenom, neighborhood, *clex_data.cluster_info,
+             clex_data.coefficients);
+    }
+    std::set<RelativeEventID> relative_impact;
+    for (xtal::UnitCellCoord const &site : neighborhood) {
+      relative_impact.insert(RelativeEventID{0, site.unitcell()});
+    }
+    std::vector<std::vector<RelativeEventID>> relative_impact_table = {
+        std::vector<RelativeEventID>(relative_impact.begin(),
+                                     relative_impact.end())};
+
+    std::vector<Index> const &n_domains = this->checkerboard_n_domains;
+    DomainDecomposition domain_decomposition(
+        this->transformation_matrix_to_super,
+        convert.unitcell_index_converter(),
+        Eigen::Vector3l(n_domains[0], n_domains[1], n_domains[2]),
+        relative_impact_table);
+
+    // Allowed new occupation values, by sublattice and current occupation
+    std::vector<std::vector<std::vector<int>>> allowed_new_occ(
+        n_sublat, std::vector<std::vector<int>>(max_n_occupants(prim)));
+    for (monte::OccSwap const &swap :
+         get_semigrand_canonical_swaps(*this->system)) {
+      int occ_a =
+          convert.occ_index(swap.cand_a.asym, swap.cand_a.species_index);
+      int occ_b =
+          convert.occ_index(swap.cand_b.asym, swap.cand_b.species_index);
+      for (Index b : convert.asym_to_b(swap.cand_a.asym)) {
+        allowed_new_occ[b][occ_a].push_back(occ_b);
+      }
+    }
+
+    // Potential calculators for use by separate threads
+    int _n_threads = resolve_n_threads(this->checkerboard_n_threads);
+    std::vector<std::function<double(std::vector<Index> const &,
+                                     std::vector<int> const &)>>
+        thread_potential_occ_delta_per_supercell_f;
+    for (int i = 0; i < _n_threads; ++i) {
+      auto thread_potential =
+          std::make_shared<SemiGrandCanonicalPotential>(this->system);
+      thread_potential->set(this->state, this->conditions,
+                            true /*independent_clex*/);
+      thread_potential_occ_delta_per_supercell_f.push_back(
+          [=](std::vector<Index> const &linear_site_index,
+              std::vector<int> const &new_occ) {
+            return thread_potential->occ_delta_per_supercell(
+                linear_site_index, new_occ);
+          });
+    }
+    ThreadPool thread_pool(_n_threads);
+
+    clexmonte::checkerboard_occupation_metropolis(
+        state, occ_location, this->conditions->temperature,
+        thread_potential_occ_delta_per_supercell_f, domain_decomposition,
+        allowed_new_occ, thread_pool, run_manager);
+    return;
+  }
+
   auto potential_occ_delta_per_supercell_f = [=](monte::OccEvent const &event) {
     return this->potential->occ_delta_per_supercell(event.linear_site_index,
                                                     event.new_occ);
@@ -1,6 +1,8 @@
 #ifndef CASM_clexmonte_semigrand_canonical_json_io
 #define CASM_clexmonte_semigrand_canonical_json_io
 
+#include <algorithm>
+
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/semigrand_canonical/calculator.hh"
@@ -11,12 +13,62 @@ namespace CASM {
 namespace clexmonte {
 namespace semigrand_canonical {
 
+/// \brief Parse SemiGrandCanonical "calculation_options"
+///
+/// \tparam EngineType
+/// \param parser
+/// \param system
+/// \param random_number_engine (Unused)
+///
+/// Expected format:
+/// \code
+///   "checkerboard": object (optional)
+///       If given, Metropolis sweeps are run in parallel within the
+///       supercell. The supercell is split into domains, and each domain
+///       into up to 8 sectors, which must be at least as wide as the range
+///       of the formation energy cluster expansion. In each sub-sweep, a
+///       sector is chosen at random and every domain makes Metropolis
+///       attempts in that sector, in parallel, each with its own random
+///       number engine. Sites in the same sector of different domains do not
+///       interact, so this obeys detailed balance. Only single-site swaps
+///       are proposed. Results do not depend on the number of threads.
+///       Format:
+///
+///     "n_domains": array of int
+///         Number of domains along each supercell lattice vector, i.e.
+///         [4, 4, 2]. Use more domains than threads for load balancing.
+///     "n_threads": int (optional, default=1)
+///         Number of threads. If < 1, the number of hardware threads is
+///         used.
+///
+/// \endcode
+///
 template <typename EngineType>
 void parse(InputParser<SemiGrandCanonical<EngineType>> &parser,
            std::shared_ptr<system_type> system,
            std::shared_ptr<EngineType> random_number_engine =
                std::shared_ptr<EngineType>()) {
-  parser.value = std::make_unique<SemiGrandCanonical<EngineType>>(system);
+  // "checkerboard"
+  std::vector<Index> checkerboard_n_domains;
+  int checkerboard_n_threads = 1;
+  if (parser.self.contains("checkerboard")) {
+    fs::path base("checkerboard");
+    parser.require(checkerboard_n_domains, base / "n_domains");
+    parser.optional(checkerboard_n_threads, base / "n_threads");
+    if (checkerboard_n_domains.size() != 3 ||
+        std::any_of(checkerboard_n_domains.begin(),
+                    checkerboard_n_domains.end(),
+                    [](Index n) { return n < 1; })) {
+      parser.insert_error(base / "n_domains",
+                          "Must be an array of 3 int, each >= 1");
+    }
+  }
+
+  if (parser.valid()) {
+    parser.value = std::make_unique<SemiGrandCanonical<EngineType>>(system);
+    parser.value->checkerboard_n_domains = checkerboard_n_domains;
+    parser.value->checkerboard_n_threads = checkerboard_n_threads;
+  }
 }
 
 inline void parse(InputParser<SemiGrandCanonicalConditions> &parser,
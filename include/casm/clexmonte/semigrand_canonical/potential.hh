@@ -21,7 +21,8 @@ class SemiGrandCanonicalPotential {
 
   /// \brief Reset pointer to state currently being calculated
   void set(state_type const *state,
-           std::shared_ptr<SemiGrandCanonicalConditions> conditions);
+           std::shared_ptr<SemiGrandCanonicalConditions> conditions,
+           bool independent_clex = false);
 
   /// \brief Pointer to current state
   state_type const *state() const;
@@ -436,6 +436,17 @@ std::shared_ptr<clexulator::LocalClusterExpansion> get_local_clex(
 std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
     System &system, state_type const &state, std::string const &key);
 
+/// \brief Construct a new clexulator::ClusterExpansion, with an independent
+///     copy of the Clexulator, for a particular state's supercell
+std::shared_ptr<clexulator::ClusterExpansion> make_clex(System &system,
+                                                        state_type const &state,
+                                                        std::string const &key);
+
+/// \brief Construct a new clexulator::LocalCorrelations, with independent
+///     copies of the local Clexulator, for a particular state's supercell
+std::shared_ptr<clexulator::LocalCorrelations> make_local_corr(
+    System &system, state_type const &state, std::string const &key);
+
 /// \brief Helper to get the supercell neighbor list for a
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::SuperNeighborList> get_supercell_neighbor_list(
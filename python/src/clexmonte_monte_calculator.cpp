@@ -33,6 +33,10 @@ CASM::clexmonte::BaseMonteCalculator *make_SemiGrandCanonicalCalculator();
 /// \brief Returns a clexmonte::BaseMonteCalculator* owning a
 /// CanonicalCalculator
 CASM::clexmonte::BaseMonteCalculator *make_CanonicalCalculator();
+
+/// \brief Returns a clexmonte::BaseMonteCalculator* owning a
+/// ParallelTemperingCalculator
+CASM::clexmonte::BaseMonteCalculator *make_ParallelTemperingCalculator();
 }
 
 /// CASM - Python binding code
@@ -86,6 +90,17 @@ std::shared_ptr<clexmonte::MonteCalculator> make_shared_CanonicalCalculator(
       lib);
 }
 
+std::shared_ptr<clexmonte::MonteCalculator>
+make_shared_ParallelTemperingCalculator(jsonParser const &params,
+                                        std::shared_ptr<system_type> system) {
+  std::shared_ptr<RuntimeLibrary> lib = nullptr;
+  return clexmonte::make_monte_calculator(
+      params, system,
+      std::unique_ptr<clexmonte::BaseMonteCalculator>(
+          make_ParallelTemperingCalculator()),
+      lib);
+}
+
 std::shared_ptr<clexmonte::StateData> make_state_data(
     std::shared_ptr<system_type> system, state_type &state,
     monte::OccLocation *occ_location) {
@@ -105,6 +120,8 @@ std::shared_ptr<clexmonte::MonteCalculator> make_monte_calculator(
     return make_shared_SemiGrandCanonicalCalculator(_params, system);
   } else if (method == "canonical") {
     return make_shared_CanonicalCalculator(_params, system);
+  } else if (method == "parallel_tempering") {
+    return make_shared_ParallelTemperingCalculator(_params, system);
   } else {
     std::stringstream msg;
     msg << "Error in make_monte_calculator: method='" << method
@@ -164,6 +181,23 @@ std::shared_ptr<run_manager_type> monte_calculator_run(
   return run_manager;
 }
 
+std::vector<state_type> monte_calculator_run_multistate(
+    calculator_type &self, std::vector<state_type> states,
+    std::vector<std::shared_ptr<run_manager_type>> run_managers) {
+  // Make an OccLocation for each state
+  std::vector<monte::OccLocation> occ_locations;
+  for (state_type const &state : states) {
+    monte::OccLocation *occ_location = nullptr;
+    std::unique_ptr<monte::OccLocation> tmp;
+    make_temporary_if_necessary(state, occ_location, tmp, self);
+    occ_locations.push_back(std::move(*tmp));
+  }
+
+  // run
+  self.run(states, occ_locations, run_managers);
+  return states;
+}
+
 std::shared_ptr<sampling_fixture_type> monte_calculator_run_fixture(
     calculator_type &self, state_type &state,
     sampling_fixture_params_type &sampling_fixture_params,
@@ -482,6 +516,9 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
               - "canonical": `Canonical ensemble <todo>`_.
                 Input states require `"temperature"` and one of
                 `"param_composition"` or `"mol_composition"` conditions.
+              - "parallel_tempering": Semi-grand canonical replica exchange.
+                Input states require `"temperature"` and `"param_chem_pot"`
+                conditions. Use :func:`MonteCalculator.run_multistate`.
               - TODO "lte": `Low-temperature expansion <todo>`_, for the
                 semi-grand canonical ensemble
               - TODO "kinetic": `Kinetic Monte Carlo <todo>`_
@@ -687,6 +724,30 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           )pbdoc",
            py::arg("state"), py::arg("run_manager"),
            py::arg("occ_location") = static_cast<monte::OccLocation *>(nullptr))
+      .def("run_multistate", &monte_calculator_run_multistate,
+           R"pbdoc(
+          Perform a single run, evolving multiple states
+
+          Only supported by multi-state methods, such as
+          "parallel_tempering". Each state is sampled by the corresponding
+          run manager.
+
+          Parameters
+          ----------
+          states : list[libcasm.clexmonte.MonteCarloState]
+              The input states, which must be in the same supercell.
+          run_managers: list[libcasm.clexmonte.RunManager]
+              Specifies sampling and convergence criteria and collects
+              results, for each state. Each should have its own sampling
+              fixture output directories.
+
+          Returns
+          -------
+          states: list[libcasm.clexmonte.MonteCarloState]
+              The final states. The input `run_managers` hold the collected
+              results.
+          )pbdoc",
+           py::arg("states"), py::arg("run_managers"))
       .def("run_fixture", &monte_calculator_run_fixture,
            R"pbdoc(
           Perform a single run, evolving the input state
@@ -751,6 +812,17 @@ PYBIND11_MODULE(_clexmonte_monte_calculator, m) {
           )pbdoc")
       .def_property_readonly("potential", &calculator_type::potential, R"pbdoc(
           MontePotential : The potential calculator for the current state.
+          )pbdoc")
+      .def_property_readonly(
+          "run_info",
+          [](calculator_type const &self) {
+            return static_cast<nlohmann::json>(self.run_info());
+          },
+          R"pbdoc(
+          dict : Method-specific information about the last run. For \
+          "parallel_tempering", "n_exchange_attempts" and \
+          "n_exchange_accepts" list the number of attempted and accepted \
+          exchanges between replicas `i` and `i+1`. Empty if none.
           )pbdoc");
 
   m.def("make_custom_monte_calculator", &make_custom_monte_calculator, R"pbdoc(
@@ -0,0 +1,265 @@
+import copy
+import json
+
+import pytest
+
+import libcasm.clexmonte as clexmonte
+import libcasm.monte as monte
+
+
+def test_run_multistate_1(Clex_ZrO_Occ_System, tmp_path):
+    """A single parallel tempering run, with one RunManager per replica"""
+    system = Clex_ZrO_Occ_System
+
+    # construct a parallel tempering MonteCalculator
+    calculator = clexmonte.MonteCalculator(
+        method="parallel_tempering",
+        system=system,
+        params={"swap_interval": 1, "n_threads": 2},
+    )
+
+    # construct the initial state (default configuration)
+    initial_state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [-1.0],
+        },
+        min_volume=1000,
+    )
+
+    # construct replicas, each with a RunManager
+    temperature_list = [300.0, 400.0, 500.0, 600.0]
+    states = []
+    run_managers = []
+    summary_files = []
+    for i, temperature in enumerate(temperature_list):
+        state = copy.deepcopy(initial_state)
+        state.conditions.scalar_values["temperature"] = temperature
+        states.append(state)
+
+        output_dir = tmp_path / f"output.{i}"
+        summary_files.append(output_dir / "summary.json")
+        thermo = calculator.make_default_sampling_fixture_params(
+            label="thermo",
+            output_dir=str(output_dir),
+        )
+        run_managers.append(
+            clexmonte.RunManager(
+                engine=monte.RandomNumberEngine(),
+                sampling_fixture_params=[thermo],
+                global_cutoff=True,
+            )
+        )
+
+    # Run
+    final_states = calculator.run_multistate(
+        states=states,
+        run_managers=run_managers,
+    )
+    assert len(final_states) == len(temperature_list)
+    for i, temperature in enumerate(temperature_list):
+        assert isinstance(final_states[i], clexmonte.MonteCarloState)
+        assert final_states[i].conditions.scalar_values["temperature"] == temperature
+        pytest.helpers.validate_summary_file(
+            summary_file=summary_files[i], expected_size=1
+        )
+
+
+def test_run_multistate_exchange_counts(Clex_ZrO_Occ_System, tmp_path):
+    """Exchanges are attempted each block until the replicas are finalized"""
+    system = Clex_ZrO_Occ_System
+
+    calculator = clexmonte.MonteCalculator(
+        method="parallel_tempering",
+        system=system,
+        params={"swap_interval": 1},
+    )
+
+    initial_state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [-1.0],
+        },
+        min_volume=1000,
+    )
+
+    # each replica completes after a fixed number of passes (= blocks)
+    max_count = 20
+    temperature_list = [300.0, 400.0, 500.0, 600.0]
+    states = []
+    run_managers = []
+    for i, temperature in enumerate(temperature_list):
+        state = copy.deepcopy(initial_state)
+        state.conditions.scalar_values["temperature"] = temperature
+        states.append(state)
+
+        thermo = calculator.make_default_sampling_fixture_params(
+            label="thermo",
+            output_dir=str(tmp_path / f"output.{i}"),
+        )
+        thermo.completion_check_params.cutoff_params.max_count = max_count
+        run_managers.append(
+            clexmonte.RunManager(
+                engine=monte.RandomNumberEngine(),
+                sampling_fixture_params=[thermo],
+                global_cutoff=True,
+            )
+        )
+
+    calculator.run_multistate(
+        states=states,
+        run_managers=run_managers,
+    )
+
+    # exchanges alternate between even pairs (0-1, 2-3) and the odd pair
+    # (1-2), after blocks 0, ..., max_count - 2; none are attempted after the
+    # final block, in which all replicas are finalized
+    n_attempts = calculator.run_info["n_exchange_attempts"]
+    n_accepts = calculator.run_info["n_exchange_accepts"]
+    assert len(n_attempts) == len(temperature_list) - 1
+    assert len(n_accepts) == len(temperature_list) - 1
+    assert n_attempts == [10, 9, 10]
+    for i in range(len(n_attempts)):
+        assert 0 <= n_accepts[i] <= n_attempts[i]
+
+
+def test_run_multistate_thermodynamics(Clex_ZrO_Occ_System, tmp_path):
+    """Replica averages agree with a single-temperature semi-grand canonical
+    run at the same conditions"""
+    system = Clex_ZrO_Occ_System
+    temperature = 1000.0
+    param_chem_pot = [-1.0]
+    n_passes = 2000
+
+    def make_thermo(calculator, output_dir):
+        thermo = calculator.make_default_sampling_fixture_params(
+            label="thermo",
+            output_dir=str(output_dir),
+        )
+        # run a fixed number of passes; the requested precision is not
+        # reached, but is needed to calculate the precision
+        thermo.completion_check_params.cutoff_params.min_count = n_passes
+        thermo.completion_check_params.cutoff_params.max_count = n_passes
+        thermo.converge(quantity="potential_energy", abs=1e-8)
+        thermo.converge(quantity="param_composition", abs=1e-8)
+        return thermo
+
+    def read_summary(output_dir):
+        with open(output_dir / "summary.json", "r") as f:
+            return json.load(f)
+
+    def expect_same_mean(stats_1, stats_2, min_tol):
+        tol = 2.0 * (
+            stats_1["calculated_precision"][0] + stats_2["calculated_precision"][0]
+        )
+        assert stats_1["mean"][0] == pytest.approx(
+            stats_2["mean"][0], abs=max(tol, min_tol)
+        )
+
+    # single-temperature semi-grand canonical run
+    sgc_calculator = clexmonte.MonteCalculator(
+        method="semigrand_canonical",
+        system=system,
+    )
+    sgc_output_dir = tmp_path / "output.sgc"
+    state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=sgc_calculator,
+        conditions={
+            "temperature": temperature,
+            "param_chem_pot": param_chem_pot,
+        },
+        min_volume=216,
+    )
+    sgc_calculator.run_fixture(
+        state=state,
+        sampling_fixture_params=make_thermo(sgc_calculator, sgc_output_dir),
+    )
+    sgc_summary = read_summary(sgc_output_dir)
+
+    # parallel tempering run, with the same conditions for the middle replica
+    calculator = clexmonte.MonteCalculator(
+        method="parallel_tempering",
+        system=system,
+        params={"swap_interval": 1, "n_threads": 2},
+    )
+    initial_state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": temperature,
+            "param_chem_pot": param_chem_pot,
+        },
+        min_volume=216,
+    )
+    temperature_list = [900.0, temperature, 1100.0]
+    states = []
+    run_managers = []
+    output_dirs = []
+    for i, replica_temperature in enumerate(temperature_list):
+        state = copy.deepcopy(initial_state)
+        state.conditions.scalar_values["temperature"] = replica_temperature
+        states.append(state)
+
+        output_dir = tmp_path / f"output.{i}"
+        output_dirs.append(output_dir)
+        run_managers.append(
+            clexmonte.RunManager(
+                engine=monte.RandomNumberEngine(),
+                sampling_fixture_params=[make_thermo(calculator, output_dir)],
+                global_cutoff=True,
+            )
+        )
+    calculator.run_multistate(
+        states=states,
+        run_managers=run_managers,
+    )
+    assert sum(calculator.run_info["n_exchange_accepts"]) > 0
+
+    # each replica stops at the step it completes, and is sampled once per pass
+    sgc_results = sgc_summary["completion_check_results"]
+    for output_dir in output_dirs:
+        results = read_summary(output_dir)["completion_check_results"]
+        assert results["count"][0] == n_passes
+        assert results["N_samples"][0] == sgc_results["N_samples"][0]
+
+    # same equilibrium averages as the single-temperature run
+    pt_summary = read_summary(output_dirs[1])
+    expect_same_mean(
+        pt_summary["statistics"]["potential_energy"]["value"],
+        sgc_summary["statistics"]["potential_energy"]["value"],
+        min_tol=0.002,
+    )
+    expect_same_mean(
+        pt_summary["statistics"]["param_composition"]["a"],
+        sgc_summary["statistics"]["param_composition"]["a"],
+        min_tol=0.005,
+    )
+
+
+def test_run_single_state_error(Clex_ZrO_Occ_System, tmp_path):
+    """Parallel tempering requires multi-state runs"""
+    system = Clex_ZrO_Occ_System
+
+    calculator = clexmonte.MonteCalculator(
+        method="parallel_tempering",
+        system=system,
+    )
+    thermo = calculator.make_default_sampling_fixture_params(
+        label="thermo",
+        output_dir=str(tmp_path / "output"),
+    )
+
+    state, motif, motif_id = clexmonte.make_initial_state(
+        calculator=calculator,
+        conditions={
+            "temperature": 300.0,
+            "param_chem_pot": [-1.0],
+        },
+        min_volume=1000,
+    )
+    with pytest.raises(Exception):
+        calculator.run_fixture(
+            state=state,
+            sampling_fixture_params=thermo,
+        )
@@ -19,15 +19,25 @@ CanonicalPotential::CanonicalPotential(std::shared_ptr<system_type> _system)
 /// - If state supercell is modified this must be called again
 /// - State DoF values can be modified without calling this again
 /// - State conditions can be modified without calling this again
+/// - If `independent_clex` is true, the formation energy calculator has its
+///   own copy of the Clexulator, so that this potential can be used by a
+///   different thread than other calculators for the same supercell
 void CanonicalPotential::set(state_type const *state,
-                             std::shared_ptr<Conditions> conditions) {
+                             std::shared_ptr<Conditions> conditions,
+                             bool independent_clex) {
   // supercell-specific
   m_state = state;
   if (m_state == nullptr) {
     throw std::runtime_error(
         "Error setting CanonicalPotential state: state is empty");
   }
-  m_formation_energy_clex = get_clex(*m_system, *m_state, "formation_energy");
+  if (independent_clex) {
+    m_formation_energy_clex =
+        make_clex(*m_system, *m_state, "formation_energy");
+  } else {
+    m_formation_energy_clex =
+        get_clex(*m_system, *m_state, "formation_energy");
+  }
 
   // conditions-specific
   m_conditions = conditions;
@@ -0,0 +1,201 @@
+#include "casm/clexmonte/events/ActiveEventList.hh"
+
+#include <map>
+#include <stdexcept>
+
+#include "casm/crystallography/BasicStructure.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param prim_event_list The prim event list
+/// \param event_list The complete event list. A reference is held and it
+///     must remain valid for the lifetime of the ActiveEventList.
+/// \param unitcell_converter Convert unit cell indices, for the supercell of
+///     `event_list`
+/// \param is_defect Specifies defect occupants, as
+///     `is_defect[sublattice_index][occupant_index]`. See `make_is_defect`.
+///
+/// The ActiveEventList is empty until `initialize` is called.
+ActiveEventList::ActiveEventList(
+    std::vector<PrimEventData> const &prim_event_list,
+    CompleteEventList const &event_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter,
+    std::vector<std::vector<bool>> const &is_defect)
+    : m_prim_event_list(prim_event_list),
+      m_event_list(event_list),
+      m_is_defect(is_defect),
+      m_anchors(is_defect.size()) {
+  // collect distinct translations, in order of first appearance
+  std::map<xtal::UnitCell, Index> translation_index;
+  std::vector<xtal::UnitCell> translations;
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    bool has_anchor = false;
+    for (Index i = 0; i < prim_event_data.sites.size(); ++i) {
+      xtal::UnitCellCoord const &site = prim_event_data.sites[i];
+      Index b = site.sublattice();
+      if (b >= m_is_defect.size() ||
+          prim_event_data.occ_init[i] >= m_is_defect[b].size()) {
+        throw std::runtime_error(
+            "Error constructing ActiveEventList: is_defect size mismatch");
+      }
+      if (!m_is_defect[b][prim_event_data.occ_init[i]]) {
+        continue;
+      }
+      // event in unit cell `u` has site `i` in unit cell `u + t_i`, so
+      // a defect in unit cell `d` anchors the event in unit cell `d - t_i`
+      xtal::UnitCell translation = -site.unitcell();
+      auto result = translation_index.emplace(translation, translations.size());
+      if (result.second) {
+        translations.push_back(translation);
+      }
+      m_anchors[b].push_back(
+          {prim_event_data.prim_event_index, result.first->second});
+      has_anchor = true;
+    }
+    if (!has_anchor) {
+      throw std::runtime_error(
+          "Error constructing ActiveEventList: event of type '" +
+          prim_event_data.event_type_name +
+          "' has no site with a defect as the initial occupant");
+    }
+  }
+  m_n_translations = translations.size();
+
+  Index n_unitcells = unitcell_converter.total_sites();
+  m_anchored_unitcell.resize(n_unitcells * m_n_translations);
+  auto it = m_anchored_unitcell.begin();
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+    for (xtal::UnitCell const &translation : translations) {
+      *it++ = unitcell_converter(unitcell + translation);
+    }
+  }
+}
+
+/// \brief Set the active events, given the current occupation
+///
+/// \param occupation The current occupation, by linear site index
+///
+/// After this, `added()` lists all active events, in order of increasing
+/// anchor linear site index.
+void ActiveEventList::initialize(Eigen::VectorXi const &occupation) {
+  m_anchor_count.clear();
+  m_added.clear();
+  m_removed.clear();
+  Index n_unitcells = m_event_list.n_unitcells;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    Index b = l / n_unitcells;
+    if (m_is_defect[b][occupation(l)]) {
+      _add_anchors(l);
+    }
+  }
+}
+
+/// \brief Update the active events after an event occurs
+///
+/// \param event_index The event which occurred
+///
+/// Defects moved by the event are determined from the event's initial and
+/// final occupation, so the occupation does not need to be checked. After
+/// this, `removed()` and `added()` list the events which became inactive and
+/// active, respectively.
+void ActiveEventList::update(EventIndex event_index) {
+  m_added.clear();
+  m_removed.clear();
+  Index prim_event_index = event_index % m_event_list.n_prim_events;
+  Index unitcell_index = event_index / m_event_list.n_prim_events;
+  PrimEventData const &prim_event_data = m_prim_event_list[prim_event_index];
+  m_event_list.site_table.set_linear_site_index(
+      m_linear_site_index, unitcell_index, prim_event_index);
+
+  Index n_sites = prim_event_data.sites.size();
+  for (Index i = 0; i < n_sites; ++i) {
+    Index b = prim_event_data.sites[i].sublattice();
+    if (m_is_defect[b][prim_event_data.occ_init[i]]) {
+      _remove_anchors(m_linear_site_index[i]);
+    }
+  }
+  for (Index i = 0; i < n_sites; ++i) {
+    Index b = prim_event_data.sites[i].sublattice();
+    if (m_is_defect[b][prim_event_data.occ_final[i]]) {
+      _add_anchors(m_linear_site_index[i]);
+    }
+  }
+}
+
+void ActiveEventList::_add_anchors(Index linear_site_index) {
+  Index n_unitcells = m_event_list.n_unitcells;
+  Index n_prim_events = m_event_list.n_prim_events;
+  Index b = linear_site_index / n_unitcells;
+  Index const *anchored_unitcell =
+      m_anchored_unitcell.data() +
+      (linear_site_index % n_unitcells) * m_n_translations;
+  for (Anchor const &anchor : m_anchors[b]) {
+    EventIndex event_index = static_cast<EventIndex>(
+        anchored_unitcell[anchor.translation_index] * n_prim_events +
+        anchor.prim_event_index);
+    if (!m_event_list.is_included[event_index]) {
+      continue;
+    }
+    int &count = m_anchor_count[event_index];
+    if (count == 0) {
+      m_added.push_back(event_index);
+    }
+    ++count;
+  }
+}
+
+void ActiveEventList::_remove_anchors(Index linear_site_index) {
+  Index n_unitcells = m_event_list.n_unitcells;
+  Index n_prim_events = m_event_list.n_prim_events;
+  Index b = linear_site_index / n_unitcells;
+  Index const *anchored_unitcell =
+      m_anchored_unitcell.data() +
+      (linear_site_index % n_unitcells) * m_n_translations;
+  for (Anchor const &anchor : m_anchors[b]) {
+    EventIndex event_index = static_cast<EventIndex>(
+        anchored_unitcell[anchor.translation_index] * n_prim_events +
+        anchor.prim_event_index);
+    auto it = m_anchor_count.find(event_index);
+    if (it == m_anchor_count.end()) {
+      continue;
+    }
+    if (--it->second == 0) {
+      m_anchor_count.erase(it);
+      m_removed.push_back(event_index);
+    }
+  }
+}
+
+/// \brief Make the `is_defect` table for ActiveEventList from occupant names
+///
+/// \param prim The prim
+/// \param defect_names Names of the occupants which are defects (i.e. "Va")
+///
+/// \returns is_defect, where `is_defect[b][occ]` is true if occupant `occ`
+///     on sublattice `b` has a name in `defect_names`.
+std::vector<std::vector<bool>> make_is_defect(
+    xtal::BasicStructure const &prim,
+    std::vector<std::string> const &defect_names) {
+  std::vector<std::vector<bool>> is_defect;
+  for (auto const &site : prim.basis()) {
+    is_defect.emplace_back();
+    for (auto const &occupant : site.occupant_dof()) {
+      bool value = false;
+      for (auto const &name : defect_names) {
+        if (occupant.name() == name) {
+          value = true;
+        }
+      }
+      is_defect.back().push_back(value);
+    }
+  }
+  return is_defect;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,5 +1,10 @@
 #include "casm/clexmonte/events/CompleteEventList.hh"
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include "casm/casm_io/Log.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/monte/Conversions.hh"
 #include "casm/monte/events/OccLocation.hh"
@@ -7,69 +12,263 @@
 namespace CASM {
 namespace clexmonte {
 
+namespace {
+
+/// \brief Seconds elapsed since `begin`
+double _seconds_since(std::chrono::steady_clock::time_point begin) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       begin)
+      .count();
+}
+
+}  // namespace
+
+/// \brief Construct the complete event list for a supercell
+///
+/// \param prim_event_list The prim event list
+/// \param prim_impact_info_list Impact info for the prim events
+/// \param occ_location Occupant location tracking, for the supercell
+/// \param event_filters Specifies which events are included in which unit
+///     cells; by default all events are included
+/// \param n_threads Number of threads to use for constructing the impact and
+///     site tables, which are partitioned by unit cell. If `n_threads < 1`,
+///     the number of hardware threads is used. The result does not depend on
+///     `n_threads`.
+/// \param with_impact_table If false, the impact table and relative impact
+///     table are not constructed. This is sufficient for rejection KMC.
+///
+/// The time spent in each construction step is stored in
+/// `event_list.timing`, and can be printed with `print_timing`.
 CompleteEventList make_complete_event_list(
     std::vector<PrimEventData> const &prim_event_list,
     std::vector<EventImpactInfo> const &prim_impact_info_list,
     monte::OccLocation const &occ_location,
-    std::vector<EventFilterGroup> const &event_filters) {
+    std::vector<EventFilterGroup> const &event_filters, int n_threads,
+    bool with_impact_table) {
+  auto begin = std::chrono::steady_clock::now();
+  std::vector<std::vector<RelativeEventID>> relative_impact_table;
+  if (with_impact_table) {
+    relative_impact_table = make_relative_impact_table(prim_impact_info_list);
+  } else {
+    relative_impact_table.resize(prim_event_list.size());
+  }
+  double relative_impact_table_time = _seconds_since(begin);
+
+  CompleteEventList event_list = make_complete_event_list(
+      prim_event_list, relative_impact_table, occ_location, event_filters,
+      n_threads, with_impact_table);
+  event_list.timing["relative_impact_table"] = relative_impact_table_time;
+  event_list.timing["total"] += relative_impact_table_time;
+  return event_list;
+}
+
+/// \brief Construct the complete event list for a supercell, from a relative
+///     impact table
+///
+/// \param prim_event_list The prim event list
+/// \param relative_impact_table The relative impact table, as given by
+///     `make_relative_impact_table`, for the prim events. This does not
+///     depend on the supercell, so it can be constructed once (or read from a
+///     cache, see `make_prim_event_cache_data`) and re-used.
+/// \param occ_location Occupant location tracking, for the supercell
+/// \param event_filters Specifies which events are included in which unit
+///     cells; by default all events are included
+/// \param n_threads Number of threads to use for constructing the impact and
+///     site tables. The result does not depend on `n_threads`.
+/// \param with_impact_table If false, the impact table is not constructed,
+///     and `event_list.impact_table` is empty. This is sufficient for
+///     rejection KMC, and avoids the memory and time needed for the impact
+///     table in large supercells.
+CompleteEventList make_complete_event_list(
+    std::vector<PrimEventData> const &prim_event_list,
+    std::vector<std::vector<RelativeEventID>> const &relative_impact_table,
+    monte::OccLocation const &occ_location,
+    std::vector<EventFilterGroup> const &event_filters, int n_threads,
+    bool with_impact_table) {
   CompleteEventList event_list;
+  auto total_begin = std::chrono::steady_clock::now();
 
-  if (prim_event_list.size() != prim_impact_info_list.size()) {
+  if (prim_event_list.size() != relative_impact_table.size()) {
     throw std::runtime_error(
         "Error in make_complete_event_list: prim_event_list and "
-        "prim_impact_info_list size mismatch");
+        "relative_impact_table size mismatch");
   }
 
   auto const &unitcell_index_converter =
       occ_location.convert().unitcell_index_converter();
   Index n_unitcells = unitcell_index_converter.total_sites();
+  Index n_prim_events = prim_event_list.size();
+  Index n_events = n_unitcells * n_prim_events;
+
+  if (n_events > std::numeric_limits<EventIndex>::max()) {
+    throw std::runtime_error(
+        "Error in make_complete_event_list: too many events for EventIndex");
+  }
 
-  RelativeEventImpactTable relative_impact_table(prim_impact_info_list,
-                                                 unitcell_index_converter);
+  event_list.n_prim_events = n_prim_events;
+  event_list.n_unitcells = n_unitcells;
 
-  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
-       ++unitcell_index) {
-    EventFilterGroup const *filter = nullptr;
-    for (auto const &test_filter : event_filters) {
-      if (test_filter.unitcell_index.count(unitcell_index)) {
-        filter = &test_filter;
-        break;
+  auto begin = std::chrono::steady_clock::now();
+  if (with_impact_table) {
+    event_list.impact_table = CompressedEventImpactTable(
+        relative_impact_table, unitcell_index_converter, n_threads);
+  }
+  event_list.timing["impact_table"] = _seconds_since(begin);
+
+  begin = std::chrono::steady_clock::now();
+  event_list.site_table =
+      EventSiteTable(prim_event_list, unitcell_index_converter, n_threads);
+  event_list.timing["site_table"] = _seconds_since(begin);
+
+  event_list.is_included.resize(n_events, true);
+
+  // check that all prim events can be converted to monte::OccEvent
+  monte::OccEvent tmp;
+  xtal::UnitCell zero_translation(0, 0, 0);
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    set_event(tmp, prim_event_data, zero_translation, occ_location);
+  }
+
+  begin = std::chrono::steady_clock::now();
+  if (!event_filters.empty()) {
+    CompiledEventFilters compiled = compile_event_filters(
+        event_filters, unitcell_index_converter, n_prim_events);
+    auto it = event_list.is_included.begin();
+    for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+         ++unitcell_index) {
+      int group_index = compiled.group_index[unitcell_index];
+      if (group_index != -1) {
+        std::vector<bool> const &is_included =
+            compiled.is_included[group_index];
+        std::copy(is_included.begin(), is_included.end(), it);
       }
+      it += n_prim_events;
     }
+  }
+  event_list.timing["event_filters"] = _seconds_since(begin);
+  event_list.timing["total"] = _seconds_since(total_begin);
+  return event_list;
+}
 
-    for (Index prim_event_index = 0; prim_event_index < prim_event_list.size();
-         ++prim_event_index) {
-      if (filter) {
-        if (filter->include_by_default == true &&
-            filter->prim_event_index.count(prim_event_index)) {
-          continue;
-        }
-        if (filter->include_by_default == false &&
-            !filter->prim_event_index.count(prim_event_index)) {
-          continue;
-        }
-      }
+/// \brief Compile event filters for a particular supercell
+///
+/// This is done once per supercell, so that applying the filters does not
+/// require searching the filter groups for each unit cell.
+///
+/// \param event_filters Specifies which events are included in which unit
+///     cells. If a unit cell is in more than one group, the first group
+///     applies.
+/// \param unitcell_index_converter Converts unit cell indices, for the
+///     supercell
+/// \param n_prim_events Number of prim events
+CompiledEventFilters compile_event_filters(
+    std::vector<EventFilterGroup> const &event_filters,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    Index n_prim_events) {
+  CompiledEventFilters compiled;
+  Index n_unitcells = unitcell_index_converter.total_sites();
+  compiled.group_index.resize(n_unitcells, -1);
 
-      PrimEventData const &prim_event_data = prim_event_list[prim_event_index];
+  for (int group_index = 0; group_index < event_filters.size();
+       ++group_index) {
+    EventFilterGroup const &filter = event_filters[group_index];
 
-      // set event_id
-      EventID event_id;
-      event_id.prim_event_index = prim_event_index;
-      event_id.unitcell_index = unitcell_index;
+    std::vector<bool> is_included(n_prim_events, filter.include_by_default);
+    for (Index prim_event_index : filter.prim_event_index) {
+      if (prim_event_index < 0 || prim_event_index >= n_prim_events) {
+        throw std::runtime_error(
+            "Error in compile_event_filters: prim_event_index out of range");
+      }
+      is_included[prim_event_index] = !filter.include_by_default;
+    }
+    compiled.is_included.push_back(std::move(is_included));
 
-      // set event_data
-      EventData event_data;
-      event_data.unitcell_index = unitcell_index;
-      xtal::UnitCell translation = unitcell_index_converter(unitcell_index);
-      set_event(event_data.event, prim_event_data, translation, occ_location);
+    for (Index unitcell_index : filter.unitcell_index) {
+      if (unitcell_index < 0 || unitcell_index >= n_unitcells) {
+        throw std::runtime_error(
+            "Error in compile_event_filters: unitcell_index out of range");
+      }
+      if (compiled.group_index[unitcell_index] == -1) {
+        compiled.group_index[unitcell_index] = group_index;
+      }
+    }
 
-      // add to lists
-      event_list.impact_table.emplace(event_id,
-                                      relative_impact_table(event_id));
-      event_list.events.emplace(event_id, event_data);
+    if (filter.regions.empty()) {
+      continue;
+    }
+    for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+         ++unitcell_index) {
+      if (compiled.group_index[unitcell_index] != -1) {
+        continue;
+      }
+      xtal::UnitCell unitcell = unitcell_index_converter(unitcell_index);
+      for (UnitCellRegion const &region : filter.regions) {
+        if (region.contains(unitcell)) {
+          compiled.group_index[unitcell_index] = group_index;
+          break;
+        }
+      }
     }
   }
-  return event_list;
+  return compiled;
+}
+
+/// \brief Print CompleteEventList construction timing and size
+///
+/// Output is written at `Log::verbose` verbosity.
+void print_timing(Log &log, CompleteEventList const &event_list) {
+  log.custom<Log::verbose>("Complete event list construction");
+  log.indent() << "n_prim_events: " << event_list.n_prim_events << std::endl;
+  log.indent() << "n_unitcells: " << event_list.n_unitcells << std::endl;
+  log.indent() << "n_impact_table_entries: "
+               << event_list.impact_table.n_entries() << std::endl;
+  for (auto const &pair : event_list.timing) {
+    log.indent() << pair.first << " time: " << pair.second << " (s)"
+                 << std::endl;
+  }
+  log.indent() << std::endl;
+}
+
+/// \brief Set monte::OccEvent for an event in a CompleteEventList
+///
+/// Events are not stored in CompleteEventList, this constructs the
+/// monte::OccEvent needed to apply an event as needed. The `event`
+/// argument can be re-used as a scratch buffer.
+///
+/// \param event The monte::OccEvent to set
+/// \param event_index The event index
+/// \param event_list The complete event list
+/// \param prim_event_list The prim event list
+/// \param occ_location Occupant location tracking, must be consistent with
+///     the supercell of `event_list`
+monte::OccEvent &set_event(monte::OccEvent &event, EventIndex event_index,
+                           CompleteEventList const &event_list,
+                           std::vector<PrimEventData> const &prim_event_list,
+                           monte::OccLocation const &occ_location) {
+  EventID event_id = event_list.event_id(event_index);
+  auto const &unitcell_index_converter =
+      occ_location.convert().unitcell_index_converter();
+  return set_event(event, prim_event_list[event_id.prim_event_index],
+                   unitcell_index_converter(event_id.unitcell_index),
+                   occ_location);
+}
+
+/// \brief Set EventData for an event in a CompleteEventList
+///
+/// \param event_data The EventData to set
+/// \param event_index The event index
+/// \param event_list The complete event list
+/// \param prim_event_list The prim event list
+/// \param occ_location Occupant location tracking, must be consistent with
+///     the supercell of `event_list`
+EventData &set_event_data(EventData &event_data, EventIndex event_index,
+                          CompleteEventList const &event_list,
+                          std::vector<PrimEventData> const &prim_event_list,
+                          monte::OccLocation const &occ_location) {
+  event_data.unitcell_index = event_index / event_list.n_prim_events;
+  set_event(event_data.event, event_index, event_list, prim_event_list,
+            occ_location);
+  return event_data;
 }
 
 /// \brief Construct a vector of all EventID
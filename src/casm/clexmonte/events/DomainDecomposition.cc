@@ -0,0 +1,80 @@
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+DomainDecomposition::DomainDecomposition(
+    Eigen::Matrix3l const &transformation_matrix_to_super,
+    xtal::UnitCellIndexConverter const &unitcell_index_converter,
+    Eigen::Vector3l const &_n_domains,
+    std::vector<std::vector<RelativeEventID>> const &relative_impact_table) {
+  double tol = 1e-10;
+  if ((_n_domains.array() < 1).any()) {
+    throw std::runtime_error(
+        "Error constructing DomainDecomposition: n_domains must be >= 1");
+  }
+
+  // Number of sectors along each axis, and number of slabs (sector widths)
+  Eigen::Vector3l n_sectors_by_axis;
+  Eigen::Vector3l n_slabs;
+  for (Index a = 0; a < 3; ++a) {
+    n_sectors_by_axis(a) = (_n_domains(a) > 1) ? 2 : 1;
+    n_slabs(a) = _n_domains(a) * n_sectors_by_axis(a);
+  }
+  n_domains = _n_domains.prod();
+  n_sectors = n_sectors_by_axis.prod();
+
+  // Converts unit cell coordinates to supercell fractional coordinates
+  Eigen::Matrix3d frac_matrix =
+      transformation_matrix_to_super.cast<double>().inverse();
+
+  // Check the sector width against the range of the impact table
+  Eigen::Vector3d impact_range = Eigen::Vector3d::Zero();
+  for (auto const &impacted : relative_impact_table) {
+    for (RelativeEventID const &relative_event_id : impacted) {
+      Eigen::Vector3d f =
+          frac_matrix * relative_event_id.translation.cast<double>();
+      impact_range = impact_range.cwiseMax(f.cwiseAbs());
+    }
+  }
+  for (Index a = 0; a < 3; ++a) {
+    if (_n_domains(a) > 1 && impact_range(a) > 1.0 / n_slabs(a) + tol) {
+      std::stringstream ss;
+      ss << "Error constructing DomainDecomposition: sectors along axis " << a
+         << " are narrower than the impact range. Use at most "
+         << std::floor(0.5 / impact_range(a) + tol) << " domains along axis "
+         << a << ".";
+      throw std::runtime_error(ss.str());
+    }
+  }
+
+  // Assign unit cells by fractional coordinates, in [0, 1)
+  Index n_unitcells = unitcell_index_converter.total_sites();
+  unitcell_domain.resize(n_unitcells);
+  unitcell_sector.resize(n_unitcells);
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    xtal::UnitCell unitcell = unitcell_index_converter(unitcell_index);
+    Eigen::Vector3d f = frac_matrix * unitcell.cast<double>();
+    Index domain = 0;
+    Index sector = 0;
+    for (Index a = 0; a < 3; ++a) {
+      double x = f(a) - std::floor(f(a) + tol);
+      Index slab = std::min(
+          static_cast<Index>(std::floor(std::max(x, 0.0) * n_slabs(a) + tol)),
+          static_cast<Index>(n_slabs(a) - 1));
+      domain = domain * _n_domains(a) + slab / n_sectors_by_axis(a);
+      sector = sector * n_sectors_by_axis(a) + slab % n_sectors_by_axis(a);
+    }
+    unitcell_domain[unitcell_index] = domain;
+    unitcell_sector[unitcell_index] = sector;
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
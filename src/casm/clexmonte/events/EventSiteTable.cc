@@ -0,0 +1,100 @@
+#include "casm/clexmonte/events/EventSiteTable.hh"
+
+#include <map>
+
+#include "casm/clexmonte/misc/parallel.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+std::vector<std::vector<xtal::UnitCellCoord>> _prim_event_sites(
+    std::vector<PrimEventData> const &prim_event_list) {
+  std::vector<std::vector<xtal::UnitCellCoord>> prim_event_sites;
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    prim_event_sites.push_back(prim_event_data.sites);
+  }
+  return prim_event_sites;
+}
+
+}  // namespace
+
+EventSiteTable::EventSiteTable() : m_n_unitcells(0), m_n_translations(0) {}
+
+/// \brief Constructor
+///
+/// \param prim_event_list The prim event list, providing the sites of all
+///     possible events in the origin unit cell.
+/// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads to use to fill the neighbor unit cell
+///     table, which is partitioned by unit cell. The result does not depend
+///     on `n_threads`.
+EventSiteTable::EventSiteTable(
+    std::vector<PrimEventData> const &prim_event_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter, int n_threads)
+    : EventSiteTable(_prim_event_sites(prim_event_list), unitcell_converter,
+                     n_threads) {}
+
+/// \brief Constructor, from any list of sites for each prim event
+///
+/// \param prim_event_sites Sites associated with each prim event in the
+///     origin unit cell, by prim event index. These may be the event sites,
+///     or other sites, such as the event's update neighborhood.
+/// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads to use to fill the neighbor unit cell
+///     table. The result does not depend on `n_threads`.
+EventSiteTable::EventSiteTable(
+    std::vector<std::vector<xtal::UnitCellCoord>> const &prim_event_sites,
+    xtal::UnitCellIndexConverter const &unitcell_converter, int n_threads)
+    : m_n_unitcells(unitcell_converter.total_sites()) {
+  // collect distinct translations, in order of first appearance
+  std::map<xtal::UnitCell, Index> translation_index;
+  std::vector<xtal::UnitCell> translations;
+  for (auto const &sites : prim_event_sites) {
+    m_sublattice.emplace_back();
+    m_translation_index.emplace_back();
+    for (xtal::UnitCellCoord const &site : sites) {
+      auto result =
+          translation_index.emplace(site.unitcell(), translations.size());
+      if (result.second) {
+        translations.push_back(site.unitcell());
+      }
+      m_sublattice.back().push_back(site.sublattice());
+      m_translation_index.back().push_back(result.first->second);
+    }
+  }
+  m_n_translations = translations.size();
+
+  m_neighbor_unitcell.resize(m_n_unitcells * m_n_translations);
+  auto fill_f = [&](int thread_index, Index begin, Index end) {
+    Index *it = m_neighbor_unitcell.data() + begin * m_n_translations;
+    for (Index unitcell_index = begin; unitcell_index < end;
+         ++unitcell_index) {
+      xtal::UnitCell unitcell = unitcell_converter(unitcell_index);
+      for (xtal::UnitCell const &translation : translations) {
+        *it = unitcell_converter(unitcell + translation);
+        ++it;
+      }
+    }
+  };
+  parallel_for_blocks(m_n_unitcells, resolve_n_threads(n_threads), fill_f);
+}
+
+/// \brief Approximate memory used by the table, in bytes
+std::size_t EventSiteTable::memory_usage() const {
+  std::size_t bytes = sizeof(*this);
+  bytes += m_sublattice.capacity() * sizeof(std::vector<Index>);
+  for (auto const &x : m_sublattice) {
+    bytes += x.capacity() * sizeof(Index);
+  }
+  bytes += m_translation_index.capacity() * sizeof(std::vector<Index>);
+  for (auto const &x : m_translation_index) {
+    bytes += x.capacity() * sizeof(Index);
+  }
+  bytes += m_neighbor_unitcell.capacity() * sizeof(Index);
+  return bytes;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,5 +1,14 @@
 #include "casm/clexmonte/events/ImpactTable.hh"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <unordered_set>
+
+#include "casm/clexmonte/misc/parallel.hh"
+
 namespace CASM {
 namespace clexmonte {
 
@@ -14,6 +23,17 @@ RelativeEventImpactTable::RelativeEventImpactTable(
     : m_impact_table(make_relative_impact_table(prim_event_list)),
       m_unitcell_converter(unitcell_converter) {}
 
+/// \brief Approximate memory used by the table, in bytes
+std::size_t RelativeEventImpactTable::memory_usage() const {
+  std::size_t bytes = sizeof(*this);
+  bytes += m_impact_table.capacity() * sizeof(std::vector<RelativeEventID>);
+  for (auto const &impacted : m_impact_table) {
+    bytes += impacted.capacity() * sizeof(RelativeEventID);
+  }
+  bytes += m_result.capacity() * sizeof(EventID);
+  return bytes;
+}
+
 /// \brief Constructor
 ///
 /// \param prim_event_list A vector of EventImpactInfo, providing the impact
@@ -42,29 +62,153 @@ SupercellEventImpactTable::SupercellEventImpactTable(
   }
 }
 
-namespace {
+/// \brief Approximate memory used by the table, in bytes
+std::size_t SupercellEventImpactTable::memory_usage() const {
+  std::size_t bytes = sizeof(*this);
+  bytes += m_impact_table.capacity() * sizeof(std::vector<EventID>);
+  for (auto const &impacted : m_impact_table) {
+    bytes += impacted.capacity() * sizeof(EventID);
+  }
+  return bytes;
+}
+
+CompressedEventImpactTable::CompressedEventImpactTable()
+    : m_n_prim_events(0), m_offsets(1, 0) {}
 
-/// \brief Make translations which map phenomenal_sites onto sites in the
-/// required_update_neighborhood
+/// \brief Constructor
 ///
-/// Impact translations are all 'trans' such that:
+/// \param prim_event_list A vector of EventImpactInfo, providing the impact
+///     information for all possible events in the origin unit cell.
+/// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads to use to fill the table, which is
+///     partitioned by unit cell. The result does not depend on `n_threads`.
+CompressedEventImpactTable::CompressedEventImpactTable(
+    std::vector<EventImpactInfo> const &prim_event_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter, int n_threads)
+    : CompressedEventImpactTable(make_relative_impact_table(prim_event_list),
+                                 unitcell_converter, n_threads) {}
+
+/// \brief Constructor
 ///
-///     neighborhood_site == phenom_site + trans
+/// Each row has unique entries. In small supercells, distinct relative
+/// translations may be periodic images of the same unit cell; only the first
+/// of these is kept. Whether two translations are images does not depend on
+/// the impacting unit cell, so duplicates are removed from the relative
+/// impact table once, and all rows for a prim event have the same size.
+/// Unique rows are required for parallel rate updates, in which each entry
+/// of a row may be updated by a different thread.
 ///
-std::set<xtal::UnitCell> make_impact_translations(
-    std::set<xtal::UnitCellCoord> const &required_update_neighborhood,
-    std::vector<xtal::UnitCellCoord> const &phenomenal_sites) {
-  std::set<xtal::UnitCell> translations;
-  for (xtal::UnitCellCoord const &nbor_site : required_update_neighborhood) {
-    for (xtal::UnitCellCoord const &phenom_site : phenomenal_sites) {
-      if (nbor_site.sublattice() == phenom_site.sublattice()) {
-        translations.insert(nbor_site.unitcell() - phenom_site.unitcell());
+/// \param _relative_impact_table The impact table for events in the origin
+///     unit cell, as generated by `make_relative_impact_table`.
+/// \param unitcell_converter Convert unit cell indices
+/// \param n_threads Number of threads to use to fill the table, which is
+///     partitioned by unit cell. The result does not depend on `n_threads`.
+CompressedEventImpactTable::CompressedEventImpactTable(
+    std::vector<std::vector<RelativeEventID>> const &_relative_impact_table,
+    xtal::UnitCellIndexConverter const &unitcell_converter, int n_threads)
+    : m_n_prim_events(_relative_impact_table.size()) {
+  // remove entries which are periodic images in this supercell
+  std::vector<std::vector<RelativeEventID>> relative_impact_table(
+      m_n_prim_events);
+  std::set<std::pair<Index, Index>> seen;
+  for (Index j = 0; j < m_n_prim_events; ++j) {
+    seen.clear();
+    for (RelativeEventID const &relative_event_id : _relative_impact_table[j]) {
+      std::pair<Index, Index> key(
+          unitcell_converter(relative_event_id.translation),
+          relative_event_id.prim_event_index);
+      if (seen.insert(key).second) {
+        relative_impact_table[j].push_back(relative_event_id);
       }
     }
   }
-  return translations;
+
+  Index n_unitcells = unitcell_converter.total_sites();
+  Index n_events = n_unitcells * m_n_prim_events;
+  if (n_events > std::numeric_limits<EventIndex>::max()) {
+    throw std::runtime_error(
+        "Error constructing CompressedEventImpactTable: too many events for "
+        "EventIndex");
+  }
+
+  // the number of impacted events depends only on prim_event_index, so
+  // offsets can be set before filling in impacted events
+  m_offsets.resize(n_events + 1);
+  m_offsets[0] = 0;
+  Index event_index = 0;
+  for (Index unitcell_index = 0; unitcell_index < n_unitcells;
+       ++unitcell_index) {
+    for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+         ++prim_event_index) {
+      m_offsets[event_index + 1] =
+          m_offsets[event_index] +
+          relative_impact_table[prim_event_index].size();
+      ++event_index;
+    }
+  }
+  m_impacted.resize(m_offsets[n_events]);
+
+  // loop order matters, it must be consistent
+  //   with the EventIndex definition
+  auto fill_f = [&](int thread_index, Index begin, Index end) {
+    EventIndex *it = m_impacted.data() + m_offsets[begin * m_n_prim_events];
+    for (Index unitcell_index = begin; unitcell_index < end;
+         ++unitcell_index) {
+      xtal::UnitCell translation = unitcell_converter(unitcell_index);
+      for (Index prim_event_index = 0; prim_event_index < m_n_prim_events;
+           ++prim_event_index) {
+        for (RelativeEventID const &relative_event_id :
+             relative_impact_table[prim_event_index]) {
+          Index impacted_unitcell_index =
+              unitcell_converter(translation + relative_event_id.translation);
+          *it = static_cast<EventIndex>(
+              impacted_unitcell_index * m_n_prim_events +
+              relative_event_id.prim_event_index);
+          ++it;
+        }
+      }
+    }
+  };
+  parallel_for_blocks(n_unitcells, resolve_n_threads(n_threads), fill_f);
 }
 
+/// \brief Approximate memory used by the table, in bytes
+std::size_t CompressedEventImpactTable::memory_usage() const {
+  return sizeof(*this) + m_offsets.capacity() * sizeof(std::uint64_t) +
+         m_impacted.capacity() * sizeof(EventIndex);
+}
+
+namespace {
+
+/// \brief A prim event index and a translation, used to find distinct
+///     impacting events
+struct ImpactKey {
+  Index prim_event_index;
+  xtal::UnitCell translation;
+
+  bool operator==(ImpactKey const &other) const {
+    return prim_event_index == other.prim_event_index &&
+           translation == other.translation;
+  }
+};
+
+struct ImpactKeyHash {
+  std::size_t operator()(ImpactKey const &key) const {
+    std::size_t seed = std::hash<Index>()(key.prim_event_index);
+    for (Index k = 0; k < 3; ++k) {
+      seed ^= std::hash<Index>()(key.translation(k)) + 0x9e3779b97f4a7c15ULL +
+              (seed << 6) + (seed >> 2);
+    }
+    return seed;
+  }
+};
+
+/// \brief Phenomenal site of a prim event, bucketed by sublattice
+struct PhenomenalSite {
+  Index prim_event_index;
+  xtal::UnitCell unitcell;
+};
+
 }  // namespace
 
 /// \brief Return an impact table for events in the origin unit cell
@@ -77,28 +221,73 @@ std::set<xtal::UnitCell> make_impact_translations(
 ///     impacted by the occurance of event `prim_event_list[i]` in the origin
 ///     unit cell.
 ///
+/// Notes:
+/// - Event (j, trans) impacts event (i, zero) if any site in the required
+///   update neighborhood of event i is equal to a phenomenal site of event j
+///   translated by `trans`. Equivalently, event (j, zero) impacts event
+///   (i, -trans).
+/// - Phenomenal sites are bucketed by sublattice, so for each required
+///   update neighborhood site only the phenomenal sites on the same
+///   sublattice are checked, and distinct (j, trans) are found using a hash
+///   set. Then (j, trans) are sorted so the order of the result is
+///   independent of hashing: relative_impact_table[j] lists impacted events
+///   in order of increasing prim event index `i`, then increasing `trans`.
+///
 std::vector<std::vector<RelativeEventID>> make_relative_impact_table(
     std::vector<EventImpactInfo> const &prim_event_list) {
   std::vector<std::vector<RelativeEventID>> impact_table;
   impact_table.resize(prim_event_list.size());
-  RelativeEventID relative_event_id;
-  xtal::UnitCell zero_translation(0, 0, 0);
 
+  // bucket phenomenal sites by sublattice
+  std::vector<std::vector<PhenomenalSite>> phenomenal_sites_by_sublattice;
+  for (Index j = 0; j < prim_event_list.size(); ++j) {
+    for (xtal::UnitCellCoord const &phenom_site :
+         prim_event_list[j].phenomenal_sites) {
+      Index b = phenom_site.sublattice();
+      if (b >= phenomenal_sites_by_sublattice.size()) {
+        phenomenal_sites_by_sublattice.resize(b + 1);
+      }
+      phenomenal_sites_by_sublattice[b].push_back({j, phenom_site.unitcell()});
+    }
+  }
+
+  std::less<xtal::UnitCell> translation_less;
+  auto key_less = [&](ImpactKey const &lhs, ImpactKey const &rhs) {
+    if (lhs.prim_event_index != rhs.prim_event_index) {
+      return lhs.prim_event_index < rhs.prim_event_index;
+    }
+    return translation_less(lhs.translation, rhs.translation);
+  };
+
+  std::unordered_set<ImpactKey, ImpactKeyHash> distinct;
+  std::vector<ImpactKey> keys;
+  RelativeEventID relative_event_id;
   for (Index i = 0; i < prim_event_list.size(); ++i) {
-    for (Index j = 0; j < prim_event_list.size(); ++j) {
-      // translations are 'trans' such that:
-      // event (j, trans) impacts event (i, zero)
-      std::set<xtal::UnitCell> translations = make_impact_translations(
-          prim_event_list[i].required_update_neighborhood,
-          prim_event_list[j].phenomenal_sites);
-
-      for (xtal::UnitCell const &trans : translations) {
-        // -> event (j, zero) impacts event (i, -trans)
-        relative_event_id.prim_event_index = i;
-        relative_event_id.translation = -trans;
-        impact_table[j].push_back(relative_event_id);
+    // find distinct (j, trans) such that: event (j, trans) impacts event
+    // (i, zero)
+    distinct.clear();
+    for (xtal::UnitCellCoord const &nbor_site :
+         prim_event_list[i].required_update_neighborhood) {
+      Index b = nbor_site.sublattice();
+      if (b >= phenomenal_sites_by_sublattice.size()) {
+        continue;
+      }
+      for (PhenomenalSite const &phenom_site :
+           phenomenal_sites_by_sublattice[b]) {
+        distinct.insert(ImpactKey{phenom_site.prim_event_index,
+                                  nbor_site.unitcell() - phenom_site.unitcell});
       }
     }
+
+    keys.assign(distinct.begin(), distinct.end());
+    std::sort(keys.begin(), keys.end(), key_less);
+
+    // -> event (j, zero) impacts event (i, -trans)
+    for (ImpactKey const &key : keys) {
+      relative_event_id.prim_event_index = i;
+      relative_event_id.translation = -key.translation;
+      impact_table[key.prim_event_index].push_back(relative_event_id);
+    }
   }
   return impact_table;
 }
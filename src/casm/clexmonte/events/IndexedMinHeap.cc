@@ -0,0 +1,82 @@
+#include "casm/clexmonte/events/IndexedMinHeap.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor, with initial keys
+///
+/// \param keys Initial keys, by item
+IndexedMinHeap::IndexedMinHeap(std::vector<double> const &keys) {
+  reset(keys);
+}
+
+/// \brief Set the key of an item and restore the heap order
+///
+/// \param item Item index, in range [0, size())
+/// \param key New key
+void IndexedMinHeap::set(Index item, double key) {
+  double old_key = m_key[item];
+  m_key[item] = key;
+  if (key < old_key) {
+    _sift_up(m_position[item]);
+  } else if (key > old_key) {
+    _sift_down(m_position[item]);
+  }
+}
+
+/// \brief Set all keys and rebuild the heap, in O(N)
+///
+/// \param keys New keys, by item. The number of items is set to
+///     `keys.size()`.
+void IndexedMinHeap::reset(std::vector<double> const &keys) {
+  m_key = keys;
+  Index n = m_key.size();
+  m_heap.resize(n);
+  m_position.resize(n);
+  for (Index i = 0; i < n; ++i) {
+    _place(i, i);
+  }
+  for (Index pos = n / 2; pos > 0; --pos) {
+    _sift_down(pos - 1);
+  }
+}
+
+/// \brief Move the item at heap position `pos` up until in order
+void IndexedMinHeap::_sift_up(Index pos) {
+  Index item = m_heap[pos];
+  double key = m_key[item];
+  while (pos > 0) {
+    Index parent = (pos - 1) / 2;
+    if (!(key < m_key[m_heap[parent]])) {
+      break;
+    }
+    _place(pos, m_heap[parent]);
+    pos = parent;
+  }
+  _place(pos, item);
+}
+
+/// \brief Move the item at heap position `pos` down until in order
+void IndexedMinHeap::_sift_down(Index pos) {
+  Index n = m_heap.size();
+  Index item = m_heap[pos];
+  double key = m_key[item];
+  while (true) {
+    Index child = 2 * pos + 1;
+    if (child >= n) {
+      break;
+    }
+    if (child + 1 < n && m_key[m_heap[child + 1]] < m_key[m_heap[child]]) {
+      ++child;
+    }
+    if (!(m_key[m_heap[child]] < key)) {
+      break;
+    }
+    _place(pos, m_heap[child]);
+    pos = child;
+  }
+  _place(pos, item);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,89 @@
+#include "casm/clexmonte/events/PackedOccupation.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/crystallography/BasicStructure.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Constructor
+///
+/// \param occ The occupation of each event site. Each value must be in the
+///     range [0, 256).
+PackedOccSignature::PackedOccSignature(std::vector<int> const &occ)
+    : words((occ.size() + 7) / 8, 0) {
+  for (Index i = 0; i < occ.size(); ++i) {
+    if (occ[i] < 0 || occ[i] > 255) {
+      throw std::runtime_error(
+          "Error constructing PackedOccSignature: occupation out of range");
+    }
+    words[i / 8] |= static_cast<std::uint64_t>(occ[i]) << ((i % 8) * 8);
+  }
+}
+
+PackedOccupation::PackedOccupation()
+    : m_size(0),
+      m_bits(1),
+      m_bits_shift(0),
+      m_word_shift(6),
+      m_site_mask(63),
+      m_occ_mask(1) {}
+
+/// \brief Constructor
+///
+/// \param occupation The occupation, by linear site index
+/// \param n_occupants_max The maximum number of occupants allowed on any
+///     site, which determines the number of bits per site. Must be in the
+///     range [1, 256].
+PackedOccupation::PackedOccupation(Eigen::VectorXi const &occupation,
+                                   int n_occupants_max) {
+  if (n_occupants_max < 1 || n_occupants_max > 256) {
+    throw std::runtime_error(
+        "Error constructing PackedOccupation: n_occupants_max out of range");
+  }
+  m_bits_shift = 0;
+  while ((1 << (1 << m_bits_shift)) < n_occupants_max) {
+    ++m_bits_shift;
+  }
+  m_bits = 1 << m_bits_shift;
+  m_word_shift = 6 - m_bits_shift;
+  m_site_mask = (Index(1) << m_word_shift) - 1;
+  m_occ_mask = (std::uint64_t(1) << m_bits) - 1;
+  reset(occupation);
+}
+
+/// \brief Set all site occupations
+///
+/// \param occupation The occupation, by linear site index. Each value must
+///     be in the range [0, 2^bits_per_site()).
+void PackedOccupation::reset(Eigen::VectorXi const &occupation) {
+  m_size = occupation.size();
+  m_words.assign((m_size + m_site_mask) >> m_word_shift, 0);
+  for (Index l = 0; l < m_size; ++l) {
+    if (occupation(l) < 0) {
+      throw std::runtime_error(
+          "Error in PackedOccupation::reset: negative occupation");
+    }
+    if (static_cast<std::uint64_t>(occupation(l)) > m_occ_mask) {
+      throw std::runtime_error(
+          "Error in PackedOccupation::reset: occupation exceeds the "
+          "bits per site");
+    }
+    set(l, occupation(l));
+  }
+}
+
+/// \brief Maximum number of occupants allowed on any sublattice
+int max_n_occupants(xtal::BasicStructure const &prim) {
+  int n_occupants_max = 1;
+  for (auto const &site : prim.basis()) {
+    n_occupants_max =
+        std::max(n_occupants_max, int(site.occupant_dof().size()));
+  }
+  return n_occupants_max;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,271 @@
+#include "casm/clexmonte/events/PrimEventCache.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+/// Identifies prim event cache files
+char const prim_event_cache_magic[8] = {'C', 'L', 'X', 'M', 'P', 'E', 'C',
+                                        '\0'};
+
+/// Incremented when the cache file layout changes
+std::int64_t const prim_event_cache_version = 1;
+
+/// \brief Reads int64 values from a memory-mapped cache file, with bounds
+///     checking
+class CacheReader {
+ public:
+  CacheReader(std::int64_t const *begin, std::int64_t const *end)
+      : m_it(begin), m_end(end) {}
+
+  bool read(std::int64_t &value) {
+    if (m_it == m_end) {
+      return false;
+    }
+    value = *m_it++;
+    return true;
+  }
+
+  bool read(xtal::UnitCellCoord &site) {
+    if (m_end - m_it < 4) {
+      return false;
+    }
+    site = xtal::UnitCellCoord(m_it[0], m_it[1], m_it[2], m_it[3]);
+    m_it += 4;
+    return true;
+  }
+
+  bool at_end() const { return m_it == m_end; }
+
+  /// \brief Number of int64 values not yet read
+  std::int64_t remaining() const { return m_end - m_it; }
+
+  /// \brief Read a list size, checking that `size` items of
+  ///     `values_per_item` values each could remain in the file
+  bool read_size(std::int64_t &size, std::int64_t values_per_item) {
+    return read(size) && size >= 0 && size <= remaining() / values_per_item;
+  }
+
+ private:
+  std::int64_t const *m_it;
+  std::int64_t const *m_end;
+};
+
+/// \brief Memory-map a file, read-only; unmapped on destruction
+class MappedFile {
+ public:
+  explicit MappedFile(fs::path const &filepath)
+      : m_data(MAP_FAILED), m_size(0) {
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+      m_size = st.st_size;
+      m_data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+  }
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile &operator=(MappedFile const &) = delete;
+
+  ~MappedFile() {
+    if (m_data != MAP_FAILED) {
+      ::munmap(m_data, m_size);
+    }
+  }
+
+  bool is_open() const { return m_data != MAP_FAILED; }
+
+  char const *data() const { return static_cast<char const *>(m_data); }
+
+  std::size_t size() const { return m_size; }
+
+ private:
+  void *m_data;
+  std::size_t m_size;
+};
+
+void _write(std::ofstream &out, std::int64_t value) {
+  out.write(reinterpret_cast<char const *>(&value), sizeof(value));
+}
+
+void _write(std::ofstream &out, xtal::UnitCellCoord const &site) {
+  _write(out, site.sublattice());
+  for (Index k = 0; k < 3; ++k) {
+    _write(out, site.unitcell()(k));
+  }
+}
+
+template <typename ContainerType>
+void _write_sites(std::ofstream &out, ContainerType const &sites) {
+  _write(out, sites.size());
+  for (xtal::UnitCellCoord const &site : sites) {
+    _write(out, site);
+  }
+}
+
+}  // namespace
+
+/// \brief Read cached prim event data, if it exists and matches `hash`
+///
+/// The file is memory-mapped and checked while reading. If the file does
+/// not exist, was written for different data (as determined by `hash`), has
+/// a different version, or is incomplete, `data` is not modified.
+///
+/// \param data Set to the cached data if it is read successfully
+/// \param filepath Cache file location
+/// \param hash Expected hash of the data used to calculate the cached data
+///
+/// \returns True if `data` was read from the cache, false otherwise
+bool read_prim_event_cache(PrimEventCacheData &data,
+                           fs::path const &filepath, std::uint64_t hash) {
+  MappedFile file(filepath);
+  std::size_t header_size =
+      sizeof(prim_event_cache_magic) + 2 * sizeof(std::int64_t);
+  if (!file.is_open() || file.size() < header_size ||
+      (file.size() - sizeof(prim_event_cache_magic)) % sizeof(std::int64_t)) {
+    return false;
+  }
+  if (std::memcmp(file.data(), prim_event_cache_magic,
+                  sizeof(prim_event_cache_magic)) != 0) {
+    return false;
+  }
+  std::int64_t const *begin = reinterpret_cast<std::int64_t const *>(
+      file.data() + sizeof(prim_event_cache_magic));
+  std::int64_t const *end =
+      reinterpret_cast<std::int64_t const *>(file.data() + file.size());
+  CacheReader reader(begin, end);
+
+  std::int64_t version;
+  std::int64_t file_hash;
+  if (!reader.read(version) || version != prim_event_cache_version ||
+      !reader.read(file_hash) || std::uint64_t(file_hash) != hash) {
+    return false;
+  }
+
+  PrimEventCacheData tmp;
+  std::int64_t n_events;
+  // each event has at least 3 list sizes
+  if (!reader.read_size(n_events, 3)) {
+    return false;
+  }
+  tmp.prim_impact_info_list.resize(n_events);
+  tmp.relative_impact_table.resize(n_events);
+
+  xtal::UnitCellCoord site;
+  std::int64_t n;
+  for (EventImpactInfo &impact : tmp.prim_impact_info_list) {
+    if (!reader.read_size(n, 4)) {
+      return false;
+    }
+    for (std::int64_t i = 0; i < n; ++i) {
+      if (!reader.read(site)) {
+        return false;
+      }
+      impact.phenomenal_sites.push_back(site);
+    }
+    if (!reader.read_size(n, 4)) {
+      return false;
+    }
+    for (std::int64_t i = 0; i < n; ++i) {
+      if (!reader.read(site)) {
+        return false;
+      }
+      impact.required_update_neighborhood.insert(
+          impact.required_update_neighborhood.end(), site);
+    }
+  }
+
+  for (std::vector<RelativeEventID> &impacted : tmp.relative_impact_table) {
+    if (!reader.read_size(n, 4)) {
+      return false;
+    }
+    impacted.resize(n);
+    for (RelativeEventID &relative_event_id : impacted) {
+      // stored as (prim_event_index, translation) in UnitCellCoord layout
+      if (!reader.read(site) || site.sublattice() < 0 ||
+          site.sublattice() >= n_events) {
+        return false;
+      }
+      relative_event_id.prim_event_index = site.sublattice();
+      relative_event_id.translation = site.unitcell();
+    }
+  }
+
+  if (!reader.at_end()) {
+    return false;
+  }
+  data = std::move(tmp);
+  return true;
+}
+
+/// \brief Write prim event data to a cache file
+///
+/// The file is written to a temporary file in the same directory, then
+/// renamed, so that concurrent runs never read a partially written file.
+/// The parent directory is created if it does not exist.
+///
+/// Layout, after an 8 byte identifier, as int64 values: version, hash,
+/// n_events; then for each event the phenomenal sites and required update
+/// neighborhood; then for each event the relative impact table entries.
+/// Sites are written as (b, i, j, k), and lists are preceded by their size.
+///
+/// \param data The data to write
+/// \param filepath Cache file location
+/// \param hash Hash of the data used to calculate `data`
+void write_prim_event_cache(PrimEventCacheData const &data,
+                            fs::path const &filepath, std::uint64_t hash) {
+  if (filepath.has_parent_path()) {
+    fs::create_directories(filepath.parent_path());
+  }
+  fs::path tmp_filepath = filepath;
+  tmp_filepath += ".tmp." + std::to_string(::getpid());
+
+  {
+    std::ofstream out(tmp_filepath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error(
+          "Error in write_prim_event_cache: could not open " +
+          tmp_filepath.string());
+    }
+    out.write(prim_event_cache_magic, sizeof(prim_event_cache_magic));
+    _write(out, prim_event_cache_version);
+    _write(out, std::int64_t(hash));
+    _write(out, data.prim_impact_info_list.size());
+    for (EventImpactInfo const &impact : data.prim_impact_info_list) {
+      _write_sites(out, impact.phenomenal_sites);
+      _write_sites(out, impact.required_update_neighborhood);
+    }
+    for (auto const &impacted : data.relative_impact_table) {
+      _write(out, impacted.size());
+      for (RelativeEventID const &relative_event_id : impacted) {
+        _write(out, relative_event_id.prim_event_index);
+        for (Index k = 0; k < 3; ++k) {
+          _write(out, relative_event_id.translation(k));
+        }
+      }
+    }
+    if (!out) {
+      throw std::runtime_error(
+          "Error in write_prim_event_cache: could not write " +
+          tmp_filepath.string());
+    }
+  }
+  fs::rename(tmp_filepath, filepath);
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,148 @@
+#include "casm/clexmonte/events/SumTree.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "casm/clexmonte/misc/parallel.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+namespace {
+
+Index _make_capacity(Index n_leaves) {
+  Index capacity = 1;
+  while (capacity < n_leaves) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+}  // namespace
+
+/// \brief Constructor, all leaf values are initialized to 0.0
+///
+/// \param n_leaves Number of leaves
+SumTree::SumTree(Index n_leaves)
+    : m_size(n_leaves),
+      m_capacity(_make_capacity(n_leaves)),
+      m_tree(2 * m_capacity, 0.0) {}
+
+/// \brief Constructor, with initial leaf values
+///
+/// \param values Initial leaf values, which must be non-negative
+/// \param n_threads Number of threads used to build partial sums
+SumTree::SumTree(std::vector<double> const &values, int n_threads)
+    : SumTree(Index(values.size())) {
+  reset(values, n_threads);
+}
+
+/// \brief Set the value of a leaf and update partial sums
+///
+/// \param leaf_index Leaf index, in range [0, size())
+/// \param value New leaf value, which must be non-negative
+void SumTree::set(Index leaf_index, double value) {
+  Index node = m_capacity + leaf_index;
+  m_tree[node] = value;
+  node /= 2;
+  while (node > 0) {
+    m_tree[node] = m_tree[2 * node] + m_tree[2 * node + 1];
+    node /= 2;
+  }
+}
+
+/// \brief Set all leaf values and rebuild partial sums
+///
+/// \param values New leaf values, which must be non-negative. Size must be
+///     equal to size().
+/// \param n_threads Number of threads used to build partial sums. The
+///     result does not depend on `n_threads`.
+void SumTree::reset(std::vector<double> const &values, int n_threads) {
+  if (Index(values.size()) != m_size) {
+    throw std::runtime_error("Error in SumTree::reset: size mismatch");
+  }
+  std::copy(values.begin(), values.end(), m_tree.begin() + m_capacity);
+  std::fill(m_tree.begin() + m_capacity + m_size, m_tree.end(), 0.0);
+  _rebuild(resolve_n_threads(n_threads));
+}
+
+/// \brief Change the number of leaves, keeping existing leaf values
+///
+/// Leaves with index less than `std::min(size(), n_leaves)` keep their
+/// values; new leaves are initialized to 0.0. Partial sums are rebuilt only
+/// if the capacity changes, so growing by doubling is amortized O(1) per
+/// leaf.
+///
+/// \param n_leaves New number of leaves
+void SumTree::resize(Index n_leaves) {
+  Index capacity = _make_capacity(n_leaves);
+  if (capacity == m_capacity) {
+    for (Index i = n_leaves; i < m_size; ++i) {
+      set(i, 0.0);
+    }
+    m_size = n_leaves;
+    return;
+  }
+  std::vector<double> tree(2 * capacity, 0.0);
+  Index n_keep = std::min(m_size, n_leaves);
+  std::copy(m_tree.begin() + m_capacity, m_tree.begin() + m_capacity + n_keep,
+            tree.begin() + capacity);
+  m_tree = std::move(tree);
+  m_size = n_leaves;
+  m_capacity = capacity;
+  _rebuild(1);
+}
+
+/// \brief Find the leaf for which the cumulative sum of leaf values
+///     first exceeds `cumulative_value`
+///
+/// \param cumulative_value A value in the range [0.0, total())
+///
+/// \returns The index of a leaf with non-zero value, which is selected
+///     with probability proportional to its value if `cumulative_value` is
+///     sampled uniformly from [0.0, total()).
+Index SumTree::find(double cumulative_value) const {
+  if (!(m_tree[1] > 0.0)) {
+    throw std::runtime_error("Error in SumTree::find: total is zero");
+  }
+  Index node = 1;
+  while (node < m_capacity) {
+    Index left = 2 * node;
+    // Note: if the right subtree is empty, always go left, to avoid selecting
+    //   a zero-valued leaf due to rounding
+    if (cumulative_value < m_tree[left] || !(m_tree[left + 1] > 0.0)) {
+      node = left;
+    } else {
+      cumulative_value -= m_tree[left];
+      node = left + 1;
+    }
+  }
+  return node - m_capacity;
+}
+
+/// \brief Recalculate all partial sums from the leaf values
+///
+/// Partial sums are calculated level by level, from the leaves up. Levels
+/// with many nodes are split between threads. Each node is always the sum of
+/// its two children, so the result does not depend on `n_threads`.
+void SumTree::_rebuild(int n_threads) {
+  // minimum number of nodes per thread to be worth splitting a level
+  Index const min_nodes_per_thread = 1 << 14;
+
+  for (Index level_begin = m_capacity / 2; level_begin > 0; level_begin /= 2) {
+    Index level_size = level_begin;
+    int level_n_threads = static_cast<int>(std::min<Index>(
+        n_threads, std::max<Index>(1, level_size / min_nodes_per_thread)));
+    parallel_for_blocks(level_size, level_n_threads,
+                        [&](int thread_index, Index begin, Index end) {
+                          for (Index node = level_begin + begin;
+                               node < level_begin + end; ++node) {
+                            m_tree[node] =
+                                m_tree[2 * node] + m_tree[2 * node + 1];
+                          }
+                        });
+  }
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
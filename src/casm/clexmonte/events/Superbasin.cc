@@ -0,0 +1,158 @@
+#include "casm/clexmonte/events/Superbasin.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <stdexcept>
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Index of the state with `hash`, or -1 if not in the superbasin
+Index Superbasin::find(std::uint64_t hash) const {
+  auto it = m_index.find(hash);
+  if (it == m_index.end()) {
+    return -1;
+  }
+  return it->second;
+}
+
+/// \brief Add a state, if not already present, and return its index
+Index Superbasin::insert(std::uint64_t hash) {
+  auto result = m_index.emplace(hash, Index(m_states.size()));
+  if (result.second) {
+    State state;
+    state.hash = hash;
+    m_states.push_back(state);
+  }
+  return result.first->second;
+}
+
+/// \brief Add an observed transition, if not already present
+///
+/// \param from Index of the initial state
+/// \param event_index The event that occurred
+/// \param rate The rate of the event in the initial state
+/// \param to Index of the final state
+void Superbasin::add_transition(Index from, EventIndex event_index,
+                                double rate, Index to) {
+  std::vector<Transition> &transitions = m_states[from].transitions;
+  for (Transition const &transition : transitions) {
+    if (transition.event_index == event_index) {
+      return;
+    }
+  }
+  transitions.push_back({event_index, rate, to});
+}
+
+/// \brief Remove all states
+void Superbasin::clear() {
+  m_states.clear();
+  m_index.clear();
+}
+
+/// \brief Return true if the total rate of every state is known
+bool Superbasin::is_complete() const {
+  for (State const &state : m_states) {
+    if (!(state.total_rate > 0.0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief Mean rate method: mean exit time and exit probabilities
+///
+/// With `P(i,j)`, the probability that the next transition from state `i`
+/// is to state `j`, the expected number of visits to each state before
+/// exit, starting from state `initial`, is `v = (I - P^T)^-1 e_initial`.
+/// Then the mean exit time is `sum_i v_i / R_i`, and the probability of
+/// exiting from state `i` is `v_i * E_i / R_i`, where `R_i` is the total
+/// rate and `E_i` the exit rate from state `i`.
+///
+/// \param initial Index of the current state
+/// \param mean_exit_time Set to the mean time until exit
+/// \param exit_probability Set to the probability of exiting from each
+///     state
+///
+/// \returns True if successful; false if the total rate of any state is not
+///     known, or if there are no exits
+bool Superbasin::solve(Index initial, double &mean_exit_time,
+                       Eigen::VectorXd &exit_probability) const {
+  if (!is_complete()) {
+    return false;
+  }
+  Index n = size();
+  Eigen::MatrixXd A = Eigen::MatrixXd::Identity(n, n);
+  Eigen::VectorXd exit_rate(n);
+  for (Index i = 0; i < n; ++i) {
+    State const &state = m_states[i];
+    double internal_rate = 0.0;
+    for (Transition const &transition : state.transitions) {
+      A(transition.to, i) -= transition.rate / state.total_rate;
+      internal_rate += transition.rate;
+    }
+    exit_rate(i) = std::max(0.0, state.total_rate - internal_rate);
+  }
+  if (!(exit_rate.sum() > 0.0)) {
+    return false;
+  }
+
+  Eigen::VectorXd e = Eigen::VectorXd::Zero(n);
+  e(initial) = 1.0;
+  Eigen::VectorXd visits = A.fullPivLu().solve(e);
+
+  mean_exit_time = 0.0;
+  exit_probability.resize(n);
+  for (Index i = 0; i < n; ++i) {
+    double total_rate = m_states[i].total_rate;
+    mean_exit_time += visits(i) / total_rate;
+    exit_probability(i) = visits(i) * exit_rate(i) / total_rate;
+  }
+  double sum = exit_probability.sum();
+  if (!std::isfinite(mean_exit_time) || !(mean_exit_time > 0.0) ||
+      !(sum > 0.0) || exit_probability.minCoeff() < -1e-8 * sum) {
+    return false;
+  }
+  exit_probability = exit_probability.cwiseMax(0.0) / sum;
+  return true;
+}
+
+/// \brief Events along a shortest path of observed transitions
+///
+/// \returns The events, in order, along a path with the fewest transitions
+///     from state `begin` to state `end`. Empty if `begin == end`.
+///
+/// Throws if there is no path.
+std::vector<EventIndex> Superbasin::path(Index begin, Index end) const {
+  std::vector<Index> previous(size(), -1);
+  std::vector<EventIndex> previous_event(size());
+  std::vector<bool> visited(size(), false);
+  std::deque<Index> queue;
+  visited[begin] = true;
+  queue.push_back(begin);
+  while (!queue.empty() && !visited[end]) {
+    Index current = queue.front();
+    queue.pop_front();
+    for (Transition const &transition : m_states[current].transitions) {
+      if (!visited[transition.to]) {
+        visited[transition.to] = true;
+        previous[transition.to] = current;
+        previous_event[transition.to] = transition.event_index;
+        queue.push_back(transition.to);
+      }
+    }
+  }
+  if (!visited[end]) {
+    throw std::runtime_error("Error in Superbasin::path: no path");
+  }
+  std::vector<EventIndex> events;
+  for (Index i = end; i != begin; i = previous[i]) {
+    events.push_back(previous_event[i]);
+  }
+  std::reverse(events.begin(), events.end());
+  return events;
+}
+
+}  // namespace clexmonte
+}  // namespace CASM
@@ -3,22 +3,140 @@
 #include "casm/casm_io/container/json_io.hh"
 #include "casm/casm_io/json/InputParser_impl.hh"
 #include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/misc/parse_array.hh"
 
 namespace CASM {
 
+jsonParser &to_json(clexmonte::UnitCellRegion const &region,
+                    jsonParser &json) {
+  json.put_obj();
+  json["min"] = jsonParser::array();
+  json["max"] = jsonParser::array();
+  for (Index d = 0; d < 3; ++d) {
+    json["min"].push_back(region.min(d));
+    json["max"].push_back(region.max(d));
+  }
+  return json;
+}
+
+/// \brief Parse clexmonte::UnitCellRegion from JSON
+///
+/// A region is either a box:
+///
+/// \code
+/// {
+///   "min": [i_min, j_min, k_min], // optional, default unbounded
+///   "max": [i_max, j_max, k_max]  // optional, default unbounded
+/// }
+/// \endcode
+///
+/// or a slab, bounded along one unit cell coordinate axis:
+///
+/// \code
+/// {
+///   "axis": <int>, // 0, 1, or 2
+///   "min": <int>,  // optional, default unbounded
+///   "max": <int>   // optional, default unbounded
+/// }
+/// \endcode
+///
+/// Bounds are inclusive and in terms of unit cell coordinates, as given by
+/// the supercell's unit cell index converter.
+void parse(InputParser<clexmonte::UnitCellRegion> &parser) {
+  auto ptr = std::make_unique<clexmonte::UnitCellRegion>();
+  clexmonte::UnitCellRegion &region = *ptr;
+
+  if (parser.self.contains("axis")) {
+    Index axis;
+    parser.require(axis, "axis");
+    if (parser.valid() && (axis < 0 || axis > 2)) {
+      parser.insert_error("axis", "Error: 'axis' must be 0, 1, or 2");
+    }
+    std::optional<long> min;
+    std::optional<long> max;
+    parser.optional(min, "min");
+    parser.optional(max, "max");
+    if (parser.valid()) {
+      if (min.has_value()) {
+        region.min(axis) = *min;
+      }
+      if (max.has_value()) {
+        region.max(axis) = *max;
+      }
+    }
+  } else {
+    std::optional<std::vector<long>> min;
+    std::optional<std::vector<long>> max;
+    parser.optional(min, "min");
+    parser.optional(max, "max");
+    auto _set = [&](std::optional<std::vector<long>> const &value,
+                    Eigen::Vector3l &bound, std::string key) {
+      if (!value.has_value()) {
+        return;
+      }
+      if (value->size() != 3) {
+        parser.insert_error(key, "Error: '" + key + "' must have size 3");
+        return;
+      }
+      for (Index d = 0; d < 3; ++d) {
+        bound(d) = (*value)[d];
+      }
+    };
+    _set(min, region.min, "min");
+    _set(max, region.max, "max");
+  }
+
+  if (parser.valid()) {
+    parser.value = std::move(ptr);
+  }
+}
+
 jsonParser &to_json(clexmonte::EventFilterGroup const &filter,
                     jsonParser &json) {
   json.put_obj();
   json["unitcell_index"] = filter.unitcell_index;
+  if (!filter.regions.empty()) {
+    json["regions"] = jsonParser::array();
+    for (auto const &region : filter.regions) {
+      jsonParser tjson;
+      json["regions"].push_back(to_json(region, tjson));
+    }
+  }
   json["include_by_default"] = filter.include_by_default;
   json["prim_event_index"] = filter.prim_event_index;
   return json;
 }
 
+/// \brief Parse clexmonte::EventFilterGroup from JSON
+///
+/// \code
+/// {
+///   "unitcell_index": [<int>, ...], // optional, linear unit cell indices
+///   "regions": [<UnitCellRegion>, ...], // optional, boxes or slabs
+///   "include_by_default": <bool>,
+///   "prim_event_index": [<int>, ...]
+/// }
+/// \endcode
+///
+/// The group applies to unit cells listed in "unitcell_index" and to unit
+/// cells in any of the "regions".
 void parse(InputParser<clexmonte::EventFilterGroup> &parser) {
   auto ptr = std::make_unique<clexmonte::EventFilterGroup>();
   clexmonte::EventFilterGroup &filter = *ptr;
-  parser.require(filter.unitcell_index, "unitcell_index");
+  parser.optional(filter.unitcell_index, "unitcell_index");
+  if (parser.self.contains("regions")) {
+    auto subparser =
+        parser.subparse_with<std::vector<clexmonte::UnitCellRegion>>(
+            parse_array<clexmonte::UnitCellRegion>, "regions");
+    if (subparser->valid()) {
+      filter.regions = std::move(*subparser->value);
+    }
+  }
+  if (!parser.self.contains("unitcell_index") &&
+      !parser.self.contains("regions")) {
+    parser.error.insert(
+        "Error: one of 'unitcell_index' or 'regions' is required");
+  }
   parser.require(filter.include_by_default, "include_by_default");
   parser.require(filter.prim_event_index, "prim_event_index");
   if (parser.valid()) {
@@ -0,0 +1,133 @@
+#include "casm/clexmonte/kinetic/EventStateMemo.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#include "casm/casm_io/Log.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+namespace {
+
+std::vector<std::vector<xtal::UnitCellCoord>> _neighborhood_sites(
+    std::vector<EventImpactInfo> const &prim_impact_info_list) {
+  std::vector<std::vector<xtal::UnitCellCoord>> sites;
+  for (EventImpactInfo const &impact_info : prim_impact_info_list) {
+    sites.emplace_back(impact_info.required_update_neighborhood.begin(),
+                       impact_info.required_update_neighborhood.end());
+  }
+  return sites;
+}
+
+}  // namespace
+
+/// \brief Constructor
+///
+/// \param prim_impact_info_list Impact info for the prim events, providing
+///     the required update neighborhood of each prim event
+/// \param unitcell_converter Convert unit cell indices, for the supercell
+/// \param _max_size Maximum number of entries
+/// \param _validate_every If > 0, every `_validate_every`-th hit is
+///     validated
+EventStateMemo::EventStateMemo(
+    std::vector<EventImpactInfo> const &prim_impact_info_list,
+    xtal::UnitCellIndexConverter const &unitcell_converter, Index _max_size,
+    Index _validate_every)
+    : max_size(_max_size),
+      validate_every(_validate_every),
+      m_neighborhood_table(_neighborhood_sites(prim_impact_info_list),
+                           unitcell_converter) {
+  if (max_size < 1) {
+    throw std::runtime_error(
+        "Error constructing EventStateMemo: max_size must be >= 1");
+  }
+}
+
+/// \brief Find memoized values for an event, given the current occupation
+///
+/// \param unitcell_index Linear unit cell index of the event
+/// \param prim_event_index Prim event index of the event
+/// \param occupation The current occupation
+///
+/// \returns Pointer to the memoized values, or nullptr if not found. The
+///     pointer is invalidated by `insert`.
+EventStateMemo::Value const *EventStateMemo::find(
+    Index unitcell_index, Index prim_event_index,
+    PackedOccupation const &occupation) {
+  Index n_sites = m_neighborhood_table.n_sites(prim_event_index);
+  std::uint32_t p = static_cast<std::uint32_t>(prim_event_index);
+  m_key.resize(sizeof(p) + n_sites);
+  std::copy(reinterpret_cast<char const *>(&p),
+            reinterpret_cast<char const *>(&p) + sizeof(p), m_key.begin());
+  for (Index i = 0; i < n_sites; ++i) {
+    m_key[sizeof(p) + i] = static_cast<char>(occupation.get(
+        m_neighborhood_table.linear_site_index(unitcell_index,
+                                               prim_event_index, i)));
+  }
+
+  auto it = m_table.find(m_key);
+  if (it == m_table.end()) {
+    ++n_misses;
+    return nullptr;
+  }
+  ++n_hits;
+  return &it->second;
+}
+
+/// \brief Store values for the key of the last `find`
+void EventStateMemo::insert(Value const &value) {
+  if (m_table.size() >= max_size) {
+    m_table.clear();
+    ++n_clears;
+  }
+  m_table.emplace(m_key, value);
+}
+
+/// \brief Compare memoized and fully calculated values for a hit
+///
+/// Mismatches are counted by `n_validation_failures`.
+void EventStateMemo::validate(Value const &memoized, Value const &calculated) {
+  ++n_validated;
+  bool failed = false;
+  auto _check = [&](double a, double b) {
+    double diff = std::abs(a - b);
+    max_validation_error = std::max(max_validation_error, diff);
+    if (diff > validation_tol * std::max(1.0, std::abs(b))) {
+      failed = true;
+    }
+  };
+  _check(memoized.dE_final, calculated.dE_final);
+  _check(memoized.Ekra, calculated.Ekra);
+  _check(memoized.freq, calculated.freq);
+  if (failed) {
+    ++n_validation_failures;
+  }
+}
+
+/// \brief Print EventStateMemo counters
+void print_summary(Log &log, EventStateMemo const &memo) {
+  Index n_find = memo.n_hits + memo.n_misses;
+  log.custom<Log::standard>("Event state memo summary");
+  log.indent() << "size: " << memo.size() << std::endl;
+  log.indent() << "n_hits: " << memo.n_hits << std::endl;
+  log.indent() << "n_misses: " << memo.n_misses << std::endl;
+  log.indent() << "hit_fraction: "
+               << (n_find ? double(memo.n_hits) / n_find : 0.0) << std::endl;
+  log.indent() << "n_clears: " << memo.n_clears << std::endl;
+  if (memo.validate_every > 0) {
+    log.indent() << "n_validated: " << memo.n_validated << std::endl;
+    log.indent() << "n_validation_failures: " << memo.n_validation_failures
+                 << std::endl;
+    log.indent() << "max_validation_error: " << memo.max_validation_error
+                 << std::endl;
+  }
+  log.indent() << std::endl;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
@@ -0,0 +1,105 @@
+#include "casm/clexmonte/kinetic/KineticReplica.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "casm/clexulator/OrderParameter.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace kinetic {
+
+/// \brief Constructor, basin by occupation hash
+///
+/// \param is_ignored Occupants ignored by the hash, as
+///     `is_ignored[sublattice_index][occupant_index]` (i.e. as from
+///     `make_is_defect`)
+/// \param n_unitcells Number of unit cells in the supercell
+ReplicaBasin::ReplicaBasin(std::vector<std::vector<bool>> const &is_ignored,
+                           Index n_unitcells)
+    : m_is_ignored(is_ignored),
+      m_n_unitcells(n_unitcells),
+      m_value(0),
+      m_tol(0.0) {}
+
+/// \brief Constructor, basin by binned order parameter values
+///
+/// \param order_parameter Order parameter calculator, which is copied so
+///     that each replica's basin uses its own calculator
+/// \param tol Bin width, must be > 0.0
+ReplicaBasin::ReplicaBasin(clexulator::OrderParameter const &order_parameter,
+                           double tol)
+    : m_n_unitcells(0),
+      m_value(0),
+      m_order_parameter(
+          std::make_unique<clexulator::OrderParameter>(order_parameter)),
+      m_tol(tol) {
+  if (!(m_tol > 0.0)) {
+    throw std::runtime_error(
+        "Error constructing ReplicaBasin: requires tol > 0.0");
+  }
+}
+
+ReplicaBasin::ReplicaBasin(ReplicaBasin const &other)
+    : m_is_ignored(other.m_is_ignored),
+      m_n_unitcells(other.m_n_unitcells),
+      m_value(other.m_value),
+      m_tol(other.m_tol) {
+  if (other.m_order_parameter) {
+    m_order_parameter = std::make_unique<clexulator::OrderParameter>(
+        *other.m_order_parameter);
+  }
+}
+
+ReplicaBasin &ReplicaBasin::operator=(ReplicaBasin const &other) {
+  if (this != &other) {
+    m_is_ignored = other.m_is_ignored;
+    m_n_unitcells = other.m_n_unitcells;
+    m_value = other.m_value;
+    m_tol = other.m_tol;
+    m_order_parameter.reset();
+    if (other.m_order_parameter) {
+      m_order_parameter = std::make_unique<clexulator::OrderParameter>(
+          *other.m_order_parameter);
+    }
+  }
+  return *this;
+}
+
+ReplicaBasin::~ReplicaBasin() = default;
+
+/// \brief Reset for the occupation of `state`, which must remain valid
+void ReplicaBasin::reset(state_type const &state) {
+  if (m_order_parameter) {
+    m_order_parameter->set(&get_dof_values(state));
+    return;
+  }
+  Eigen::VectorXi const &occupation = get_occupation(state);
+  m_value = 0;
+  for (Index l = 0; l < occupation.size(); ++l) {
+    m_value ^= _site_value(l, occupation(l));
+  }
+}
+
+/// \brief Basin of the current occupation
+///
+/// For the order parameter method, this is a hash of the bin indices of the
+/// order parameter components, re-calculated from the current occupation.
+std::uint64_t ReplicaBasin::value() const {
+  if (!m_order_parameter) {
+    return m_value;
+  }
+  Eigen::VectorXd const &eta = m_order_parameter->value();
+  std::uint64_t result = 0;
+  for (Index i = 0; i < eta.size(); ++i) {
+    auto bin = static_cast<std::int64_t>(std::floor(eta(i) / m_tol));
+    result = OccupationHash::site_value(
+        static_cast<Index>(result ^ static_cast<std::uint64_t>(bin)),
+        static_cast<int>(i));
+  }
+  return result;
+}
+
+}  // namespace kinetic
+}  // namespace clexmonte
+}  // namespace CASM
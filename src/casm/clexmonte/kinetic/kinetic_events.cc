@@ -1,7 +1,12 @@
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 
+#include <algorithm>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/events/PrimEventCache.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/kinetic/io/stream/EventState_stream_io.hh"
+#include "casm/clexmonte/misc/exp_batch.hh"
 #include "casm/clexmonte/state/Conditions.hh"
 #include "casm/clexmonte/system/System.hh"
 
@@ -9,46 +14,146 @@ namespace CASM {
 namespace clexmonte {
 namespace kinetic {
 
+namespace {
+
+/// \brief Evaluate sparse coefficients dotted with correlations
+double _sparse_dot(clexulator::SparseCoefficients const &coefficients,
+                   Eigen::VectorXd const &corr) {
+  double value = 0.0;
+  for (Index i = 0; i < coefficients.index.size(); ++i) {
+    value += coefficients.value[i] * corr[coefficients.index[i]];
+  }
+  return value;
+}
+
+}  // namespace
+
+/// \brief Re-calculate all rates for a new temperature
+///
+/// Rates are calculated from the stored activation energies and attempt
+/// frequencies, `rate = freq * exp(-beta * dE_activated)`, using
+/// `exp_batch`. Events which are not allowed have rate 0.0.
+///
+/// \param beta The new value of 1/(k_B*T)
+void EventStateCache::rescale_rates(double beta) {
+  Index n = size();
+  std::vector<double> exponent(n);
+  for (Index i = 0; i < n; ++i) {
+    exponent[i] = -beta * dE_activated[i];
+  }
+  exp_batch(exponent.data(), exponent.data(), n);
+  for (Index i = 0; i < n; ++i) {
+    rate[i] = (flags[i] & allowed) ? freq[i] * exponent[i] : 0.0;
+  }
+}
+
 /// \brief Constructor
 EventStateCalculator::EventStateCalculator(std::shared_ptr<system_type> _system,
                                            std::string _event_type_name)
     : m_system(_system), m_event_type_name(_event_type_name) {}
 
 /// \brief Reset pointer to state currently being calculated
+///
+/// Notes:
+/// - If `independent_clex` is true, the cluster expansion calculators have
+///   their own copies of the Clexulator, so that this EventStateCalculator
+///   can be used by a different thread than other calculators for the same
+///   supercell
 void EventStateCalculator::set(state_type const *state,
-                               std::shared_ptr<Conditions> conditions) {
+                               std::shared_ptr<Conditions> conditions,
+                               bool independent_clex) {
   // supercell-specific
   m_state = state;
   if (m_state == nullptr) {
     throw std::runtime_error(
         "Error setting EventStateCalculator state: state is empty");
   }
-  m_formation_energy_clex = get_clex(*m_system, *m_state, "formation_energy");
+  if (independent_clex) {
+    m_formation_energy_clex =
+        make_clex(*m_system, *m_state, "formation_energy");
+  } else {
+    m_formation_energy_clex =
+        get_clex(*m_system, *m_state, "formation_energy");
+  }
 
   // set and validate event clex
+  //
+  // Only the "kra" and "freq" coefficient sets are used, so rather than
+  // evaluating the full local multi-cluster expansion, the local
+  // correlations with non-zero "kra" or "freq" coefficients are evaluated
+  // once per event and shared by both.
   LocalMultiClexData event_local_multiclex_data =
       get_local_multiclex_data(*m_system, m_event_type_name);
-  m_event_clex = get_local_multiclex(*m_system, *m_state, m_event_type_name);
+  std::string const &local_basis_set_name =
+      event_local_multiclex_data.local_basis_set_name;
+  if (independent_clex) {
+    m_event_corr = make_local_corr(*m_system, *m_state, local_basis_set_name);
+  } else {
+    m_event_corr = get_local_corr(*m_system, *m_state, local_basis_set_name);
+  }
   std::map<std::string, Index> _glossary =
       event_local_multiclex_data.coefficients_glossary;
+  std::vector<clexulator::SparseCoefficients> const &_coefficients =
+      event_local_multiclex_data.coefficients;
 
-  auto _check_coeffs = [&](Index &coeff_index, std::string key) {
+  auto _get_coeffs = [&](clexulator::SparseCoefficients &coeffs,
+                         std::string key) {
     if (!_glossary.count(key)) {
       std::stringstream ss;
       ss << "Error constructing " << m_event_type_name
          << " EventStateCalculator: No " << key << " cluster expansion";
       throw std::runtime_error(ss.str());
     }
-    coeff_index = _glossary.at(key);
-    if (coeff_index < 0 || coeff_index >= m_event_clex->coefficients().size()) {
+    Index coeff_index = _glossary.at(key);
+    if (coeff_index < 0 || coeff_index >= _coefficients.size()) {
       std::stringstream ss;
       ss << "Error constructing " << m_event_type_name
          << " EventStateCalculator: " << key << " index out of range";
       throw std::runtime_error(ss.str());
     }
+
+    // keep non-zero coefficients only
+    clexulator::SparseCoefficients const &all = _coefficients[coeff_index];
+    std::vector<unsigned int> index;
+    std::vector<double> value;
+    for (Index i = 0; i < all.index.size(); ++i) {
+      if (all.value[i] != 0.0) {
+        index.push_back(all.index[i]);
+        value.push_back(all.value[i]);
+      }
+    }
+    coeffs.index = index;
+    coeffs.value.resize(value.size());
+    for (Index i = 0; i < value.size(); ++i) {
+      coeffs.value[i] = value[i];
+    }
   };
-  _check_coeffs(m_kra_index, "kra");
-  _check_coeffs(m_freq_index, "freq");
+  _get_coeffs(m_kra_coefficients, "kra");
+  _get_coeffs(m_freq_coefficients, "freq");
+
+  // constant attempt frequency: no non-zero coefficients, or only the
+  // constant basis function (correlation index 0)
+  m_is_constant_freq = false;
+  m_constant_freq = 0.0;
+  if (m_freq_coefficients.index.size() == 0) {
+    m_is_constant_freq = true;
+  } else if (m_freq_coefficients.index.size() == 1 &&
+             m_freq_coefficients.index[0] == 0) {
+    m_is_constant_freq = true;
+    m_constant_freq = m_freq_coefficients.value[0];
+  }
+
+  // local correlations needed by the KRA and attempt frequency
+  m_corr_indices = m_kra_coefficients.index;
+  if (!m_is_constant_freq) {
+    m_corr_indices.insert(m_corr_indices.end(),
+                          m_freq_coefficients.index.begin(),
+                          m_freq_coefficients.index.end());
+  }
+  std::sort(m_corr_indices.begin(), m_corr_indices.end());
+  m_corr_indices.erase(
+      std::unique(m_corr_indices.begin(), m_corr_indices.end()),
+      m_corr_indices.end());
 
   // conditions-specific
   m_conditions = conditions;
@@ -66,46 +171,94 @@ std::shared_ptr<Conditions> const &EventStateCalculator::conditions() const {
 ///
 /// \param state Stores whether the event is allowed, is "normal",
 ///     energy barriers, and event rate
-/// \param event_data Holds information about the particular translational
-///     instance of the event, such as linear sites indices and linear
-///     unitcell index, necessary for calculating event state.
+/// \param unitcell_index Linear unit cell index of the particular
+///     translational instance of the event
+/// \param linear_site_index Linear site indices of the event sites, for the
+///     particular translational instance of the event
 /// \param prim_event_data Holds information about the event that does not
 ///     depend on the particular translational instance, such as the
 ///     initial and final occupation variables.
 void EventStateCalculator::calculate_event_state(
-    EventState &state, EventData const &event_data,
+    EventState &state, Index unitcell_index,
+    std::vector<Index> const &linear_site_index,
+    PrimEventData const &prim_event_data) const {
+  if (!calculate_activation(state, unitcell_index, linear_site_index,
+                            prim_event_data)) {
+    return;
+  }
+  state.rate = state.freq * exp(-m_conditions->beta * state.dE_activated);
+}
+
+/// \brief Calculate the state of an event, except for the rate
+///
+/// This is used to calculate event rates in batches, by calculating the
+/// activation energy and attempt frequency of each event in the batch, and
+/// then evaluating the Arrhenius factors together.
+///
+/// \param state Stores whether the event is allowed, is "normal", and energy
+///     barriers. If the event is not allowed, `state.rate` is set to 0.0;
+///     otherwise, `state.rate` is not set.
+/// \param unitcell_index Linear unit cell index of the particular
+///     translational instance of the event
+/// \param linear_site_index Linear site indices of the event sites, for the
+///     particular translational instance of the event
+/// \param prim_event_data Holds information about the event that does not
+///     depend on the particular translational instance.
+///
+/// \returns state.is_allowed
+bool EventStateCalculator::calculate_activation(
+    EventState &state, Index unitcell_index,
+    std::vector<Index> const &linear_site_index,
     PrimEventData const &prim_event_data) const {
   clexulator::ConfigDoFValues const *dof_values =
       m_formation_energy_clex->get();
 
   int i = 0;
-  for (Index l : event_data.event.linear_site_index) {
+  for (Index l : linear_site_index) {
     if (dof_values->occupation(l) != prim_event_data.occ_init[i]) {
       state.is_allowed = false;
       state.rate = 0.0;
-      return;
+      return false;
     }
     ++i;
   }
+  calculate_allowed_activation(state, unitcell_index, linear_site_index,
+                               prim_event_data);
+  return true;
+}
+
+/// \brief Calculate the state of an event that is known to be allowed,
+///     except for the rate
+///
+/// This is the same as `calculate_activation`, without checking that the
+/// current occupation matches the event's initial occupation. It is used
+/// when that has already been checked, i.e. with a PackedOccupation.
+void EventStateCalculator::calculate_allowed_activation(
+    EventState &state, Index unitcell_index,
+    std::vector<Index> const &linear_site_index,
+    PrimEventData const &prim_event_data) const {
   state.is_allowed = true;
 
   // calculate change in energy to final state
   state.dE_final = m_formation_energy_clex->occ_delta_value(
-      event_data.event.linear_site_index, prim_event_data.occ_final);
-
-  // calculate KRA and attempt frequency
-  Eigen::VectorXd const &event_values = m_event_clex->values(
-      event_data.unitcell_index, prim_event_data.equivalent_index);
-  state.Ekra = event_values[m_kra_index];
-  state.freq = event_values[m_freq_index];
-
-  // calculate energy in activated state, check if "normal", calculate rate
-  state.dE_activated = state.dE_final * 0.5 + state.Ekra;
-  state.is_normal =
-      (state.dE_activated > 0.0) && (state.dE_activated > state.dE_final);
-  if (state.dE_activated < state.dE_final) state.dE_activated = state.dE_final;
-  if (state.dE_activated < 0.0) state.dE_activated = 0.0;
-  state.rate = state.freq * exp(-m_conditions->beta * state.dE_activated);
+      linear_site_index, prim_event_data.occ_final);
+
+  // calculate KRA and attempt frequency, from the needed local
+  // correlations only
+  if (m_corr_indices.empty()) {
+    state.Ekra = 0.0;
+    state.freq = m_constant_freq;
+  } else {
+    Eigen::VectorXd const &corr = m_event_corr->restricted_local(
+        unitcell_index, prim_event_data.equivalent_index,
+        m_corr_indices.data(), m_corr_indices.data() + m_corr_indices.size());
+    state.Ekra = _sparse_dot(m_kra_coefficients, corr);
+    state.freq = m_is_constant_freq ? m_constant_freq
+                                    : _sparse_dot(m_freq_coefficients, corr);
+  }
+
+  // calculate energy in activated state, check if "normal"
+  set_activation_energy(state);
 }
 
 /// \brief Construct a vector EventStateCalculator, one per event in a
@@ -113,12 +266,12 @@ void EventStateCalculator::calculate_event_state(
 std::vector<EventStateCalculator> make_prim_event_calculators(
     std::shared_ptr<system_type> system, state_type const &state,
     std::vector<PrimEventData> const &prim_event_list,
-    std::shared_ptr<Conditions> conditions) {
+    std::shared_ptr<Conditions> conditions, bool independent_clex) {
   std::vector<EventStateCalculator> prim_event_calculators;
   for (auto const &prim_event_data : prim_event_list) {
     prim_event_calculators.emplace_back(system,
                                         prim_event_data.event_type_name);
-    prim_event_calculators.back().set(&state, conditions);
+    prim_event_calculators.back().set(&state, conditions, independent_clex);
   }
   return prim_event_calculators;
 }
@@ -128,37 +281,186 @@ std::vector<EventStateCalculator> make_prim_event_calculators(
 CompleteEventCalculator::CompleteEventCalculator(
     std::vector<PrimEventData> const &_prim_event_list,
     std::vector<EventStateCalculator> const &_prim_event_calculators,
-    std::map<EventID, EventData> const &_event_list, Log &_event_log)
+    CompleteEventList const &_event_list, Log &_event_log)
     : prim_event_list(_prim_event_list),
       prim_event_calculators(_prim_event_calculators),
       event_list(_event_list),
       event_log(_event_log),
-      not_normal_count(0) {}
-
-/// \brief Get CASM::monte::OccEvent corresponding to given event ID
-double CompleteEventCalculator::calculate_rate(EventID const &id) {
-  EventData const &event_data = event_list.at(id);
-  PrimEventData const &prim_event_data =
-      prim_event_list.at(id.prim_event_index);
-  // Note: to keep all event state calculations, uncomment this:
-  // EventState &event_state = event_data.event_state;
-  prim_event_calculators.at(id.prim_event_index)
-      .calculate_event_state(event_state, event_data, prim_event_data);
+      not_normal_count(0) {
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    occ_init_signatures.emplace_back(prim_event_data.occ_init);
+  }
+}
+
+/// \brief Calculate the rate of an event
+///
+/// Notes:
+/// - Events excluded by event filters have rate 0.0
+/// - If `packed_occupation` is set, it is used to check if the event is
+///   allowed before calculating the event state
+/// - If `event_state_cache` is set, the event state is stored in it
+double CompleteEventCalculator::calculate_rate(EventIndex event_index) {
+  if (_calculate_activation(event_index)) {
+    Index prim_event_index = event_index % event_list.n_prim_events;
+    event_state.rate =
+        event_state.freq *
+        exp(-prim_event_calculators[prim_event_index].conditions()->beta *
+            event_state.dE_activated);
+  }
+  if (event_state_cache) {
+    event_state_cache->set(event_index, event_state);
+  }
+  return event_state.rate;
+}
+
+/// \brief Calculate the rates of a batch of events
+///
+/// This gives the same rates as calling `calculate_rate` for each event, to
+/// within a few ulp, but the activation energies of all allowed events in
+/// the batch are calculated first and then the Arrhenius factors are
+/// evaluated together with `exp_batch`, which is vectorized.
+///
+/// \param event_index_list The events, as from an impact table
+/// \param rates Set to the rates of the events in `event_index_list`
+void CompleteEventCalculator::calculate_rates(
+    EventIndexRange event_index_list, std::vector<double> &rates) {
+  Index n = event_index_list.size();
+  rates.assign(n, 0.0);
+  m_batch_exponent.clear();
+  m_batch_freq.clear();
+  m_batch_position.clear();
+  for (Index i = 0; i < n; ++i) {
+    EventIndex event_index = event_index_list[i];
+    if (!_calculate_activation(event_index)) {
+      if (event_state_cache) {
+        event_state_cache->set(event_index, event_state);
+      }
+      continue;
+    }
+    Index prim_event_index = event_index % event_list.n_prim_events;
+    m_batch_exponent.push_back(
+        -prim_event_calculators[prim_event_index].conditions()->beta *
+        event_state.dE_activated);
+    m_batch_freq.push_back(event_state.freq);
+    m_batch_position.push_back(i);
+    if (event_state_cache) {
+      event_state_cache->set(event_index, event_state);
+    }
+  }
+
+  exp_batch(m_batch_exponent.data(), m_batch_exponent.data(),
+            m_batch_exponent.size());
+  for (Index k = 0; k < m_batch_position.size(); ++k) {
+    double rate = m_batch_freq[k] * m_batch_exponent[k];
+    rates[m_batch_position[k]] = rate;
+    if (event_state_cache) {
+      event_state_cache->rate[event_index_list[m_batch_position[k]]] = rate;
+    }
+  }
+}
+
+/// \brief Check if an event is included and allowed, and if so calculate
+///     `event_state` except for the rate
+///
+/// Non-normal events are written to `event_log` and counted.
+bool CompleteEventCalculator::_calculate_activation(EventIndex event_index) {
+  if (!event_list.is_included[event_index]) {
+    event_state.is_allowed = false;
+    event_state.rate = 0.0;
+    return false;
+  }
+  Index prim_event_index = event_index % event_list.n_prim_events;
+  Index unitcell_index = event_index / event_list.n_prim_events;
+  event_list.site_table.set_linear_site_index(linear_site_index,
+                                              unitcell_index, prim_event_index);
+  PrimEventData const &prim_event_data = prim_event_list[prim_event_index];
+  if (packed_occupation &&
+      !packed_occupation->matches(linear_site_index,
+                                  occ_init_signatures[prim_event_index])) {
+    event_state.is_allowed = false;
+    event_state.rate = 0.0;
+    return false;
+  }
+  if (event_state_memo && packed_occupation) {
+    EventStateMemo::Value const *memoized = event_state_memo->find(
+        unitcell_index, prim_event_index, *packed_occupation);
+    if (memoized && !event_state_memo->validate_hit()) {
+      event_state.is_allowed = true;
+      event_state.dE_final = memoized->dE_final;
+      event_state.Ekra = memoized->Ekra;
+      event_state.freq = memoized->freq;
+      set_activation_energy(event_state);
+    } else {
+      prim_event_calculators[prim_event_index].calculate_allowed_activation(
+          event_state, unitcell_index, linear_site_index, prim_event_data);
+      EventStateMemo::Value calculated{event_state.dE_final, event_state.Ekra,
+                                       event_state.freq};
+      if (memoized) {
+        event_state_memo->validate(*memoized, calculated);
+      } else {
+        event_state_memo->insert(calculated);
+      }
+    }
+  } else if (packed_occupation) {
+    prim_event_calculators[prim_event_index].calculate_allowed_activation(
+        event_state, unitcell_index, linear_site_index, prim_event_data);
+  } else if (!prim_event_calculators[prim_event_index].calculate_activation(
+                 event_state, unitcell_index, linear_site_index,
+                 prim_event_data)) {
+    return false;
+  }
 
   // ---
   // can check event state and handle non-normal event states here
   // ---
-  if (event_state.is_allowed && !event_state.is_normal) {
-    event_log << "---" << std::endl;
-    print(event_log.ostream(), event_state, event_data, prim_event_data);
-    event_log << std::endl;
-    ++not_normal_count;
+  if (!event_state.is_normal) {
+    _log_not_normal(event_state, unitcell_index, prim_event_data);
   }
+  return true;
+}
 
-  return event_state.rate;
+/// \brief Log and count the non-normal events stored in an event state
+///     cache, as if their rates were calculated
+///
+/// When initial rates are rescaled from a complete event state cache
+/// instead of calculated, this reports the same non-normal events as a full
+/// calculation would.
+void CompleteEventCalculator::log_not_normal(EventStateCache const &cache) {
+  for (Index i = 0; i < cache.size(); ++i) {
+    if ((cache.flags[i] & EventStateCache::allowed) &&
+        !(cache.flags[i] & EventStateCache::normal)) {
+      Index prim_event_index = i % event_list.n_prim_events;
+      Index unitcell_index = i / event_list.n_prim_events;
+      event_list.site_table.set_linear_site_index(
+          linear_site_index, unitcell_index, prim_event_index);
+      _log_not_normal(cache.get(EventIndex(i)), unitcell_index,
+                      prim_event_list[prim_event_index]);
+    }
+  }
+}
+
+/// \brief Log and count a non-normal event, with sites `linear_site_index`
+void CompleteEventCalculator::_log_not_normal(
+    EventState const &state, Index unitcell_index,
+    PrimEventData const &prim_event_data) {
+  EventData event_data;
+  event_data.unitcell_index = unitcell_index;
+  event_data.event.linear_site_index = linear_site_index;
+  event_log << "---" << std::endl;
+  print(event_log.ostream(), state, event_data, prim_event_data);
+  event_log << std::endl;
+  ++not_normal_count;
 }
 
-KineticEventData::KineticEventData(std::shared_ptr<system_type> _system)
+/// \brief Constructor
+///
+/// \param _system The system
+/// \param event_cache_dir If not empty, prim event impact info and the
+///     relative impact table are read from a cache in this directory if
+///     available and consistent with the system, else they are calculated
+///     and written to the cache. See `make_prim_event_cache_data`.
+KineticEventData::KineticEventData(std::shared_ptr<system_type> _system,
+                                   std::string const &event_cache_dir)
     : system(_system) {
   if (!is_clex_data(*system, "formation_energy")) {
     throw std::runtime_error(
@@ -166,31 +468,125 @@ KineticEventData::KineticEventData(std::shared_ptr<system_type> _system)
   }
 
   prim_event_list = clexmonte::make_prim_event_list(*system);
-  prim_impact_info_list = clexmonte::make_prim_impact_info_list(
-      *system, prim_event_list, {"formation_energy"});
+  PrimEventCacheData cache_data = clexmonte::make_prim_event_cache_data(
+      *system, prim_event_list, {"formation_energy"}, {}, event_cache_dir);
+  prim_impact_info_list = std::move(cache_data.prim_impact_info_list);
+  relative_impact_table = std::move(cache_data.relative_impact_table);
 }
 
 /// \brief Update for given state, conditions, and occupants
 ///
 /// This must be called before first use and when changing supercells,
 /// conditions, etc. to build the event list and event calculator
+///
+/// If `with_impact_table` is false, the event list is constructed without an
+/// impact table, which is sufficient for rejection KMC.
 void KineticEventData::update(
     state_type const &state, std::shared_ptr<Conditions> conditions,
     monte::OccLocation const &occ_location,
-    std::vector<EventFilterGroup> const &event_filters) {
+    std::vector<EventFilterGroup> const &event_filters, int n_threads,
+    bool with_impact_table) {
   // These are constructed/re-constructed so cluster expansions point
   // at the current state
   prim_event_calculators = clexmonte::kinetic::make_prim_event_calculators(
       system, state, prim_event_list, conditions);
+  event_state_cache.reset();
+  event_state_memo.reset();
 
-  // TODO: rejection-clexmonte option does not require impact table
   event_list = clexmonte::make_complete_event_list(
-      prim_event_list, prim_impact_info_list, occ_location, event_filters);
+      prim_event_list, relative_impact_table, occ_location, event_filters,
+      n_threads, with_impact_table);
+  print_timing(CASM::log(), event_list);
 
   // Construct CompleteEventCalculator
   event_calculator =
       std::make_shared<clexmonte::kinetic::CompleteEventCalculator>(
-          prim_event_list, prim_event_calculators, event_list.events);
+          prim_event_list, prim_event_calculators, event_list);
+}
+
+/// \brief Construct event calculators for use by separate threads
+///
+/// Notes:
+/// - Each calculator has independent cluster expansion calculators, so they
+///   may be used concurrently to calculate event rates for the current state
+/// - The calculators are valid until this is called again or `update` is
+///   called
+/// - Non-normal events are counted, but not written to the event log
+///
+/// \param state The state, which must have the same supercell as was used
+///     to `update`
+/// \param conditions The conditions
+/// \param n_threads Number of calculators to construct
+std::vector<std::shared_ptr<CompleteEventCalculator>>
+KineticEventData::make_thread_event_calculators(
+    state_type const &state, std::shared_ptr<Conditions> conditions,
+    int n_threads) {
+  thread_prim_event_calculators.clear();
+  thread_prim_event_calculators.reserve(n_threads);
+  std::vector<std::shared_ptr<CompleteEventCalculator>> thread_calculators;
+  for (int i = 0; i < n_threads; ++i) {
+    thread_prim_event_calculators.push_back(
+        clexmonte::kinetic::make_prim_event_calculators(
+            system, state, prim_event_list, conditions,
+            true /*independent_clex*/));
+    thread_calculators.push_back(
+        std::make_shared<clexmonte::kinetic::CompleteEventCalculator>(
+            prim_event_list, thread_prim_event_calculators.back(), event_list,
+            CASM::null_log()));
+  }
+  return thread_calculators;
+}
+
+/// \brief Make rejection KMC rate upper bounds, by prim event index
+///
+/// All prim events of the same event type have the same upper bound.
+///
+/// \param prim_event_list The prim event list
+/// \param event_type_rate_upper_bound Specified rate upper bounds, by event
+///     type name. Event types not included are calibrated.
+/// \param calibrated_rate The maximum rate of each prim event in a
+///     calibration sweep, as from `calibrate_prim_event_rate_upper_bound`.
+///     May be empty if all event types are specified.
+/// \param calibration_factor Calibrated upper bounds are
+///     `calibration_factor` times the maximum calibrated rate of any prim
+///     event of the same type, or, if that is zero (no events of that type
+///     were allowed), of any prim event.
+std::vector<double> make_prim_event_rate_upper_bound(
+    std::vector<PrimEventData> const &prim_event_list,
+    std::map<std::string, double> const &event_type_rate_upper_bound,
+    std::vector<double> const &calibrated_rate, double calibration_factor) {
+  std::map<std::string, double> type_max_rate;
+  double max_rate = 0.0;
+  for (Index i = 0; i < calibrated_rate.size(); ++i) {
+    double &value = type_max_rate[prim_event_list[i].event_type_name];
+    value = std::max(value, calibrated_rate[i]);
+    max_rate = std::max(max_rate, calibrated_rate[i]);
+  }
+
+  std::vector<double> upper_bound;
+  for (PrimEventData const &prim_event_data : prim_event_list) {
+    std::string const &name = prim_event_data.event_type_name;
+    auto it = event_type_rate_upper_bound.find(name);
+    if (it != event_type_rate_upper_bound.end()) {
+      upper_bound.push_back(it->second);
+      continue;
+    }
+    if (calibrated_rate.size() != prim_event_list.size()) {
+      std::stringstream ss;
+      ss << "Error in make_prim_event_rate_upper_bound: no rate upper bound "
+            "for event type '"
+         << name << "'";
+      throw std::runtime_error(ss.str());
+    }
+    double rate = type_max_rate[name] > 0.0 ? type_max_rate[name] : max_rate;
+    if (!(rate > 0.0)) {
+      throw std::runtime_error(
+          "Error in make_prim_event_rate_upper_bound: no allowed events to "
+          "calibrate rate upper bounds");
+    }
+    upper_bound.push_back(calibration_factor * rate);
+  }
+  return upper_bound;
 }
 
 }  // namespace kinetic
@@ -27,10 +27,27 @@ BaseMonteCalculator::BaseMonteCalculator(
       optional_params(_optional_params),
       time_sampling_allowed(_time_sampling_allowed),
       update_species(_update_species),
+      run_info(jsonParser::object()),
       is_multistate_method(_is_multistate_method) {}
 
 BaseMonteCalculator::~BaseMonteCalculator() {}
 
+/// \brief Perform a single run, evolving multiple states, each sampled by
+///     its own run manager
+///
+/// The default implementation throws. Multi-state methods that sample
+/// more than one state override this.
+void BaseMonteCalculator::run(
+    std::vector<state_type> &states,
+    std::vector<monte::OccLocation> &occ_locations,
+    std::vector<std::shared_ptr<run_manager_type<engine_type>>>
+        &run_managers) {
+  std::stringstream msg;
+  msg << "Error: " << this->calculator_name
+      << " does not allow multi-state runs with multiple run managers";
+  throw std::runtime_error(msg.str());
+}
+
 /// \brief Standardized check for whether system has required data
 void BaseMonteCalculator::_check_system() const {
   for (std::string const &key : this->required_basis_set) {
@@ -0,0 +1,654 @@
+#include <cmath>
+#include <utility>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/casm_io/container/json_io.hh"
+#include "casm/clexmonte/misc/parallel.hh"
+#include "casm/clexmonte/monte_calculator/BaseMonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/MonteCalculator.hh"
+#include "casm/clexmonte/monte_calculator/analysis_functions.hh"
+#include "casm/clexmonte/monte_calculator/sampling_functions.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/semigrand_canonical/event_generator.hh"
+#include "casm/configuration/io/json/Configuration_json_io.hh"
+#include "casm/monte/events/OccEventProposal.hh"
+#include "casm/monte/methods/metropolis.hh"
+#include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+
+namespace CASM {
+namespace clexmonte {
+
+/// \brief Semi-grand canonical potential for one replica
+///
+/// Notes:
+/// - Unlike SemiGrandCanonicalPotential, this uses the formation energy
+///   calculator of `state_data`, which has its own Clexulator, so the
+///   potentials of different replicas may be used by separate threads
+class ParallelTemperingPotential : public BaseMontePotential {
+ public:
+  ParallelTemperingPotential(std::shared_ptr<StateData> _state_data)
+      : BaseMontePotential(_state_data),
+        state(*state_data->state),
+        n_unitcells(state_data->n_unitcells),
+        occupation(get_occupation(state)),
+        convert(*state_data->convert),
+        composition_calculator(
+            get_composition_calculator(*this->state_data->system)),
+        composition_converter(
+            get_composition_converter(*this->state_data->system)),
+        param_chem_pot(state.conditions.vector_values.at("param_chem_pot")),
+        formation_energy_clex(state_data->clex.at("formation_energy")) {
+    if (param_chem_pot.size() !=
+        composition_converter.independent_compositions()) {
+      throw std::runtime_error(
+          "Error in ParallelTemperingPotential: param_chem_pot size error");
+    }
+
+    exchange_chem_pot =
+        make_exchange_chemical_potential(param_chem_pot, composition_converter);
+  }
+
+  // --- Data used in the potential calculation: ---
+
+  state_type const &state;
+  Index n_unitcells;
+  Eigen::VectorXi const &occupation;
+  monte::Conversions const &convert;
+  composition::CompositionCalculator const &composition_calculator;
+  composition::CompositionConverter const &composition_converter;
+  Eigen::VectorXd param_chem_pot;
+  std::shared_ptr<clexulator::ClusterExpansion> formation_energy_clex;
+  Eigen::MatrixXd exchange_chem_pot;
+
+  /// \brief Calculate (per_supercell) potential value
+  double per_supercell() override {
+    Eigen::VectorXd mol_composition =
+        composition_calculator.mean_num_each_component(occupation);
+    Eigen::VectorXd param_composition =
+        composition_converter.param_composition(mol_composition);
+
+    return formation_energy_clex->per_supercell() -
+           n_unitcells * param_chem_pot.dot(param_composition);
+  }
+
+  /// \brief Calculate (per_unitcell) potential value
+  double per_unitcell() override { return this->per_supercell() / n_unitcells; }
+
+  /// \brief Calculate change in (per_supercell) semi-grand potential value due
+  ///     to a series of occupation changes
+  double occ_delta_per_supercell(std::vector<Index> const &linear_site_index,
+                                 std::vector<int> const &new_occ) override {
+    double delta_formation_energy =
+        formation_energy_clex->occ_delta_value(linear_site_index, new_occ);
+    double delta_potential_energy = delta_formation_energy;
+    for (Index i = 0; i < linear_site_index.size(); ++i) {
+      Index l = linear_site_index[i];
+      Index asym = convert.l_to_asym(l);
+      Index curr_species = convert.species_index(asym, occupation(l));
+      Index new_species = convert.species_index(asym, new_occ[i]);
+      delta_potential_energy -= exchange_chem_pot(new_species, curr_species);
+    }
+
+    return delta_potential_energy;
+  }
+};
+
+/// \brief Implements semi-grand canonical replica exchange (parallel
+///     tempering) Monte Carlo calculations
+///
+/// Each replica is a state in the same supercell, with its own
+/// conditions (temperature and param_chem_pot). Replicas run Metropolis
+/// steps concurrently, on up to `n_threads` threads, for `swap_interval`
+/// passes. Then exchanges of configurations between replicas adjacent in
+/// the input order are attempted, alternating between even and odd pairs,
+/// and accepted with probability `min(1, exp(-delta))`, where
+/// `delta = beta_i * (pot_i(x_j) - pot_i(x_i)) +
+/// beta_j * (pot_j(x_i) - pot_j(x_j))`. Replicas should be ordered by
+/// temperature (or chemical potential), with neighbors close enough that
+/// their energy distributions overlap.
+///
+/// Results are collected for each replica with a run manager, by its
+/// conditions. The accepted events of each replica are recorded while the
+/// replicas run concurrently, then reverted and replayed in order, one step
+/// at a time, so that samples and completion checks see the state after
+/// each step, as for sequential Metropolis. When the run manager of a
+/// replica is complete, the replica is finalized and frozen at the step it
+/// completed: it runs no more steps and is not included in exchanges.
+/// Replicas without a run manager run until all replicas with one are
+/// finalized.
+///
+/// The number of attempted and accepted exchanges between each pair of
+/// adjacent replicas is logged and stored in `run_info`.
+class ParallelTemperingCalculator : public BaseMonteCalculator {
+ public:
+  using BaseMonteCalculator::engine_type;
+
+  ParallelTemperingCalculator()
+      : BaseMonteCalculator("ParallelTemperingCalculator",  // calculator_name
+                            {},                    // required_basis_set,
+                            {},                    // required_local_basis_set,
+                            {"formation_energy"},  // required_clex,
+                            {},                    // required_multiclex,
+                            {},                    // required_local_clex,
+                            {},                    // required_local_multiclex,
+                            {},                    // required_dof_spaces,
+                            {},                    // required_params,
+                            {"verbosity", "swap_interval",
+                             "n_threads"},  // optional_params,
+                            false,          // time_sampling_allowed,
+                            false,          // update_species,
+                            true            // is_multistate_method,
+        ) {}
+
+  /// \brief Construct functions that may be used to sample various quantities
+  ///     of the Monte Carlo calculation as it runs
+  std::map<std::string, state_sampling_function_type>
+  standard_sampling_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<state_sampling_function_type> functions =
+        monte_calculator::common_sampling_functions(
+            calculation, "potential_energy",
+            "Potential energy of the state (normalized per primitive cell)");
+
+    // Specific to semi-grand canonical
+    functions.push_back(monte_calculator::make_param_chem_pot_f(calculation));
+
+    std::map<std::string, state_sampling_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to sample various quantities
+  ///     of the Monte Carlo calculation as it runs
+  std::map<std::string, json_state_sampling_function_type>
+  standard_json_sampling_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<json_state_sampling_function_type> functions =
+        monte_calculator::common_json_sampling_functions(calculation);
+
+    std::map<std::string, json_state_sampling_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to analyze Monte Carlo
+  ///     calculation results
+  std::map<std::string, results_analysis_function_type>
+  standard_analysis_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    std::vector<results_analysis_function_type> functions = {
+        monte_calculator::make_heat_capacity_f(calculation),
+        monte_calculator::make_mol_susc_f(calculation),
+        monte_calculator::make_param_susc_f(calculation),
+        monte_calculator::make_mol_thermochem_susc_f(calculation),
+        monte_calculator::make_param_thermochem_susc_f(calculation)};
+
+    std::map<std::string, results_analysis_function_type> function_map;
+    for (auto const &f : functions) {
+      function_map.emplace(f.name, f);
+    }
+    return function_map;
+  }
+
+  /// \brief Construct functions that may be used to modify states
+  StateModifyingFunctionMap standard_modifying_functions(
+      std::shared_ptr<MonteCalculator> const &calculation) const override {
+    return StateModifyingFunctionMap();
+  }
+
+  /// \brief Construct default SamplingFixtureParams
+  sampling_fixture_params_type make_default_sampling_fixture_params(
+      std::shared_ptr<MonteCalculator> const &calculation, std::string label,
+      bool write_results, bool write_trajectory, bool write_observations,
+      bool write_status, std::optional<std::string> output_dir,
+      std::optional<std::string> log_file,
+      double log_frequency_in_s) const override {
+    monte::SamplingParams sampling_params;
+    {
+      auto &s = sampling_params;
+      s.sampler_names = {"clex.formation_energy", "potential_energy",
+                         "mol_composition", "param_composition"};
+      std::string prefix;
+      prefix = "order_parameter_";
+      for (auto const &pair : calculation->system()->dof_spaces) {
+        s.sampler_names.push_back(prefix + pair.first);
+      }
+      prefix = "subspace_order_parameter_";
+      for (auto const &pair : calculation->system()->dof_subspaces) {
+        s.sampler_names.push_back(prefix + pair.first);
+      }
+      if (write_trajectory) {
+        s.do_sample_trajectory = true;
+      }
+    }
+
+    monte::CompletionCheckParams<statistics_type> completion_check_params;
+    {
+      auto &c = completion_check_params;
+      c.equilibration_check_f = monte::default_equilibration_check;
+      c.calc_statistics_f =
+          monte::default_statistics_calculator<statistics_type>();
+
+      converge(calculation->sampling_functions, completion_check_params)
+          .set_abs_precision("potential_energy", 0.001)
+          .set_abs_precision("param_composition", 0.001);
+    }
+
+    std::vector<std::string> analysis_names = {
+        "heat_capacity", "mol_susc", "param_susc", "mol_thermochem_susc",
+        "param_thermochem_susc"};
+
+    return clexmonte::make_sampling_fixture_params(
+        label, calculation->sampling_functions,
+        calculation->json_sampling_functions, calculation->analysis_functions,
+        sampling_params, completion_check_params, analysis_names, write_results,
+        write_trajectory, write_observations, write_status, output_dir,
+        log_file, log_frequency_in_s);
+  }
+
+  /// \brief Validate the state's configuration (all are valid)
+  Validator validate_configuration(state_type &state) const override {
+    return Validator{};
+  }
+
+  /// \brief Validate state's conditions
+  ///
+  /// Notes:
+  /// - requires scalar temperature
+  /// - requires vector param_chem_pot
+  /// - warnings if other conditions are present
+  Validator validate_conditions(state_type &state) const override {
+    // validate state.conditions
+    monte::ValueMap const &conditions = state.conditions;
+    Validator v;
+    v.insert(validate_keys(conditions.scalar_values,
+                           {"temperature"} /*required*/, {} /*optional*/,
+                           "scalar", "condition", false /*throw_if_invalid*/));
+    v.insert(validate_keys(conditions.vector_values,
+                           {"param_chem_pot"} /*required*/, {} /*optional*/,
+                           "vector", "condition", false /*throw_if_invalid*/));
+
+    return v;
+  }
+
+  /// \brief Validate state
+  Validator validate_state(state_type &state) const override {
+    Validator v;
+    v.insert(this->validate_configuration(state));
+    v.insert(this->validate_conditions(state));
+    return v;
+  }
+
+  /// \brief Validate and set the current state, construct state_data, construct
+  ///     potential
+  void set_state_and_potential(state_type &state,
+                               monte::OccLocation *occ_location) override {
+    // Validate system
+    if (this->system == nullptr) {
+      throw std::runtime_error(
+          "Error in ParallelTemperingCalculator::run: system==nullptr");
+    }
+
+    // Validate state
+    Validator v = this->validate_state(state);
+    print(CASM::log(), v);
+    if (!v.valid()) {
+      throw std::runtime_error(
+          "Error in ParallelTemperingCalculator::run: Invalid initial state");
+    }
+
+    // Make state data
+    this->state_data =
+        std::make_shared<StateData>(this->system, &state, occ_location);
+
+    // Make potential calculator
+    this->potential =
+        std::make_shared<ParallelTemperingPotential>(this->state_data);
+  }
+
+  /// \brief Perform a single run, evolving current state
+  void run(state_type &state, monte::OccLocation &occ_location,
+           run_manager_type<engine_type> &run_manager) override {
+    throw std::runtime_error(
+        "Error: ParallelTemperingCalculator requires multi-state runs");
+  }
+
+  /// \brief Perform a single run, evolving one or more states
+  ///
+  /// Only `states[current_state]` is sampled, by `run_manager`. The other
+  /// replicas are evolved and exchange configurations with it.
+  void run(int current_state, std::vector<state_type> &states,
+           std::vector<monte::OccLocation> &occ_locations,
+           run_manager_type<engine_type> &run_manager) override {
+    std::vector<run_manager_type<engine_type> *> run_managers(states.size(),
+                                                              nullptr);
+    run_managers.at(current_state) = &run_manager;
+    this->_run(states, occ_locations, run_managers);
+  }
+
+  /// \brief Perform a single run, evolving multiple states, each sampled by
+  ///     its own run manager
+  void run(std::vector<state_type> &states,
+           std::vector<monte::OccLocation> &occ_locations,
+           std::vector<std::shared_ptr<run_manager_type<engine_type>>>
+               &run_managers) override {
+    std::vector<run_manager_type<engine_type> *> _run_managers;
+    for (auto const &run_manager : run_managers) {
+      _run_managers.push_back(run_manager.get());
+    }
+    this->_run(states, occ_locations, _run_managers);
+  }
+
+  // --- Parameters ---
+  int verbosity_level = 10;
+  Index swap_interval = 1;
+  int n_threads = 1;
+
+  /// Number of attempted and accepted exchanges between replicas `i` and
+  /// `i+1`, in the last run
+  std::vector<Index> n_exchange_attempts;
+  std::vector<Index> n_exchange_accepts;
+
+  /// \brief Reset the derived Monte Carlo calculator
+  ///
+  /// Parameters:
+  ///
+  ///   verbosity: str or int, default=10
+  ///       If integer, the allowed range is `[0,100]`. If string, then:
+  ///       - "none" is equivalent to integer value 0
+  ///       - "quiet" is equivalent to integer value 5
+  ///       - "standard" is equivalent to integer value 10
+  ///       - "verbose" is equivalent to integer value 20
+  ///       - "debug" is equivalent to integer value 100
+  ///
+  ///   swap_interval: int, default=1
+  ///       Number of passes each replica runs between exchange attempts.
+  ///       Must be >= 1.
+  ///
+  ///   n_threads: int, default=1
+  ///       Number of threads used to run replicas concurrently. If < 1, the
+  ///       number of hardware threads is used. Results do not depend on the
+  ///       number of threads.
+  void _reset() override {
+    ParentInputParser parser{params};
+
+    // "verbosity": str or int, default=10
+    this->verbosity_level = parse_verbosity(parser);
+    CASM::log().set_verbosity(this->verbosity_level);
+
+    // "swap_interval": int, default=1
+    this->swap_interval = 1;
+    parser.optional(this->swap_interval, "swap_interval");
+    if (this->swap_interval < 1) {
+      parser.insert_error("swap_interval", "Must be >= 1");
+    }
+
+    // "n_threads": int, default=1
+    this->n_threads = 1;
+    parser.optional(this->n_threads, "n_threads");
+
+    std::stringstream ss;
+    ss << "Error in ParallelTemperingCalculator: error reading calculation "
+          "parameters.";
+    std::runtime_error error_if_invalid{ss.str()};
+    report_and_throw_if_invalid(parser, CASM::log(), error_if_invalid);
+
+    return;
+  }
+
+  /// \brief Clone the ParallelTemperingCalculator
+  ParallelTemperingCalculator *_clone() const override {
+    return new ParallelTemperingCalculator(*this);
+  }
+
+ private:
+  /// \brief Run replicas, sampling those with a (non-null) run manager,
+  ///     until all of those are complete
+  void _run(std::vector<state_type> &states,
+            std::vector<monte::OccLocation> &occ_locations,
+            std::vector<run_manager_type<engine_type> *> const &run_managers) {
+    Index n_replicas = states.size();
+    if (n_replicas == 0 || occ_locations.size() != n_replicas ||
+        run_managers.size() != n_replicas) {
+      throw std::runtime_error(
+          "Error in ParallelTemperingCalculator::run: states, occ_locations, "
+          "and run_managers must be non-empty and have the same size");
+    }
+    run_manager_type<engine_type> *main_run_manager = nullptr;
+    for (auto run_manager : run_managers) {
+      if (run_manager != nullptr) {
+        main_run_manager = run_manager;
+        break;
+      }
+    }
+    if (main_run_manager == nullptr) {
+      throw std::runtime_error(
+          "Error in ParallelTemperingCalculator::run: no run manager");
+    }
+    for (Index i = 1; i < n_replicas; ++i) {
+      if (get_transformation_matrix_to_super(states[i]) !=
+          get_transformation_matrix_to_super(states[0])) {
+        throw std::runtime_error(
+            "Error in ParallelTemperingCalculator::run: all replicas must be "
+            "in the same supercell");
+      }
+    }
+
+    // Replica state data and potentials
+    this->multistate_data.clear();
+    this->multistate_potential.clear();
+    std::vector<double> beta;
+    for (Index i = 0; i < n_replicas; ++i) {
+      this->set_state_and_potential(states[i], &occ_locations[i]);
+      this->multistate_data.push_back(this->state_data);
+      this->multistate_potential.push_back(this->potential);
+      double temperature = states[i].conditions.scalar_values.at("temperature");
+      beta.push_back(1.0 / (CASM::KB * temperature));
+    }
+    auto set_current_state = [&](Index i) {
+      this->current_state = i;
+      this->state_data = this->multistate_data[i];
+      this->potential = this->multistate_potential[i];
+    };
+
+    // Replica event generators and random number generators, seeded from the
+    // first run manager's engine so results do not depend on n_threads
+    monte::RandomNumberGenerator<engine_type> random_number_generator(
+        main_run_manager->engine);
+    std::vector<
+        semigrand_canonical::SemiGrandCanonicalEventGenerator<engine_type>>
+        event_generators;
+    std::vector<monte::RandomNumberGenerator<engine_type>> replica_generators;
+    for (Index i = 0; i < n_replicas; ++i) {
+      event_generators.emplace_back(
+          get_semigrand_canonical_swaps(*this->system),
+          get_semigrand_canonical_multiswaps(*this->system));
+      event_generators.back().set(&states[i], &occ_locations[i]);
+      auto seed = (*random_number_generator.engine)();
+      replica_generators.emplace_back(std::make_shared<engine_type>(seed));
+    }
+
+    Index steps_per_pass = occ_locations[0].mol_size();
+    Index steps_per_block = this->swap_interval * steps_per_pass;
+
+    // Accepted events, by replica, as (step, event, reverse event), recorded
+    // for replicas with a run manager so they can be replayed
+    struct AcceptedEvent {
+      Index step;
+      monte::OccEvent event;
+      monte::OccEvent reverse_event;
+    };
+    std::vector<std::vector<AcceptedEvent>> accepted(n_replicas);
+    std::vector<bool> is_finalized(n_replicas, false);
+    this->n_exchange_attempts.assign(std::max(n_replicas - 1, Index(0)), 0);
+    this->n_exchange_accepts.assign(std::max(n_replicas - 1, Index(0)), 0);
+
+    for (Index i = 0; i < n_replicas; ++i) {
+      if (run_managers[i] != nullptr) {
+        set_current_state(i);
+        run_managers[i]->initialize(steps_per_pass);
+        run_managers[i]->sample_data_by_count_if_due(states[i]);
+      }
+    }
+    auto is_complete = [&]() {
+      for (Index i = 0; i < n_replicas; ++i) {
+        if (run_managers[i] != nullptr && !is_finalized[i]) {
+          return false;
+        }
+      }
+      return true;
+    };
+
+    ThreadPool thread_pool(resolve_n_threads(this->n_threads));
+    Index n_blocks = 0;
+    while (!is_complete()) {
+      // Metropolis steps, in parallel by replica; finalized replicas are
+      // frozen so their final state matches their results
+      thread_pool.for_blocks(n_replicas, [&](int thread_index, Index begin,
+                                             Index end) {
+        for (Index i = begin; i < end; ++i) {
+          if (is_finalized[i]) {
+            continue;
+          }
+          auto &event_generator = event_generators[i];
+          auto &generator = replica_generators[i];
+          BaseMontePotential &potential = *this->multistate_potential[i];
+          Eigen::VectorXi const &occupation = get_occupation(states[i]);
+          bool do_record = (run_managers[i] != nullptr);
+          accepted[i].clear();
+          for (Index step = 0; step < steps_per_block; ++step) {
+            monte::OccEvent const &event = event_generator.propose(generator);
+            double delta_potential_energy = potential.occ_delta_per_supercell(
+                event.linear_site_index, event.new_occ);
+            if (metropolis_acceptance(delta_potential_energy, beta[i],
+                                      generator)) {
+              if (do_record) {
+                accepted[i].push_back({step, event, event});
+                monte::OccEvent &reverse_event =
+                    accepted[i].back().reverse_event;
+                for (Index k = 0; k < event.linear_site_index.size(); ++k) {
+                  reverse_event.new_occ[k] =
+                      occupation(event.linear_site_index[k]);
+                }
+                for (monte::OccTransform &transform :
+                     reverse_event.occ_transform) {
+                  std::swap(transform.from_species, transform.to_species);
+                }
+              }
+              event_generator.apply(event);
+            }
+          }
+        }
+      });
+
+      // Replay steps in order, by replica: revert the accepted events, then
+      // apply them again while counting steps and sampling data if due
+      for (Index i = 0; i < n_replicas; ++i) {
+        if (run_managers[i] == nullptr || is_finalized[i]) {
+          continue;
+        }
+        run_manager_type<engine_type> &run_manager = *run_managers[i];
+        monte::OccLocation &occ_location = occ_locations[i];
+        Eigen::VectorXi &occupation = get_occupation(states[i]);
+        for (auto it = accepted[i].rbegin(); it != accepted[i].rend(); ++it) {
+          occ_location.apply(it->reverse_event, occupation);
+        }
+        set_current_state(i);
+        auto accepted_it = accepted[i].begin();
+        for (Index step = 0; step < steps_per_block; ++step) {
+          if (run_manager.is_complete()) {
+            break;
+          }
+          run_manager.write_status_if_due();
+          if (accepted_it != accepted[i].end() && accepted_it->step == step) {
+            occ_location.apply(accepted_it->event, occupation);
+            run_manager.increment_n_accept();
+            ++accepted_it;
+          } else {
+            run_manager.increment_n_reject();
+          }
+          run_manager.increment_step();
+          run_manager.sample_data_by_count_if_due(states[i]);
+        }
+        if (run_manager.is_complete()) {
+          run_manager.finalize(states[i]);
+          is_finalized[i] = true;
+        }
+      }
+
+      // Attempt exchanges between adjacent replicas, alternating even and
+      // odd pairs, and skipping pairs with a finalized replica
+      for (Index i = n_blocks % 2; i + 1 < n_replicas; i += 2) {
+        if (is_finalized[i] || is_finalized[i + 1]) {
+          continue;
+        }
+        this->_attempt_exchange(i, i + 1, states, occ_locations, beta,
+                                random_number_generator);
+      }
+      ++n_blocks;
+    }
+
+    this->run_info = jsonParser::object();
+    this->run_info["n_exchange_attempts"] = this->n_exchange_attempts;
+    this->run_info["n_exchange_accepts"] = this->n_exchange_accepts;
+
+    Log &log = CASM::log();
+    log.custom<Log::standard>("Parallel tempering summary");
+    for (Index i = 0; i + 1 < n_replicas; ++i) {
+      log.indent() << "replicas " << i << "-" << i + 1 << ": "
+                   << this->n_exchange_accepts[i] << " of "
+                   << this->n_exchange_attempts[i] << " exchanges accepted"
+                   << std::endl;
+    }
+    log.indent() << std::endl;
+  }
+
+  /// \brief Attempt to exchange the configurations of replicas i and j
+  void _attempt_exchange(
+      Index i, Index j, std::vector<state_type> &states,
+      std::vector<monte::OccLocation> &occ_locations,
+      std::vector<double> const &beta,
+      monte::RandomNumberGenerator<engine_type> &random_number_generator) {
+    BaseMontePotential &potential_i = *this->multistate_potential[i];
+    BaseMontePotential &potential_j = *this->multistate_potential[j];
+    Eigen::VectorXi &occupation_i = get_occupation(states[i]);
+    Eigen::VectorXi &occupation_j = get_occupation(states[j]);
+
+    // Occupation values are copied, not swapped by pointer, so that
+    // calculators continue to point at the state data
+    double before = beta[i] * potential_i.per_supercell() +
+                    beta[j] * potential_j.per_supercell();
+    Eigen::VectorXi tmp = occupation_i;
+    occupation_i = occupation_j;
+    occupation_j = tmp;
+    double after = beta[i] * potential_i.per_supercell() +
+                   beta[j] * potential_j.per_supercell();
+
+    ++this->n_exchange_attempts[i];
+    double delta = after - before;
+    if (delta <= 0.0 ||
+        random_number_generator.random_real(1.0) < std::exp(-delta)) {
+      occ_locations[i].initialize(occupation_i);
+      occ_locations[j].initialize(occupation_j);
+      ++this->n_exchange_accepts[i];
+    } else {
+      occupation_j = occupation_i;
+      occupation_i = tmp;
+    }
+  }
+};
+
+}  // namespace clexmonte
+}  // namespace CASM
+
+extern "C" {
+/// \brief Returns a clexmonte::BaseMonteCalculator* owning a
+/// ParallelTemperingCalculator
+CASM::clexmonte::BaseMonteCalculator *make_ParallelTemperingCalculator() {
+  return new CASM::clexmonte::ParallelTemperingCalculator();
+}
+}
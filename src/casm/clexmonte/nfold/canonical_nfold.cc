@@ -0,0 +1,11 @@
+#include "casm/clexmonte/nfold/canonical_nfold_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+template struct CanonicalNfold<std::mt19937_64>;
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
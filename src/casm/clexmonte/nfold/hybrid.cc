@@ -0,0 +1,11 @@
+#include "casm/clexmonte/nfold/hybrid_impl.hh"
+
+namespace CASM {
+namespace clexmonte {
+namespace nfold {
+
+template struct HybridNfold<std::mt19937_64>;
+
+}  // namespace nfold
+}  // namespace clexmonte
+}  // namespace CASM
@@ -1,13 +1,21 @@
 
 #include "casm/clexmonte/nfold/nfold_events.hh"
 
+#include <cmath>
+#include <set>
+
+#include "casm/casm_io/Log.hh"
+#include "casm/clexmonte/events/PrimEventCache.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/state/Conditions.hh"
 #include "casm/clexmonte/system/System.hh"
 #include "casm/clexulator/ConfigDoFValues.hh"
+#include "casm/configuration/occ_events/OccEvent.hh"
 #include "casm/configuration/occ_events/OccSystem.hh"
 #include "casm/configuration/occ_events/io/json/OccEvent_json_io.hh"
 #include "casm/configuration/occ_events/orbits.hh"
+#include "casm/crystallography/BasicStructure.hh"
+#include "casm/crystallography/Coordinate.hh"
 #include "casm/monte/Conversions.hh"
 #include "casm/monte/events/OccCandidate.hh"
 
@@ -15,53 +23,6 @@ namespace CASM {
 namespace clexmonte {
 namespace nfold {
 
-CompleteEventCalculator::CompleteEventCalculator(
-    std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
-        _potential,
-    std::vector<PrimEventData> const &_prim_event_list,
-    std::map<EventID, EventData> const &_event_list)
-    : prim_event_list(_prim_event_list),
-      event_list(_event_list),
-      potential(_potential) {}
-
-/// \brief Get CASM::monte::OccEvent corresponding to given event ID
-double CompleteEventCalculator::calculate_rate(EventID const &id) {
-  EventData const &event_data = event_list.at(id);
-  PrimEventData const &prim_event_data =
-      prim_event_list.at(id.prim_event_index);
-
-  /// ---
-
-  clexulator::ConfigDoFValues const *dof_values = potential->get();
-
-  int i = 0;
-  for (Index l : event_data.event.linear_site_index) {
-    if (dof_values->occupation(l) != prim_event_data.occ_init[i]) {
-      event_state.is_allowed = false;
-      event_state.rate = 0.0;
-      return event_state.rate;
-    }
-    ++i;
-  }
-  event_state.is_allowed = true;
-
-  // calculate change in energy to final state
-  event_state.dE_final = potential->occ_delta_per_supercell(
-      event_data.event.linear_site_index, prim_event_data.occ_final);
-
-  // calculate rate
-  if (event_state.dE_final <= 0.0) {
-    event_state.rate = 1.0;
-  } else {
-    event_state.rate =
-        exp(-potential->conditions()->beta * event_state.dE_final);
-  }
-
-  /// ---
-
-  return event_state.rate;
-}
-
 namespace {
 
 occ_events::OccPosition _make_atom_position(
@@ -153,6 +114,101 @@ std::map<std::string, OccEventTypeData> _make_event_type_data(
   return event_type_data;
 }
 
+/// \brief Make OccEventTypeData for canonical exchange events
+///
+/// For each canonical swap, `(asym_a, species_a) <-> (asym_b, species_b)`,
+/// an exchange event is made for each pair of sites, one on an `asym_a`
+/// sublattice in the origin unit cell and one on an `asym_b` sublattice no
+/// more than `max_length` away. Each pair orbit is included once, including
+/// the reverse exchange, which is constructed by make_prim_event_list.
+std::map<std::string, OccEventTypeData> _make_canonical_event_type_data(
+    std::shared_ptr<system_type> system, state_type const &state,
+    std::vector<monte::OccSwap> const &canonical_swaps, double max_length) {
+  double tol = 1e-5;
+  auto event_system = get_event_system(*system);
+  monte::Conversions const &convert = get_index_conversions(*system, state);
+  auto const &occevent_symgroup_rep = get_occevent_symgroup_rep(*system);
+  xtal::BasicStructure const &prim = *event_system->prim;
+
+  // range of unit cells to check for neighbors
+  Eigen::Matrix3d lat_inv = prim.lattice().lat_column_mat().inverse();
+  Eigen::Vector3l n_max;
+  for (Index a = 0; a < 3; ++a) {
+    n_max(a) =
+        static_cast<long>(std::ceil(max_length * lat_inv.row(a).norm())) + 1;
+  }
+
+  // prototypes of the pair orbits already included
+  std::set<occ_events::OccEvent> prototypes;
+
+  std::map<std::string, OccEventTypeData> event_type_data;
+  for (monte::OccSwap const &swap : canonical_swaps) {
+    Index asym_a = swap.cand_a.asym;
+    Index asym_b = swap.cand_b.asym;
+    Index species_a = swap.cand_a.species_index;
+    Index species_b = swap.cand_b.species_index;
+    xtal::UnitCellCoord site_a(*convert.asym_to_b(asym_a).begin(), 0, 0, 0);
+    Eigen::Vector3d r_a = site_a.coordinate(prim).const_cart();
+
+    std::string prefix = "exchange-" + std::to_string(asym_a) + "-" +
+                         std::to_string(species_a) + "-" +
+                         std::to_string(asym_b) + "-" +
+                         std::to_string(species_b) + "-";
+    Index n_orbits = 0;
+    for (Index b = 0; b < prim.basis().size(); ++b) {
+      if (!convert.asym_to_b(asym_b).count(b)) {
+        continue;
+      }
+      for (long i = -n_max(0); i <= n_max(0); ++i) {
+        for (long j = -n_max(1); j <= n_max(1); ++j) {
+          for (long k = -n_max(2); k <= n_max(2); ++k) {
+            xtal::UnitCellCoord site_b(b, i, j, k);
+            if (site_b == site_a) {
+              continue;
+            }
+            double length =
+                (site_b.coordinate(prim).const_cart() - r_a).norm();
+            if (length > max_length + tol) {
+              continue;
+            }
+
+            // species_a moves from site_a to site_b, species_b moves from
+            // site_b to site_a
+            occ_events::OccTrajectory traj_a(
+                {_make_atom_position(*event_system, site_a,
+                                     convert.occ_index(asym_a, species_a)),
+                 _make_atom_position(*event_system, site_b,
+                                     convert.occ_index(asym_b, species_a))});
+            occ_events::OccTrajectory traj_b(
+                {_make_atom_position(*event_system, site_b,
+                                     convert.occ_index(asym_b, species_b)),
+                 _make_atom_position(*event_system, site_a,
+                                     convert.occ_index(asym_a, species_b))});
+            occ_events::OccEvent event({traj_a, traj_b});
+
+            std::set<occ_events::OccEvent> orbit =
+                occ_events::make_prim_periodic_orbit(event,
+                                                     occevent_symgroup_rep);
+            std::set<occ_events::OccEvent> reverse_orbit =
+                occ_events::make_prim_periodic_orbit(
+                    occ_events::copy_reverse(event), occevent_symgroup_rep);
+            if (prototypes.count(*orbit.begin()) ||
+                prototypes.count(*reverse_orbit.begin())) {
+              continue;
+            }
+            prototypes.insert(*orbit.begin());
+
+            event_type_data[prefix + std::to_string(n_orbits)].events =
+                std::vector<occ_events::OccEvent>(orbit.begin(), orbit.end());
+            ++n_orbits;
+          }
+        }
+      }
+    }
+  }
+  return event_type_data;
+}
+
 }  // namespace
 
 /// \brief Construct NfoldEventData
@@ -161,7 +217,8 @@ NfoldEventData::NfoldEventData(
     monte::OccLocation const &occ_location,
     std::vector<monte::OccSwap> const &semigrand_canonical_swaps,
     std::shared_ptr<semigrand_canonical::SemiGrandCanonicalPotential>
-        potential) {
+        potential,
+    int n_threads, std::string const &event_cache_dir) {
   // Make OccEvents from SemiGrandCanonical swaps
   // key: event_type_name, value: symmetrically equivalent events
   system->event_type_data =
@@ -169,16 +226,63 @@ NfoldEventData::NfoldEventData(
 
   prim_event_list = clexmonte::make_prim_event_list(*system);
 
-  prim_impact_info_list = clexmonte::make_prim_impact_info_list(
-      *system, prim_event_list, {"formation_energy"});
+  PrimEventCacheData cache_data = clexmonte::make_prim_event_cache_data(
+      *system, prim_event_list, {"formation_energy"}, {}, event_cache_dir);
+  prim_impact_info_list = std::move(cache_data.prim_impact_info_list);
+  relative_impact_table = std::move(cache_data.relative_impact_table);
 
   // TODO: rejection-clexmonte option does not require impact table
   event_list = clexmonte::make_complete_event_list(
-      prim_event_list, prim_impact_info_list, occ_location);
+      prim_event_list, relative_impact_table, occ_location, {}, n_threads);
+  print_timing(CASM::log(), event_list);
 
   // Construct CompleteEventCalculator
   event_calculator = std::make_shared<CompleteEventCalculator>(
-      potential, prim_event_list, event_list.events);
+      potential, prim_event_list, event_list);
+}
+
+/// \brief Construct CanonicalNfoldEventData
+///
+/// \param system System data
+/// \param state The state, which determines the supercell
+/// \param occ_location Occupant location tracker, for the state
+/// \param canonical_swaps Canonical swap types, which determine the
+///     species exchanged by events
+/// \param potential Canonical potential, used to calculate event rates
+/// \param max_length Maximum distance between the sites of an exchange
+/// \param n_threads Number of threads used to construct the event list
+/// \param event_cache_dir If not empty, directory used to cache prim event
+///     impact information
+CanonicalNfoldEventData::CanonicalNfoldEventData(
+    std::shared_ptr<system_type> system, state_type const &state,
+    monte::OccLocation const &occ_location,
+    std::vector<monte::OccSwap> const &canonical_swaps,
+    std::shared_ptr<canonical::CanonicalPotential> potential,
+    double max_length, int n_threads, std::string const &event_cache_dir) {
+  // Make OccEvents from canonical swaps
+  // key: event_type_name, value: symmetrically equivalent events
+  system->event_type_data = _make_canonical_event_type_data(
+      system, state, canonical_swaps, max_length);
+  if (system->event_type_data.empty()) {
+    throw std::runtime_error(
+        "Error constructing CanonicalNfoldEventData: no exchange events; "
+        "check \"max_length\"");
+  }
+
+  prim_event_list = clexmonte::make_prim_event_list(*system);
+
+  PrimEventCacheData cache_data = clexmonte::make_prim_event_cache_data(
+      *system, prim_event_list, {"formation_energy"}, {}, event_cache_dir);
+  prim_impact_info_list = std::move(cache_data.prim_impact_info_list);
+  relative_impact_table = std::move(cache_data.relative_impact_table);
+
+  event_list = clexmonte::make_complete_event_list(
+      prim_event_list, relative_impact_table, occ_location, {}, n_threads);
+  print_timing(CASM::log(), event_list);
+
+  // Construct CanonicalCompleteEventCalculator
+  event_calculator = std::make_shared<CanonicalCompleteEventCalculator>(
+      potential, prim_event_list, event_list);
 }
 
 }  // namespace nfold
@@ -29,16 +29,26 @@ clexulator::ConfigDoFValues const *SemiGrandCanonicalPotential::get() const {
 /// - If state supercell is modified this must be called again
 /// - State DoF values can be modified without calling this again
 /// - If state conditions are modified this must be called again
+/// - If `independent_clex` is true, the formation energy calculator has its
+///   own copy of the Clexulator, so that this potential can be used by a
+///   different thread than other calculators for the same supercell
 void SemiGrandCanonicalPotential::set(
     state_type const *state,
-    std::shared_ptr<SemiGrandCanonicalConditions> conditions) {
+    std::shared_ptr<SemiGrandCanonicalConditions> conditions,
+    bool independent_clex) {
   // supercell-specific
   m_state = state;
   if (m_state == nullptr) {
     throw std::runtime_error(
         "Error setting SemiGrandCanonicalPotential state: state is empty");
   }
-  m_formation_energy_clex = get_clex(*m_system, *m_state, "formation_energy");
+  if (independent_clex) {
+    m_formation_energy_clex =
+        make_clex(*m_system, *m_state, "formation_energy");
+  } else {
+    m_formation_energy_clex =
+        get_clex(*m_system, *m_state, "formation_energy");
+  }
   m_convert = &get_index_conversions(*m_system, *m_state);
   m_n_unitcells = get_transformation_matrix_to_super(*m_state).determinant();
 
@@ -637,6 +637,46 @@ std::shared_ptr<clexulator::MultiLocalClusterExpansion> get_local_multiclex(
   return clex;
 }
 
+/// \brief Construct a new clexulator::ClusterExpansion, with an independent
+///     copy of the Clexulator, for a particular state's supercell
+///
+/// Notes:
+/// - Clexulator are not thread-safe. Unlike `get_clex`, which returns the
+///   calculator shared by all users of the same supercell, this constructs a
+///   new calculator that may be used by a separate thread.
+/// - The supercell neighbor list and coefficients are shared.
+std::shared_ptr<clexulator::ClusterExpansion> make_clex(
+    System &system, state_type const &state, std::string const &key) {
+  ClexData const &data = get_clex_data(system, key);
+  auto _clexulator = std::make_shared<clexulator::Clexulator>(
+      *get_basis_set(system, data.basis_set_name));
+  auto clex = std::make_shared<clexulator::ClusterExpansion>(
+      get_supercell_neighbor_list(system, state), _clexulator,
+      data.coefficients);
+  set(*clex, state);
+  return clex;
+}
+
+/// \brief Construct a new clexulator::LocalCorrelations, with independent
+///     copies of the local Clexulator, for a particular state's supercell
+///
+/// Notes:
+/// - Clexulator are not thread-safe. Unlike `get_local_corr`, which returns
+///   the calculator shared by all users of the same supercell, this
+///   constructs a new calculator that may be used by a separate thread.
+/// - The key is the local basis set name
+/// - The supercell neighbor list is shared.
+std::shared_ptr<clexulator::LocalCorrelations> make_local_corr(
+    System &system, state_type const &state, std::string const &key) {
+  auto _local_clexulator =
+      std::make_shared<std::vector<clexulator::Clexulator>>(
+          *get_local_basis_set(system, key));
+  auto local_corr = std::make_shared<clexulator::LocalCorrelations>(
+      get_supercell_neighbor_list(system, state), _local_clexulator);
+  local_corr->set(&get_dof_values(state));
+  return local_corr;
+}
+
 /// \brief Helper to get the supercell neighbor list for a
 ///     particular state's supercell, constructing as necessary
 std::shared_ptr<clexulator::SuperNeighborList> get_supercell_neighbor_list(
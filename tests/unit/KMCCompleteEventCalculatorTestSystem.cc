@@ -41,7 +41,7 @@ void KMCCompleteEventCalculatorTestSystem::make_complete_event_calculator(
 
   // Construct CompleteEventCalculator
   event_calculator = std::make_shared<kinetic::CompleteEventCalculator>(
-      prim_event_list, prim_event_calculators, event_list.events);
+      prim_event_list, prim_event_calculators, event_list);
 }
 
 }  // namespace test
@@ -0,0 +1,258 @@
+#include <algorithm>
+
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/canonical/canonical.hh"
+#include "casm/clexmonte/nfold/canonical_nfold.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/clexulator/Clexulator.hh"
+#include "casm/clexulator/NeighborList.hh"
+#include "casm/clexulator/io/json/SparseCoefficients_json_io.hh"
+#include "casm/composition/CompositionConverter.hh"
+#include "casm/crystallography/io/BasicStructureIO.hh"
+#include "casm/monte/MethodLog.hh"
+#include "casm/monte/checks/CompletionCheck.hh"
+#include "casm/monte/run_management/RunManager.hh"
+#include "casm/monte/run_management/SamplingFixture.hh"
+#include "casm/monte/run_management/io/json/jsonResultsIO_impl.hh"
+#include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+#include "casm/monte/sampling/SamplingParams.hh"
+#include "casm/system/RuntimeLibrary.hh"
+#include "gtest/gtest.h"
+#include "misc.hh"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Construct the ZrO system, with formation energy cluster expansion
+std::shared_ptr<clexmonte::System> make_ZrO_system(fs::path test_dir) {
+  // Copy test input data to a temperorary directory
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  fs::path clexulator_src_relpath = fs::path("basis_sets") /
+                                    "bset.formation_energy" /
+                                    "ZrO_Clexulator_formation_energy.cc";
+  fs::path eci_relpath = "formation_energy_eci.json";
+  fs::path prim_relpath = "prim.json";
+
+  fs::copy_options copy_options = fs::copy_options::skip_existing;
+  fs::create_directories(test_dir / clexulator_src_relpath.parent_path());
+  fs::copy_file(test_data_dir / clexulator_src_relpath,
+                test_dir / clexulator_src_relpath, copy_options);
+  fs::copy_file(test_data_dir / eci_relpath, test_dir / eci_relpath,
+                copy_options);
+  fs::copy_file(test_data_dir / prim_relpath, test_dir / prim_relpath,
+                copy_options);
+
+  // Set Clexulator compilation options
+  std::string default_clexulator_compile_options =
+      RuntimeLibrary::default_cxx().first + " " +
+      RuntimeLibrary::default_cxxflags().first + " " +
+      include_path(RuntimeLibrary::default_casm_includedir().first);
+  std::string default_clexulator_so_options =
+      RuntimeLibrary::default_cxx().first + " " +
+      RuntimeLibrary::default_soflags().first + " " +
+      link_path(RuntimeLibrary::default_casm_libdir().first) + " " +
+      "-lcasm_clexulator ";
+
+  std::runtime_error error_if_invalid{
+      "Error reading canonical Monte Carlo JSON input"};
+
+  // - Construct prim
+  jsonParser prim_json(test_dir / prim_relpath);
+  std::shared_ptr<xtal::BasicStructure const> shared_prim =
+      std::make_shared<xtal::BasicStructure const>(read_prim(prim_json, TOL));
+
+  // - Construct composition::CompositionConverter
+  std::vector<std::string> components = {"Zr", "Va", "O"};
+
+  Eigen::VectorXd origin;
+  origin.resize(3);
+  origin << 2.0, 2.0, 0.0;
+
+  Eigen::MatrixXd end_members;
+  end_members.resize(3, 1);
+  end_members.col(0) << 2.0, 0.0, 2.0;
+
+  composition::CompositionConverter composition_converter(components, origin,
+                                                          end_members);
+
+  // - Construct system data
+  std::shared_ptr<clexmonte::System> system =
+      std::make_shared<clexmonte::System>(shared_prim, composition_converter);
+
+  // - Construct clexulator::Clexulator for formation energy
+  fs::path clexulator_src = test_dir / clexulator_src_relpath;
+  std::shared_ptr<clexulator::Clexulator> clexulator =
+      std::make_shared<clexulator::Clexulator>(clexulator::make_clexulator(
+          clexulator_src.stem().string(), clexulator_src.parent_path(),
+          system->prim_neighbor_list, default_clexulator_compile_options,
+          default_clexulator_so_options));
+
+  // - Construct clexulator::SparseCoefficients for formation energy
+  jsonParser eci_json(test_dir / eci_relpath);
+  InputParser<clexulator::SparseCoefficients> eci_parser(eci_json);
+  report_and_throw_if_invalid(eci_parser, CASM::log(), error_if_invalid);
+
+  // - Add formation energy basis set and clex to `system`
+  system->basis_sets.emplace("formation_energy", clexulator);
+  clexmonte::ClexData formation_energy_clex_data;
+  formation_energy_clex_data.basis_set_name = "formation_energy";
+  formation_energy_clex_data.coefficients = *eci_parser.value;
+  system->clex_data.emplace("formation_energy", formation_energy_clex_data);
+
+  return system;
+}
+
+/// \brief Run a single state, 4 x 4 x 4 supercell, and return the contents
+///     of summary.json
+///
+/// \param calculation Canonical or CanonicalNfold calculator
+/// \param output_dir Output directory, removed before returning
+/// \param sample_mode Sample by pass, or by time
+/// \param sample_period Number of passes, or time, between samples
+/// \param max_cutoff Maximum number of passes (sample_mode=BY_PASS), or
+///     maximum time (sample_mode=BY_TIME)
+template <typename CalculationType>
+jsonParser run_and_read_summary(std::shared_ptr<CalculationType> calculation,
+                                fs::path output_dir,
+                                monte::SAMPLE_MODE sample_mode,
+                                double sample_period, double max_cutoff) {
+  typedef typename CalculationType::engine_type engine_type;
+  std::shared_ptr<clexmonte::System> system = calculation->system;
+  std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
+
+  monte::StateSamplingFunctionMap sampling_functions =
+      CalculationType::standard_sampling_functions(calculation);
+  monte::jsonStateSamplingFunctionMap json_sampling_functions =
+      CalculationType::standard_json_sampling_functions(calculation);
+  std::map<std::string, clexmonte::results_analysis_function_type>
+      analysis_functions =
+          CalculationType::standard_analysis_functions(calculation);
+
+  // - State generator: 4 x 4 x 4 supercell, with 32 O and 96 Va
+  Eigen::Matrix3l transformation_matrix_to_super;
+  transformation_matrix_to_super.col(0) << 4, 0, 0;
+  transformation_matrix_to_super.col(1) << 0, 4, 0;
+  transformation_matrix_to_super.col(2) << 0, 0, 4;
+  clexmonte::Configuration initial_configuration =
+      clexmonte::make_default_configuration(*system,
+                                            transformation_matrix_to_super);
+  auto config_generator = notstd::make_unique<clexmonte::FixedConfigGenerator>(
+      initial_configuration);
+  composition::CompositionConverter const &composition_converter =
+      get_composition_converter(*system);
+  monte::ValueMap initial_conditions = clexmonte::canonical::make_conditions(
+      1000.0, composition_converter, {{"Zr", 2.}, {"O", 0.5}, {"Va", 1.5}});
+  monte::ValueMap conditions_increment =
+      clexmonte::canonical::make_conditions_increment(
+          0.0, composition_converter, {{"Zr", 0.0}, {"O", 0.0}, {"Va", 0.0}});
+  clexmonte::RunDataOutputParams output_params;
+  output_params.output_dir = output_dir;
+  clexmonte::IncrementalConditionsStateGenerator state_generator(
+      system, output_params, std::move(config_generator), initial_conditions,
+      conditions_increment, 1 /*n_states*/, false /*dependent_runs*/);
+
+  // - Sampling
+  monte::SamplingParams sampling_params;
+  sampling_params.sample_mode = sample_mode;
+  sampling_params.sample_method = monte::SAMPLE_METHOD::LINEAR;
+  sampling_params.begin = sample_period;
+  sampling_params.period = sample_period;
+  sampling_params.sampler_names = std::vector<std::string>(
+      {"mol_composition", "formation_energy", "potential_energy"});
+  sampling_params.do_sample_trajectory = false;
+
+  // - Completion check
+  monte::CompletionCheckParams<clexmonte::statistics_type>
+      completion_check_params;
+  completion_check_params.equilibration_check_f =
+      monte::default_equilibration_check;
+  completion_check_params.calc_statistics_f =
+      monte::BasicStatisticsCalculator();
+  if (sample_mode == monte::SAMPLE_MODE::BY_TIME) {
+    completion_check_params.cutoff_params.max_time = max_cutoff;
+  } else {
+    completion_check_params.cutoff_params.max_count =
+        static_cast<Index>(max_cutoff);
+  }
+  converge(sampling_functions, completion_check_params)
+      .set_abs_precision("formation_energy", 0.001);
+
+  fs::path output_thermo_dir = output_dir / "thermo";
+  auto results_io =
+      std::make_unique<monte::jsonResultsIO<clexmonte::results_type>>(
+          output_thermo_dir, false /*write_trajectory*/,
+          false /*write_observations*/);
+
+  monte::MethodLog method_log;
+  method_log.logfile_path = output_thermo_dir / "status.json";
+  method_log.log_frequency = 60;  // seconds
+
+  std::vector<clexmonte::sampling_fixture_params_type> sampling_fixture_params;
+  sampling_fixture_params.emplace_back(
+      "thermo", sampling_functions, json_sampling_functions, analysis_functions,
+      sampling_params, completion_check_params, std::vector<std::string>(),
+      std::move(results_io), method_log);
+
+  clexmonte::run_series(*calculation, engine, state_generator,
+                        sampling_fixture_params, true /*global_cutoff*/);
+
+  EXPECT_TRUE(fs::exists(output_thermo_dir / "summary.json"));
+  jsonParser summary(output_thermo_dir / "summary.json");
+
+  fs::remove_all(output_dir);
+  return summary;
+}
+
+}  // namespace
+
+/// \brief Canonical N-fold way conserves composition, and agrees with
+///     canonical Metropolis Monte Carlo
+TEST(canonical_nfold_fullrun_test, Test1) {
+  fs::path test_dir =
+      fs::current_path() / "CASM_test_projects" / "canonical_nfold_fullrun_test";
+  std::shared_ptr<clexmonte::System> system = make_ZrO_system(test_dir);
+
+  // Canonical Metropolis, sampled each pass (128 O/Va sites)
+  auto metropolis =
+      std::make_shared<clexmonte::canonical::Canonical_mt19937_64>(system);
+  jsonParser metropolis_summary = run_and_read_summary(
+      metropolis, test_dir / "output_metropolis", monte::SAMPLE_MODE::BY_PASS,
+      1.0 /*sample_period*/, 5000.0 /*max_count*/);
+
+  // Canonical N-fold way, nearest neighbor O/Va exchanges, sampled by time
+  // (in units of Metropolis attempts), with the same frequency
+  auto nfold = std::make_shared<clexmonte::nfold::CanonicalNfold_mt19937_64>(
+      system, 3.3 /*max_length*/);
+  EXPECT_TRUE(nfold->time_sampling_allowed);
+  jsonParser nfold_summary = run_and_read_summary(
+      nfold, test_dir / "output_nfold", monte::SAMPLE_MODE::BY_TIME,
+      128.0 /*sample_period*/, 128.0 * 5000.0 /*max_time*/);
+
+  // composition is conserved: 32 O in 64 unit cells
+  for (jsonParser const *summary : {&metropolis_summary, &nfold_summary}) {
+    jsonParser const &mol_composition =
+        (*summary)["statistics"]["mol_composition"];
+    EXPECT_NEAR(mol_composition["Zr"]["mean"][0].get<double>(), 2.0, 1e-10);
+    EXPECT_NEAR(mol_composition["O"]["mean"][0].get<double>(), 0.5, 1e-10);
+    EXPECT_NEAR(mol_composition["Va"]["mean"][0].get<double>(), 1.5, 1e-10);
+  }
+
+  // mean formation energy agrees within the calculated precision
+  jsonParser const &metropolis_formation_energy =
+      metropolis_summary["statistics"]["formation_energy"]["value"];
+  jsonParser const &nfold_formation_energy =
+      nfold_summary["statistics"]["formation_energy"]["value"];
+  double metropolis_mean = metropolis_formation_energy["mean"][0].get<double>();
+  double nfold_mean = nfold_formation_energy["mean"][0].get<double>();
+  double tol =
+      2.0 *
+      (metropolis_formation_energy["calculated_precision"][0].get<double>() +
+       nfold_formation_energy["calculated_precision"][0].get<double>());
+  EXPECT_NEAR(metropolis_mean, nfold_mean, std::max(tol, 0.002));
+}
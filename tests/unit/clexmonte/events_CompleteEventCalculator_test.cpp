@@ -1,4 +1,5 @@
 #include "KMCCompleteEventListTestSystem.hh"
+#include "casm/clexmonte/events/PackedOccupation.hh"
 #include "casm/clexmonte/kinetic/io/stream/EventState_stream_io.hh"
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 #include "casm/clexmonte/state/Conditions.hh"
@@ -62,7 +63,7 @@ TEST_F(events_CompleteEventCalculator_Test, Test1) {
   // Construct CompleteEventListEventCalculator
   auto event_calculator =
       std::make_shared<clexmonte::kinetic::CompleteEventCalculator>(
-          prim_event_list, prim_event_calculators, event_list.events);
+          prim_event_list, prim_event_calculators, event_list);
 
   double expected_Ekra = 1.0;
   double expected_freq = 1e12;
@@ -71,11 +72,10 @@ TEST_F(events_CompleteEventCalculator_Test, Test1) {
   Index i = 0;
   Index n_not_allowed = 0;
   Index n_allowed = 0;
-  for (auto const &event : event_list.events) {
-    auto const &event_id = event.first;
-    // auto const &event_data = event.second;
+  for (Index event_index = 0; event_index < event_list.size(); ++event_index) {
+    // auto event_id = event_list.event_id(event_index);
     // auto const &prim_event_data = prim_event_list[event_id.prim_event_index];
-    double rate = event_calculator->calculate_rate(event_id);
+    double rate = event_calculator->calculate_rate(EventIndex(event_index));
     auto const &event_state = event_calculator->event_state;
 
     if (CASM::almost_equal(rate, 0.0)) {
@@ -100,4 +100,136 @@ TEST_F(events_CompleteEventCalculator_Test, Test1) {
   }
   EXPECT_EQ(n_not_allowed, occupation.size() * 24 - 12);
   EXPECT_EQ(n_allowed, 12);
+
+  // Batched rate calculation, with event state cache
+  std::vector<EventIndex> all_events(event_list.size());
+  for (Index event_index = 0; event_index < event_list.size(); ++event_index) {
+    all_events[event_index] = EventIndex(event_index);
+  }
+  EventIndexRange range;
+  range.begin_ptr = all_events.data();
+  range.end_ptr = all_events.data() + all_events.size();
+  event_calculator->event_state_cache =
+      std::make_shared<kinetic::EventStateCache>(event_list.size());
+  std::vector<double> rates;
+  event_calculator->calculate_rates(range, rates);
+  ASSERT_EQ(rates.size(), event_list.size());
+
+  auto const &cache = *event_calculator->event_state_cache;
+  n_allowed = 0;
+  for (Index event_index = 0; event_index < event_list.size(); ++event_index) {
+    kinetic::EventState event_state = cache.get(EventIndex(event_index));
+    EXPECT_EQ(rates[event_index], event_state.rate);
+    if (event_state.is_allowed) {
+      EXPECT_TRUE(CASM::almost_equal(rates[event_index] / expected_rate, 1.0,
+                                     1e-14));
+      EXPECT_TRUE(CASM::almost_equal(event_state.Ekra, expected_Ekra));
+      EXPECT_TRUE(CASM::almost_equal(event_state.freq, expected_freq));
+      ++n_allowed;
+    } else {
+      EXPECT_EQ(rates[event_index], 0.0);
+    }
+  }
+  EXPECT_EQ(n_allowed, 12);
+
+  // Memoized event states, validating every hit
+  event_calculator->packed_occupation =
+      std::make_shared<PackedOccupation>(occupation, 3);
+  auto memo = std::make_shared<kinetic::EventStateMemo>(
+      prim_impact_info_list, occ_location->convert().unitcell_index_converter(),
+      1000, 1);
+  event_calculator->event_state_memo = memo;
+  std::vector<double> memo_rates;
+  event_calculator->calculate_rates(range, memo_rates);
+  event_calculator->calculate_rates(range, memo_rates);
+  EXPECT_EQ(memo->n_misses, memo->size());
+  EXPECT_EQ(memo->n_hits + memo->n_misses, 2 * 12);
+  EXPECT_GT(memo->n_hits, 0);
+  EXPECT_EQ(memo->n_validated, memo->n_hits);
+  EXPECT_EQ(memo->n_validation_failures, 0);
+  for (Index event_index = 0; event_index < event_list.size(); ++event_index) {
+    EXPECT_EQ(memo_rates[event_index], rates[event_index]);
+  }
+}
+
+/// \brief Test rescaling cached event rates for a temperature series
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell), A-B with several Va
+/// - Rates rescaled from the event state cache must match a full
+///   recalculation at each temperature, in the same supercell and occupation
+TEST_F(events_CompleteEventCalculator_Test, Test2) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  Index dim = 4;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    occupation(l) = (l % 3 == 0) ? 1 : 0;
+  }
+  occupation(0) = 2;
+  occupation(17) = 2;
+  occupation(101) = 2;
+  state.conditions.scalar_values.emplace("temperature", 600.0);
+
+  make_prim_event_list();
+  make_complete_event_list(state);
+  auto conditions = make_conditions(*system, state);
+  std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+      clexmonte::kinetic::make_prim_event_calculators(
+          system, state, prim_event_list, conditions);
+  auto event_calculator =
+      std::make_shared<clexmonte::kinetic::CompleteEventCalculator>(
+          prim_event_list, prim_event_calculators, event_list,
+          CASM::null_log());
+
+  // fill the cache at the initial temperature
+  std::vector<EventIndex> all_events(event_list.size());
+  for (Index event_index = 0; event_index < event_list.size(); ++event_index) {
+    all_events[event_index] = EventIndex(event_index);
+  }
+  EventIndexRange range;
+  range.begin_ptr = all_events.data();
+  range.end_ptr = all_events.data() + all_events.size();
+  auto cache = std::make_shared<kinetic::EventStateCache>(event_list.size());
+  event_calculator->event_state_cache = cache;
+  std::vector<double> rates;
+  event_calculator->calculate_rates(range, rates);
+  cache->occupation = occupation;
+  cache->is_complete = true;
+  Index n_not_normal = event_calculator->not_normal_count;
+
+  Index n_allowed = 0;
+  for (double temperature : {300.0, 900.0, 1200.0}) {
+    conditions->set_temperature(temperature);
+    ASSERT_TRUE(cache->is_complete_for(occupation));
+
+    // rescaled, reporting the same non-normal events
+    event_calculator->not_normal_count = 0;
+    cache->rescale_rates(conditions->beta);
+    event_calculator->log_not_normal(*cache);
+    std::vector<double> rescaled = cache->rate;
+    EXPECT_EQ(event_calculator->not_normal_count, n_not_normal);
+
+    // full recalculation
+    event_calculator->not_normal_count = 0;
+    n_allowed = 0;
+    for (Index event_index = 0; event_index < event_list.size();
+         ++event_index) {
+      double rate = event_calculator->calculate_rate(EventIndex(event_index));
+      if (rate == 0.0) {
+        EXPECT_EQ(rescaled[event_index], 0.0);
+      } else {
+        EXPECT_TRUE(
+            CASM::almost_equal(rescaled[event_index] / rate, 1.0, 1e-12));
+        ++n_allowed;
+      }
+    }
+    EXPECT_EQ(event_calculator->not_normal_count, n_not_normal);
+  }
+  EXPECT_GT(n_allowed, 0);
 }
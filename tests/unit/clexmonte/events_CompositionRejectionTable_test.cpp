@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "casm/clexmonte/events/CompositionRejectionTable.hh"
+#include "casm/clexmonte/events/SumTree.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(events_CompositionRejectionTable_Test, Test1) {
+  clexmonte::CompositionRejectionTable table({1.0, 0.0, 2.0, 3.0, 0.0});
+  EXPECT_EQ(table.size(), 5);
+  EXPECT_DOUBLE_EQ(table.total(), 6.0);
+  EXPECT_DOUBLE_EQ(table.value(2), 2.0);
+
+  // 1.0 in (0.5, 1], 2.0 in (1, 2], 3.0 in (2, 4]
+  EXPECT_EQ(table.n_bins(), 3);
+  EXPECT_EQ(table.bin_size(2), 1);
+
+  // 1.5 and 2.0 in (1, 2], 4.0 in (2, 4]
+  table.set(3, 0.0);
+  table.set(4, 4.0);
+  table.set(0, 1.5);
+  EXPECT_DOUBLE_EQ(table.total(), 7.5);
+  EXPECT_EQ(table.n_bins(), 2);
+  EXPECT_EQ(table.bin_size(2), 2);
+
+  table.set(2, 0.0);
+  EXPECT_EQ(table.n_bins(), 2);
+  EXPECT_DOUBLE_EQ(table.total(), 5.5);
+
+  EXPECT_THROW(table.set(0, -1.0), std::runtime_error);
+  EXPECT_THROW(table.reset({1.0, 2.0}), std::runtime_error);
+
+  clexmonte::CompositionRejectionTable empty(3);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+  EXPECT_THROW(empty.select(random_number_generator), std::runtime_error);
+}
+
+TEST(events_CompositionRejectionTable_Test, Test2) {
+  // selection frequencies, with values spanning several groups
+  std::vector<double> values = {1e-3, 0.0, 0.7, 0.9, 2.5, 1e-3, 5.0, 0.1};
+  clexmonte::CompositionRejectionTable table(values);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(1234));
+
+  Index n_select = 1000000;
+  std::vector<Index> count(values.size(), 0);
+  for (Index i = 0; i < n_select; ++i) {
+    ++count[table.select(random_number_generator)];
+  }
+  double total = table.total();
+  for (Index i = 0; i < values.size(); ++i) {
+    EXPECT_NEAR(double(count[i]) / n_select, values[i] / total, 2e-3);
+  }
+  EXPECT_EQ(count[1], 0);
+}
+
+TEST(events_CompositionRejectionTable_Test, Test3) {
+  // many updates: total must match the sum of values
+  Index n = 1000;
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> log_rate(-10.0, 5.0);
+  std::uniform_int_distribution<Index> index(0, n - 1);
+  std::vector<double> values(n);
+  for (double &x : values) {
+    x = std::exp(log_rate(engine));
+  }
+  clexmonte::CompositionRejectionTable table(values);
+  for (Index i = 0; i < 100000; ++i) {
+    Index j = index(engine);
+    values[j] = (i % 7 == 0) ? 0.0 : std::exp(log_rate(engine));
+    table.set(j, values[j]);
+  }
+  double total = 0.0;
+  for (double x : values) {
+    total += x;
+  }
+  EXPECT_NEAR(table.total(), total, 1e-10 * total);
+}
+
+namespace {
+
+/// Time `n_steps` select + update steps, as in rejection-free KMC with an
+/// impact list of size `n_impact`
+template <typename RateTableType>
+double time_steps(RateTableType &table, std::mt19937_64 &engine,
+                  Index n_steps, Index n_impact) {
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(engine()));
+  std::uniform_real_distribution<double> log_rate(-20.0, 5.0);
+  Index n = table.size();
+  auto begin = std::chrono::steady_clock::now();
+  for (Index step = 0; step < n_steps; ++step) {
+    Index selected = table.select(random_number_generator);
+    for (Index i = 0; i < n_impact; ++i) {
+      table.set((selected + i * 97) % n, std::exp(log_rate(engine)));
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double>(end - begin).count() / n_steps;
+}
+
+}  // namespace
+
+/// \brief Compare SumTree and CompositionRejectionTable select + update time
+///
+/// Run with `--gtest_also_run_disabled_tests`. The largest number of events
+/// is set by the environment variable CASM_BENCHMARK_MAX_EVENTS (default
+/// 1e6; 1e8 requires ~8 GB of memory).
+TEST(events_CompositionRejectionTable_Test, DISABLED_Benchmark) {
+  double max_events = 1e6;
+  if (char const *env = std::getenv("CASM_BENCHMARK_MAX_EVENTS")) {
+    max_events = std::atof(env);
+  }
+  Index n_steps = 100000;
+  Index n_impact = 20;
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> log_rate(-20.0, 5.0);
+
+  std::cout << "n_events  sum_tree (us/step)  composition_rejection (us/step)"
+            << std::endl;
+  for (double n_events = 1e4; n_events <= max_events; n_events *= 10.0) {
+    std::vector<double> values(static_cast<Index>(n_events));
+    for (double &x : values) {
+      x = std::exp(log_rate(engine));
+    }
+    double t_tree;
+    double t_cr;
+    {
+      clexmonte::SumTree tree(values);
+      t_tree = time_steps(tree, engine, n_steps, n_impact);
+    }
+    {
+      clexmonte::CompositionRejectionTable table(values);
+      t_cr = time_steps(table, engine, n_steps, n_impact);
+    }
+    std::cout << values.size() << "  " << t_tree * 1e6 << "  " << t_cr * 1e6
+              << std::endl;
+  }
+}
@@ -42,7 +42,7 @@ class events_EventStateCalculator_Test
     // modified directly instead of via occ_location->apply. Event calculations
     // would be still be correct.
     make_complete_event_list(state);
-    // std::cout << "#events: " << event_list.events.size() << std::endl;
+    // std::cout << "#events: " << event_list.size() << std::endl;
 
     /// Make std::shared_ptr<clexmonte::Conditions> object from state.conditions
     auto conditions = make_conditions(*system, state);
@@ -62,9 +62,12 @@ class events_EventStateCalculator_Test
     Index i = 0;
     Index n_allowed = 0;
     kinetic::EventState event_state;
-    for (auto const &event : event_list.events) {
-      auto const &event_id = event.first;
-      auto const &event_data = event.second;
+    for (Index event_index = 0; event_index < event_list.size();
+         ++event_index) {
+      auto event_id = event_list.event_id(event_index);
+      EventData event_data;
+      set_event_data(event_data, event_index, event_list, prim_event_list,
+                     *occ_location);
       auto const &prim_event_data = prim_event_list[event_id.prim_event_index];
       auto const &prim_event_calculator =
           prim_event_calculators[event_id.prim_event_index];
@@ -87,6 +90,71 @@ class events_EventStateCalculator_Test
     }
     EXPECT_EQ(n_allowed, 12);
   }
+
+  /// \brief Check that KRA and attempt frequency, calculated from the needed
+  ///     local correlations only, match the full local multi-cluster
+  ///     expansion
+  void check_local_corr(clexulator::SparseCoefficients const &kra_eci,
+                        clexulator::SparseCoefficients const &freq_eci) {
+    using namespace clexmonte;
+
+    // set coefficients for all event types
+    for (auto &pair : system->local_multiclex_data) {
+      auto &data = pair.second;
+      data.coefficients[data.coefficients_glossary.at("kra")] = kra_eci;
+      data.coefficients[data.coefficients_glossary.at("freq")] = freq_eci;
+    }
+
+    // A-B, with several Va
+    Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * 4;
+    state_type state(make_default_configuration(*system, T));
+    Eigen::VectorXi &occupation = get_occupation(state);
+    for (Index l = 0; l < occupation.size(); ++l) {
+      occupation(l) = (l % 3 == 0) ? 1 : 0;
+    }
+    occupation(0) = 2;
+    occupation(17) = 2;
+    occupation(101) = 2;
+    state.conditions.scalar_values.emplace("temperature", 600.0);
+
+    make_prim_event_list();
+    make_complete_event_list(state);
+    auto conditions = make_conditions(*system, state);
+    std::vector<kinetic::EventStateCalculator> prim_event_calculators =
+        kinetic::make_prim_event_calculators(system, state, prim_event_list,
+                                             conditions);
+
+    Index n_allowed = 0;
+    kinetic::EventState event_state;
+    for (Index event_index = 0; event_index < event_list.size();
+         ++event_index) {
+      auto event_id = event_list.event_id(event_index);
+      EventData event_data;
+      set_event_data(event_data, event_index, event_list, prim_event_list,
+                     *occ_location);
+      auto const &prim_event_data = prim_event_list[event_id.prim_event_index];
+      prim_event_calculators[event_id.prim_event_index].calculate_event_state(
+          event_state, event_data, prim_event_data);
+      if (!event_state.is_allowed) {
+        continue;
+      }
+
+      // full local multi-cluster expansion
+      LocalMultiClexData const &data =
+          get_local_multiclex_data(*system, prim_event_data.event_type_name);
+      Eigen::VectorXd const &values =
+          get_local_multiclex(*system, state, prim_event_data.event_type_name)
+              ->values(event_id.unitcell_index,
+                       prim_event_data.equivalent_index);
+      double expected_Ekra = values[data.coefficients_glossary.at("kra")];
+      double expected_freq = values[data.coefficients_glossary.at("freq")];
+      EXPECT_TRUE(CASM::almost_equal(event_state.Ekra, expected_Ekra, 1e-10));
+      EXPECT_TRUE(CASM::almost_equal(event_state.freq / expected_freq, 1.0,
+                                     1e-10));
+      ++n_allowed;
+    }
+    EXPECT_GT(n_allowed, 0);
+  }
 };
 
 /// \brief Test constructing event lists and calculating initial event states
@@ -110,3 +178,45 @@ TEST_F(events_EventStateCalculator_Test, Test2) {
   setup_input_files(true /*use_sparse_format_eci*/);
   run_checks();
 }
+
+/// \brief Test KRA from restricted local correlations, with constant
+///     attempt frequency
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell)
+/// - The attempt frequency has only the constant basis function, so its
+///   correlations are not evaluated
+TEST_F(events_EventStateCalculator_Test, Test3) {
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  clexulator::SparseCoefficients kra_eci;
+  kra_eci.index = {0, 1, 5, 9};
+  kra_eci.value = {1.0, 0.05, -0.02, 0.01};
+
+  clexulator::SparseCoefficients freq_eci;
+  freq_eci.index = {0};
+  freq_eci.value = {1e12};
+
+  check_local_corr(kra_eci, freq_eci);
+}
+
+/// \brief Test KRA and attempt frequency from restricted local
+///     correlations, with varying attempt frequency
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 4 x 4 x 4 (of the conventional 4-atom cell)
+TEST_F(events_EventStateCalculator_Test, Test4) {
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  clexulator::SparseCoefficients kra_eci;
+  kra_eci.index = {0, 1, 5, 9};
+  kra_eci.value = {1.0, 0.05, -0.02, 0.01};
+
+  clexulator::SparseCoefficients freq_eci;
+  freq_eci.index = {0, 2, 5};
+  freq_eci.value = {1e12, 1e10, -2e10};
+
+  check_local_corr(kra_eci, freq_eci);
+}
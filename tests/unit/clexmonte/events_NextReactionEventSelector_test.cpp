@@ -0,0 +1,122 @@
+#include "casm/clexmonte/events/NextReactionEventSelector.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Fixed rates, by EventIndex
+struct TestRateCalculator {
+  std::vector<double> rates;
+
+  double calculate_rate(clexmonte::EventIndex event_index) {
+    return rates[event_index];
+  }
+
+  void calculate_rates(clexmonte::EventIndexRange event_index_list,
+                       std::vector<double> &_rates) {
+    _rates.clear();
+    for (clexmonte::EventIndex event_index : event_index_list) {
+      _rates.push_back(rates[event_index]);
+    }
+  }
+};
+
+/// Every event impacts every event
+struct TestImpactTable {
+  std::vector<clexmonte::EventIndex> all;
+
+  clexmonte::EventIndexRange operator[](
+      clexmonte::EventIndex event_index) const {
+    clexmonte::EventIndexRange range;
+    range.begin_ptr = all.data();
+    range.end_ptr = all.data() + all.size();
+    return range;
+  }
+};
+
+}  // namespace
+
+TEST(events_IndexedMinHeap_Test, Test1) {
+  double inf = std::numeric_limits<double>::infinity();
+  clexmonte::IndexedMinHeap heap({3.0, inf, 1.0, 2.0, 5.0});
+  EXPECT_EQ(heap.top(), 2);
+  EXPECT_EQ(heap.top_key(), 1.0);
+
+  heap.set(4, 0.5);
+  EXPECT_EQ(heap.top(), 4);
+  heap.set(4, 6.0);
+  EXPECT_EQ(heap.top(), 2);
+  heap.set(2, inf);
+  EXPECT_EQ(heap.top(), 3);
+  heap.set(3, inf);
+  heap.set(0, inf);
+  EXPECT_EQ(heap.top(), 4);
+  EXPECT_EQ(heap.key(4), 6.0);
+}
+
+/// \brief Check selection frequencies and the mean time increment
+TEST(events_NextReactionEventSelector_Test, Test1) {
+  auto calculator = std::make_shared<TestRateCalculator>();
+  calculator->rates = {1.0, 2.0, 0.0, 1.0};
+  TestImpactTable impact_table;
+  impact_table.all = {0, 1, 2, 3};
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+
+  clexmonte::NextReactionEventSelector selector(calculator, 4, impact_table,
+                                                engine);
+  EXPECT_DOUBLE_EQ(selector.total_rate(), 4.0);
+
+  Index n_steps = 100000;
+  std::vector<Index> count(4, 0);
+  double time = 0.0;
+  for (Index i = 0; i < n_steps; ++i) {
+    auto result = selector.select_event();
+    ++count[result.first];
+    time += result.second;
+  }
+  EXPECT_NEAR(double(count[0]) / n_steps, 0.25, 0.01);
+  EXPECT_NEAR(double(count[1]) / n_steps, 0.5, 0.01);
+  EXPECT_EQ(count[2], 0);
+  EXPECT_NEAR(double(count[3]) / n_steps, 0.25, 0.01);
+  EXPECT_NEAR(time / n_steps, 1.0 / 4.0, 0.01);
+  EXPECT_NEAR(selector.time(), time, 1e-8 * time);
+}
+
+/// \brief Check rescheduling when all rates change at given times
+TEST(events_NextReactionEventSelector_Test, Test2) {
+  auto calculator = std::make_shared<TestRateCalculator>();
+  calculator->rates = {1.0, 1.0};
+  TestImpactTable impact_table;
+  impact_table.all = {0, 1};
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+
+  clexmonte::NextReactionEventSelector selector(calculator, 2, impact_table,
+                                                engine);
+
+  // total rate 2.0 for t < 1000.0, then 20.0 (with event 1 9x faster)
+  selector.set_rate_changes({1000.0},
+                            [&](Index change_index, std::vector<double> &rates) {
+                              calculator->rates = {2.0, 18.0};
+                              rates = calculator->rates;
+                            });
+
+  Index n_before = 0;
+  std::vector<Index> count_after(2, 0);
+  while (selector.time() < 2000.0) {
+    auto result = selector.select_event();
+    if (selector.time() < 1000.0) {
+      ++n_before;
+    } else if (selector.time() < 2000.0) {
+      ++count_after[result.first];
+    }
+  }
+  EXPECT_EQ(selector.n_rate_changes_applied(), 1);
+  EXPECT_DOUBLE_EQ(selector.total_rate(), 20.0);
+
+  // expected number of events: rate * time, +/- ~3 standard deviations
+  EXPECT_NEAR(n_before, 2000.0, 150.0);
+  EXPECT_NEAR(count_after[0] + count_after[1], 20000.0, 450.0);
+  EXPECT_NEAR(double(count_after[1]) / (count_after[0] + count_after[1]), 0.9,
+              0.01);
+}
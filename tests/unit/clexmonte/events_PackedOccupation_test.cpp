@@ -0,0 +1,54 @@
+#include "casm/clexmonte/events/PackedOccupation.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(events_PackedOccupation_Test, Test1) {
+  // 3 occupants -> 2 bits per site; 100 sites spans several words
+  Eigen::VectorXi occupation(100);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    occupation(l) = l % 3;
+  }
+  clexmonte::PackedOccupation packed(occupation, 3);
+  EXPECT_EQ(packed.bits_per_site(), 2);
+  EXPECT_EQ(packed.size(), 100);
+  for (Index l = 0; l < occupation.size(); ++l) {
+    EXPECT_EQ(packed.get(l), occupation(l));
+  }
+
+  packed.set(31, 2);
+  packed.set(32, 1);
+  EXPECT_EQ(packed.get(30), 0);
+  EXPECT_EQ(packed.get(31), 2);
+  EXPECT_EQ(packed.get(32), 1);
+  EXPECT_EQ(packed.get(33), 0);
+
+  clexmonte::PackedOccSignature signature(std::vector<int>{2, 1});
+  EXPECT_TRUE(packed.matches({31, 32}, signature));
+  EXPECT_FALSE(packed.matches({31, 33}, signature));
+
+  // more than 8 event sites -> more than one signature word
+  std::vector<Index> linear_site_index;
+  std::vector<int> occ;
+  for (Index l = 40; l < 52; ++l) {
+    linear_site_index.push_back(l);
+    occ.push_back(packed.get(l));
+  }
+  clexmonte::PackedOccSignature long_signature(occ);
+  EXPECT_EQ(long_signature.words.size(), 2);
+  EXPECT_TRUE(packed.matches(linear_site_index, long_signature));
+  packed.set(50, (packed.get(50) + 1) % 3);
+  EXPECT_FALSE(packed.matches(linear_site_index, long_signature));
+}
+
+TEST(events_PackedOccupation_Test, Test2) {
+  Eigen::VectorXi occupation = Eigen::VectorXi::Zero(10);
+  EXPECT_EQ(clexmonte::PackedOccupation(occupation, 1).bits_per_site(), 1);
+  EXPECT_EQ(clexmonte::PackedOccupation(occupation, 2).bits_per_site(), 1);
+  EXPECT_EQ(clexmonte::PackedOccupation(occupation, 4).bits_per_site(), 2);
+  EXPECT_EQ(clexmonte::PackedOccupation(occupation, 5).bits_per_site(), 4);
+  EXPECT_EQ(clexmonte::PackedOccupation(occupation, 17).bits_per_site(), 8);
+
+  occupation(3) = 2;
+  EXPECT_THROW(clexmonte::PackedOccupation(occupation, 2), std::runtime_error);
+}
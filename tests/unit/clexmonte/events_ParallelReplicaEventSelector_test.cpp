@@ -0,0 +1,137 @@
+#include <algorithm>
+
+#include "casm/clexmonte/events/ParallelReplicaEventSelector.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Basins are integers, with a flicker event 0 (rate `flicker_rate`) that
+/// stays in the basin, and an escape event 1 (rate `escape_rate`) to the
+/// next basin. Counts synchronizations where `changed_events` is not
+/// consistent with the replica and main state having a common earlier state.
+struct TestReplica {
+  double flicker_rate = 10.0;
+  double escape_rate = 1.0;
+  int const *main_state;
+  int state;
+  Index n_synchronize_errors = 0;
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+
+  TestReplica(int const *_main_state, std::shared_ptr<std::mt19937_64> engine)
+      : main_state(_main_state),
+        state(*_main_state),
+        random_number_generator(engine) {}
+
+  void synchronize(std::vector<clexmonte::EventIndex> const &changed_events) {
+    // common state, from n_changed == (state - common) + (main - common)
+    int n_changed = std::count(changed_events.begin(), changed_events.end(), 1);
+    int twice_common = state + *main_state - n_changed;
+    if (twice_common % 2 != 0 || twice_common < 0 ||
+        twice_common / 2 > std::min(state, *main_state)) {
+      ++n_synchronize_errors;
+    }
+    state = *main_state;
+  }
+
+  std::pair<clexmonte::EventIndex, double> select_event() {
+    double total_rate = flicker_rate + escape_rate;
+    clexmonte::EventIndex e =
+        random_number_generator.random_real(total_rate) < escape_rate ? 1 : 0;
+    double u = 1.0 - random_number_generator.random_real(1.0);
+    return std::make_pair(e, -std::log(u) / total_rate);
+  }
+
+  void apply(clexmonte::EventIndex e) {
+    if (e == 1) {
+      ++state;
+    }
+  }
+
+  std::uint64_t basin() const { return std::uint64_t(state); }
+};
+
+/// Apply events from `event_selector` to `main_state` until `n_escapes`
+/// escapes occur, and return the total time
+template <typename SelectorType>
+double run_escapes(SelectorType &event_selector, int &main_state,
+                   int n_escapes) {
+  double total_time = 0.0;
+  while (main_state < n_escapes) {
+    auto result = event_selector.select_event();
+    if (result.first == 1) {
+      ++main_state;
+    }
+    total_time += result.second;
+  }
+  return total_time;
+}
+
+}  // namespace
+
+/// \brief Check the mean escape time, with replicas run serially
+TEST(events_ParallelReplicaEventSelector_Test, Test1) {
+  int main_state = 0;
+  std::vector<std::shared_ptr<TestReplica>> replicas;
+  for (int k = 0; k < 4; ++k) {
+    replicas.push_back(std::make_shared<TestReplica>(
+        &main_state, std::make_shared<std::mt19937_64>(1000 + k)));
+  }
+  clexmonte::ParallelReplicaEventSelector<TestReplica> event_selector(
+      replicas, 0.1 /*correlation_time*/, 0.5 /*block_time*/);
+
+  int n_escapes = 4000;
+  double total_time = run_escapes(event_selector, main_state, n_escapes);
+
+  // escape is a Poisson process with rate 1.0
+  EXPECT_EQ(event_selector.n_replicas(), 4);
+  EXPECT_EQ(event_selector.n_escapes(), n_escapes);
+  EXPECT_GT(event_selector.n_correlated_escapes(), 0);
+  EXPECT_LT(event_selector.n_correlated_escapes(), 0.2 * n_escapes);
+  EXPECT_NEAR(event_selector.total_time(), total_time, 1e-8 * total_time);
+  EXPECT_NEAR(total_time / n_escapes, 1.0, 0.05);
+  for (auto const &replica : replicas) {
+    EXPECT_EQ(replica->n_synchronize_errors, 0);
+  }
+}
+
+/// \brief Check the mean escape time, with replicas run in parallel
+TEST(events_ParallelReplicaEventSelector_Test, Test2) {
+  int main_state = 0;
+  std::vector<std::shared_ptr<TestReplica>> replicas;
+  for (int k = 0; k < 4; ++k) {
+    replicas.push_back(std::make_shared<TestReplica>(
+        &main_state, std::make_shared<std::mt19937_64>(2000 + k)));
+  }
+  clexmonte::ParallelReplicaEventSelector<TestReplica> event_selector(
+      replicas, 0.1 /*correlation_time*/, 0.2 /*block_time*/,
+      std::make_shared<clexmonte::ThreadPool>(2));
+
+  int n_escapes = 4000;
+  double total_time = run_escapes(event_selector, main_state, n_escapes);
+
+  EXPECT_EQ(event_selector.n_escapes(), n_escapes);
+  EXPECT_GE(event_selector.n_path_events(), n_escapes);
+  EXPECT_GT(event_selector.n_replica_events(),
+            event_selector.n_path_events());
+  EXPECT_NEAR(total_time / n_escapes, 1.0, 0.05);
+  for (auto const &replica : replicas) {
+    EXPECT_EQ(replica->n_synchronize_errors, 0);
+  }
+}
+
+/// \brief Check that block_time must be > 0.0
+TEST(events_ParallelReplicaEventSelector_Test, Test3) {
+  int main_state = 0;
+  std::vector<std::shared_ptr<TestReplica>> replicas;
+  replicas.push_back(std::make_shared<TestReplica>(
+      &main_state, std::make_shared<std::mt19937_64>(3000)));
+  typedef clexmonte::ParallelReplicaEventSelector<TestReplica> selector_type;
+  EXPECT_THROW(selector_type(replicas, 0.1 /*correlation_time*/,
+                             0.0 /*block_time*/),
+               std::runtime_error);
+  EXPECT_NO_THROW(selector_type(replicas, 0.1 /*correlation_time*/,
+                                0.5 /*block_time*/));
+}
@@ -0,0 +1,91 @@
+#include <cmath>
+#include <map>
+
+#include "casm/clexmonte/events/RateClassTable.hh"
+#include "casm/monte/RandomNumberGenerator.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(events_RateClassTable_Test, Test1) {
+  clexmonte::RateClassTable table({1.0, 0.0, 1.0, 0.5, 0.0});
+  EXPECT_EQ(table.size(), 5);
+  EXPECT_DOUBLE_EQ(table.total(), 2.5);
+  EXPECT_DOUBLE_EQ(table.value(3), 0.5);
+
+  // 1.0 and 0.5 are class upper bounds, in separate classes
+  EXPECT_EQ(table.n_bins(), 2);
+  EXPECT_EQ(table.bin_size(0), 2);
+  EXPECT_EQ(table.bin_size(3), 1);
+  EXPECT_EQ(table.bin_size(1), 0);
+
+  // 0.8 is in the class below 1.0, (2^-0.5, 2^-0.25]
+  table.set(4, 0.8);
+  EXPECT_EQ(table.n_bins(), 3);
+  table.set(3, 0.0);
+  EXPECT_EQ(table.n_bins(), 2);
+  table.set(2, 0.75);
+  EXPECT_EQ(table.bin_size(4), 2);
+  EXPECT_DOUBLE_EQ(table.total(), 2.55);
+
+  EXPECT_THROW(table.set(0, -1.0), std::runtime_error);
+  EXPECT_THROW(table.reset({1.0, 2.0}), std::runtime_error);
+
+  clexmonte::RateClassTable empty(3);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+  EXPECT_THROW(empty.select(random_number_generator), std::runtime_error);
+}
+
+TEST(events_RateClassTable_Test, Test2) {
+  // selection frequencies, with Metropolis rates min(1, exp(-beta * dE))
+  std::vector<double> values = {1.0,  0.0,  1.0,        std::exp(-0.3),
+                                1e-3, 1e-3, std::exp(-2.0), 2.5};
+  clexmonte::RateClassTable table(values);
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator(
+      std::make_shared<std::mt19937_64>(1234));
+
+  Index n_select = 1000000;
+  std::vector<Index> count(values.size(), 0);
+  for (Index i = 0; i < n_select; ++i) {
+    ++count[table.select(random_number_generator)];
+  }
+  double total = table.total();
+  for (Index i = 0; i < values.size(); ++i) {
+    EXPECT_NEAR(double(count[i]) / n_select, values[i] / total, 2e-3);
+  }
+  EXPECT_EQ(count[1], 0);
+}
+
+TEST(events_RateClassTable_Test, Test3) {
+  // many updates: total must match the sum of values, and each value must
+  // be in the same class as values with the same quantized log(rate)
+  Index n = 1000;
+  std::mt19937_64 engine(1234);
+  std::uniform_real_distribution<double> log_rate(-30.0, 0.0);
+  std::uniform_int_distribution<Index> index(0, n - 1);
+  std::vector<double> values(n);
+  for (double &x : values) {
+    x = std::exp(log_rate(engine));
+  }
+  clexmonte::RateClassTable table(values);
+  for (Index i = 0; i < 100000; ++i) {
+    Index j = index(engine);
+    values[j] = (i % 7 == 0) ? 0.0 : (i % 5 == 0) ? 1.0
+                                                  : std::exp(log_rate(engine));
+    table.set(j, values[j]);
+  }
+  double total = 0.0;
+  for (double x : values) {
+    total += x;
+  }
+  EXPECT_NEAR(table.total(), total, 1e-10 * total);
+
+  int w = clexmonte::RateClassTable::bins_per_factor_of_2;
+  std::map<Index, Index> expected_class_size;
+  for (double x : values) {
+    if (x != 0.0) {
+      ++expected_class_size[std::floor(-std::log2(x) * w)];
+    }
+  }
+  EXPECT_EQ(table.n_bins(), expected_class_size.size());
+}
@@ -0,0 +1,107 @@
+#include "casm/clexmonte/events/RejectionEventSelector.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Fixed rates, by EventIndex
+struct TestRateCalculator {
+  std::vector<double> rates;
+  Index n_calculated = 0;
+
+  double calculate_rate(clexmonte::EventIndex event_index) {
+    ++n_calculated;
+    return rates[event_index];
+  }
+};
+
+}  // namespace
+
+/// \brief Check selection frequencies and the mean time increment
+///
+/// - 2 unit cells, 2 prim events; one event has rate 0
+TEST(events_RejectionEventSelector_Test, Test1) {
+  auto calculator = std::make_shared<TestRateCalculator>();
+  calculator->rates = {1.0, 2.0, 0.0, 1.0};
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+
+  clexmonte::RejectionEventSelector selector(calculator, 2, {2.0, 4.0},
+                                             engine);
+  EXPECT_DOUBLE_EQ(selector.total_rate(), 12.0);
+
+  Index n_steps = 100000;
+  std::vector<Index> count(4, 0);
+  double time = 0.0;
+  for (Index i = 0; i < n_steps; ++i) {
+    auto result = selector.select_event();
+    ++count[result.first];
+    time += result.second;
+  }
+
+  // selection probability is rate / total_rate, with total_rate = 4.0
+  EXPECT_NEAR(double(count[0]) / n_steps, 0.25, 0.01);
+  EXPECT_NEAR(double(count[1]) / n_steps, 0.5, 0.01);
+  EXPECT_EQ(count[2], 0);
+  EXPECT_NEAR(double(count[3]) / n_steps, 0.25, 0.01);
+  EXPECT_NEAR(time / n_steps, 1.0 / 4.0, 0.01);
+
+  // acceptance fraction is 4.0 / 12.0
+  EXPECT_EQ(selector.n_accepted(), n_steps);
+  EXPECT_EQ(selector.n_trials(), calculator->n_calculated);
+  EXPECT_NEAR(selector.rejection_fraction(), 2.0 / 3.0, 0.01);
+  EXPECT_EQ(selector.n_bound_exceeded(), 0);
+}
+
+/// \brief Check calibration and raising an exceeded upper bound
+TEST(events_RejectionEventSelector_Test, Test2) {
+  auto calculator = std::make_shared<TestRateCalculator>();
+  calculator->rates = {1.0, 2.0, 0.0, 3.0};
+
+  std::vector<double> max_rate =
+      clexmonte::calibrate_prim_event_rate_upper_bound(*calculator, 2, 2);
+  ASSERT_EQ(max_rate.size(), 2);
+  EXPECT_DOUBLE_EQ(max_rate[0], 1.0);
+  EXPECT_DOUBLE_EQ(max_rate[1], 3.0);
+
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  clexmonte::RejectionEventSelector selector(calculator, 2, {1.0, 1.0},
+                                             engine);
+  for (Index i = 0; i < 1000; ++i) {
+    selector.select_event();
+  }
+  EXPECT_GT(selector.n_bound_exceeded(), 0);
+  EXPECT_DOUBLE_EQ(selector.prim_event_rate_upper_bound()[1], 3.0);
+  EXPECT_DOUBLE_EQ(selector.total_rate(), 8.0);
+}
+
+/// \brief Check that selection is unbiased when upper bounds are exceeded
+///
+/// - Trials with rate > bound are repeated with the raised bound, so the
+///   selection frequencies and mean time increment match the rates
+TEST(events_RejectionEventSelector_Test, Test3) {
+  auto calculator = std::make_shared<TestRateCalculator>();
+  calculator->rates = {1.0, 2.0, 0.0, 3.0};
+
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+  clexmonte::RejectionEventSelector selector(calculator, 2, {0.5, 0.5},
+                                             engine);
+  Index n_steps = 100000;
+  std::vector<Index> count(4, 0);
+  double time = 0.0;
+  for (Index i = 0; i < n_steps; ++i) {
+    auto result = selector.select_event();
+    ++count[result.first];
+    time += result.second;
+  }
+
+  // total_rate = 6.0
+  EXPECT_GE(selector.n_bound_exceeded(), 2);
+  EXPECT_LE(selector.n_bound_exceeded(), 3);
+  EXPECT_EQ(selector.n_accepted(), n_steps);
+  EXPECT_NEAR(double(count[0]) / n_steps, 1.0 / 6.0, 0.01);
+  EXPECT_NEAR(double(count[1]) / n_steps, 2.0 / 6.0, 0.01);
+  EXPECT_EQ(count[2], 0);
+  EXPECT_NEAR(double(count[3]) / n_steps, 3.0 / 6.0, 0.01);
+  EXPECT_NEAR(time / n_steps, 1.0 / 6.0, 0.01);
+}
@@ -1,5 +1,8 @@
+#include <algorithm>
+
 #include "KMCCompleteEventCalculatorTestSystem.hh"
-#include "casm/clexmonte/events/lotto.hh"
+#include "casm/clexmonte/events/ActiveEventSelector.hh"
+#include "casm/clexmonte/events/RejectionFreeEventSelector.hh"
 #include "casm/clexmonte/kinetic/io/stream/EventState_stream_io.hh"
 #include "casm/clexmonte/kinetic/kinetic_events.hh"
 #include "casm/clexmonte/state/Configuration.hh"
@@ -49,10 +52,8 @@ TEST_F(events_RejectionFree_Test, Test1) {
   make_complete_event_calculator(state);
 
   // Make selector
-  lotto::RejectionFreeEventSelector selector(
-      event_calculator,
-      clexmonte::make_complete_event_id_list(T.determinant(), prim_event_list),
-      event_list.impact_table);
+  clexmonte::RejectionFreeEventSelector selector(
+      event_calculator, event_list.size(), event_list.impact_table);
 
   // Run
   std::cout << "Begin run: " << std::endl;
@@ -63,7 +64,8 @@ TEST_F(events_RejectionFree_Test, Test1) {
   auto index_converter = occ_location->convert().index_converter();
   auto const &basicstructure = *system->prim->basicstructure;
   xtal::UnitCell translation;
-  clexmonte::EventID id;
+  clexmonte::EventIndex id;
+  monte::OccEvent event;
   double time_step;
 
   Index i = 0;
@@ -92,16 +94,18 @@ TEST_F(events_RejectionFree_Test, Test1) {
     std::tie(id, time_step) = selector.select_event();
 
     // std::cout << "--- " << i << " ---" << std::endl;
-    // std::cout << "prim_event_index: " << id.prim_event_index << std::endl;
-    // std::cout << "unitcell_index: " << id.unitcell_index
+    // EventID event_id = event_list.event_id(id);
+    // std::cout << "prim_event_index: " << event_id.prim_event_index
+    //     << std::endl;
+    // std::cout << "unitcell_index: " << event_id.unitcell_index
     //     << "   translation: " <<
-    //     unitcell_index_converter(id.unitcell_index).transpose()
+    //     unitcell_index_converter(event_id.unitcell_index).transpose()
     //     << std::endl;
     // std::cout << std::endl;
 
     // Apply accepted event
-    auto const &event_data = event_list.events.at(id);
-    occ_location->apply(event_data.event, occupation);
+    set_event(event, id, event_list, prim_event_list, *occ_location);
+    occ_location->apply(event, occupation);
     time += time_step;
   }
   print_state();
@@ -109,3 +113,149 @@ TEST_F(events_RejectionFree_Test, Test1) {
 
   EXPECT_TRUE(true);
 }
+
+/// \brief Test the active event selector, checking the active events against
+///     the occupation
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 5 x 5 x 5 (of the conventional 4-atom cell), 3 Va
+TEST_F(events_RejectionFree_Test, Test2) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  Index dim = 5;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+  occupation(1) = 2;
+  occupation(2) = 2;
+  state.conditions.scalar_values.emplace("temperature", 600);
+
+  make_complete_event_calculator(state);
+
+  std::vector<std::vector<bool>> is_defect =
+      make_is_defect(*system->prim->basicstructure, {"Va"});
+  ActiveEventList active_event_list(
+      prim_event_list, event_list,
+      occ_location->convert().unitcell_index_converter(), is_defect);
+  active_event_list.initialize(occupation);
+  ActiveEventSelector selector(event_calculator, active_event_list,
+                               event_list.impact_table);
+
+  // 3 Va x 12 neighbors x 2 (A or B hop) x 1 direction (Va init)
+  EXPECT_EQ(selector.size(), 3 * 12 * 2);
+
+  auto check_active = [&]() {
+    std::vector<Index> linear_site_index;
+    Index n_active = 0;
+    for (Index i = 0; i < event_list.size(); ++i) {
+      EventID event_id = event_list.event_id(i);
+      PrimEventData const &prim_event_data =
+          prim_event_list[event_id.prim_event_index];
+      event_list.site_table.set_linear_site_index(
+          linear_site_index, event_id.unitcell_index,
+          event_id.prim_event_index);
+      bool expected = false;
+      for (Index j = 0; j < linear_site_index.size(); ++j) {
+        Index b = prim_event_data.sites[j].sublattice();
+        if (is_defect[b][prim_event_data.occ_init[j]] &&
+            is_defect[b][occupation(linear_site_index[j])]) {
+          expected = true;
+        }
+      }
+      ASSERT_EQ(active_event_list.is_active(i), expected);
+      if (expected) {
+        ++n_active;
+        EXPECT_EQ(selector.get_rate(i), event_calculator->calculate_rate(i));
+      }
+    }
+    EXPECT_EQ(active_event_list.size(), n_active);
+  };
+
+  EventIndex id;
+  monte::OccEvent event;
+  double time_step;
+  for (Index i = 0; i < 200; ++i) {
+    std::tie(id, time_step) = selector.select_event();
+    EXPECT_GT(selector.get_rate(id), 0.0);
+    set_event(event, id, event_list, prim_event_list, *occ_location);
+    occ_location->apply(event, occupation);
+    if (i % 50 == 0) {
+      // update is applied at the beginning of the next selection
+      std::tie(id, time_step) = selector.select_event();
+      check_active();
+      set_event(event, id, event_list, prim_event_list, *occ_location);
+      occ_location->apply(event, occupation);
+    }
+  }
+}
+
+/// \brief Test parallel impacted rate updates in a small supercell, in which
+///     periodic images would give duplicate impact table entries
+///
+/// Notes:
+/// - FCC A-B-Va, 1NN interactions, A-Va and B-Va hops
+/// - 1 x 1 x 1 (of the conventional 4-atom cell), 1 Va
+TEST_F(events_RejectionFree_Test, Test3) {
+  using namespace clexmonte;
+  setup_input_files(false /*use_sparse_format_eci*/);
+
+  Index dim = 1;
+  Eigen::Matrix3l T = test::fcc_conventional_transf_mat() * dim;
+  monte::State<clexmonte::Configuration> state(
+      make_default_configuration(*system, T));
+  Eigen::VectorXi &occupation = get_occupation(state);
+  occupation(0) = 2;
+  occupation(1) = 1;
+  state.conditions.scalar_values.emplace("temperature", 600);
+
+  make_complete_event_calculator(state);
+
+  // impact table rows have unique entries
+  for (Index i = 0; i < event_list.size(); ++i) {
+    EventIndexRange impacted = event_list.impact_table[i];
+    std::vector<EventIndex> sorted(impacted.begin(), impacted.end());
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::adjacent_find(sorted.begin(), sorted.end()) ==
+                sorted.end());
+  }
+
+  // update all impacted rates in parallel
+  int n_threads = 4;
+  std::vector<std::vector<kinetic::EventStateCalculator>>
+      thread_prim_event_calculators;
+  std::vector<std::shared_ptr<kinetic::CompleteEventCalculator>>
+      thread_event_calculators;
+  for (int i = 0; i < n_threads; ++i) {
+    thread_prim_event_calculators.push_back(kinetic::make_prim_event_calculators(
+        system, state, prim_event_list, conditions, true /*independent_clex*/));
+  }
+  for (int i = 0; i < n_threads; ++i) {
+    thread_event_calculators.push_back(
+        std::make_shared<kinetic::CompleteEventCalculator>(
+            prim_event_list, thread_prim_event_calculators[i], event_list,
+            CASM::null_log()));
+  }
+  RejectionFreeEventSelector selector(event_calculator, event_list.size(),
+                                      event_list.impact_table,
+                                      std::make_shared<std::mt19937_64>(1234),
+                                      thread_event_calculators);
+  selector.set_parallel_update(std::make_shared<ThreadPool>(n_threads), 1);
+
+  // compare with serially calculated rates
+  EventIndex id;
+  monte::OccEvent event;
+  double time_step;
+  for (Index i = 0; i < 100; ++i) {
+    std::tie(id, time_step) = selector.select_event();
+    set_event(event, id, event_list, prim_event_list, *occ_location);
+    occ_location->apply(event, occupation);
+    selector.update_impacted_event_rates();
+    for (Index j = 0; j < event_list.size(); ++j) {
+      ASSERT_EQ(selector.get_rate(j), event_calculator->calculate_rate(j));
+    }
+  }
+}
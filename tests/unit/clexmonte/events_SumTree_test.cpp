@@ -0,0 +1,65 @@
+#include "casm/clexmonte/events/SumTree.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(events_SumTree_Test, Test1) {
+  clexmonte::SumTree tree({1.0, 0.0, 2.0, 3.0, 0.0});
+  EXPECT_EQ(tree.size(), 5);
+  EXPECT_DOUBLE_EQ(tree.total(), 6.0);
+  EXPECT_DOUBLE_EQ(tree.value(2), 2.0);
+
+  EXPECT_EQ(tree.find(0.0), 0);
+  EXPECT_EQ(tree.find(0.999), 0);
+  EXPECT_EQ(tree.find(1.0), 2);
+  EXPECT_EQ(tree.find(2.999), 2);
+  EXPECT_EQ(tree.find(3.0), 3);
+  EXPECT_EQ(tree.find(5.999), 3);
+
+  // zero-valued trailing leaves are never selected
+  EXPECT_EQ(tree.find(6.0), 3);
+
+  tree.set(3, 0.0);
+  tree.set(4, 4.0);
+  EXPECT_DOUBLE_EQ(tree.total(), 7.0);
+  EXPECT_EQ(tree.find(3.0), 4);
+  EXPECT_EQ(tree.find(6.999), 4);
+}
+
+TEST(events_SumTree_Test, Test2) {
+  clexmonte::SumTree tree(3);
+  EXPECT_DOUBLE_EQ(tree.total(), 0.0);
+  EXPECT_THROW(tree.find(0.0), std::runtime_error);
+  EXPECT_THROW(tree.reset({1.0, 2.0}), std::runtime_error);
+}
+
+TEST(events_SumTree_Test, Test3) {
+  // multi-threaded build must be identical to single-threaded build
+  std::vector<double> values(100000);
+  for (Index i = 0; i < values.size(); ++i) {
+    values[i] = 1.0 / (1.0 + i % 97) + 1e-3 * (i % 13);
+  }
+  clexmonte::SumTree serial(values, 1);
+  clexmonte::SumTree parallel(values, 4);
+  EXPECT_EQ(serial.total(), parallel.total());
+  for (Index i = 0; i < values.size(); i += 997) {
+    double x = serial.total() * i / values.size();
+    EXPECT_EQ(serial.find(x), parallel.find(x));
+  }
+}
+
+TEST(events_SumTree_Test, Test4) {
+  // resize keeps existing values
+  clexmonte::SumTree tree({1.0, 2.0, 3.0});
+  tree.resize(9);
+  EXPECT_EQ(tree.size(), 9);
+  EXPECT_DOUBLE_EQ(tree.total(), 6.0);
+  tree.set(8, 4.0);
+  EXPECT_DOUBLE_EQ(tree.total(), 10.0);
+  EXPECT_EQ(tree.find(6.5), 8);
+
+  tree.resize(2);
+  EXPECT_EQ(tree.size(), 2);
+  EXPECT_DOUBLE_EQ(tree.total(), 3.0);
+  EXPECT_DOUBLE_EQ(tree.value(1), 2.0);
+}
@@ -0,0 +1,127 @@
+#include <optional>
+
+#include "casm/clexmonte/events/SuperbasinEventSelector.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Two states, A=0 and B=1, with flicker events A->B and B->A (rate
+/// `flicker_rate`), and exit events A->C and B->C (rate 1.0) to the
+/// absorbing state C=2
+struct TestEventSelector {
+  double flicker_rate = 1000.0;
+  int *state;
+  std::vector<double> rates;
+  std::optional<clexmonte::EventIndex> last_selected;
+  monte::RandomNumberGenerator<std::mt19937_64> random_number_generator;
+
+  TestEventSelector(int *_state, std::shared_ptr<std::mt19937_64> engine)
+      : state(_state), random_number_generator(engine) {
+    _calculate_rates();
+  }
+
+  void _calculate_rates() {
+    if (*state == 0) {
+      rates = {flicker_rate, 0.0, 1.0, 0.0};
+    } else if (*state == 1) {
+      rates = {0.0, flicker_rate, 0.0, 1.0};
+    } else {
+      rates = {0.0, 0.0, 0.0, 0.0};
+    }
+  }
+
+  void update_impacted_event_rates() {
+    if (last_selected.has_value()) {
+      _calculate_rates();
+      last_selected.reset();
+    }
+  }
+
+  std::pair<clexmonte::EventIndex, double> select_event() {
+    update_impacted_event_rates();
+    double x = random_number_generator.random_real(total_rate());
+    clexmonte::EventIndex e = 0;
+    while (e < 3 && (x >= rates[e] || rates[e] == 0.0)) {
+      x -= rates[e];
+      ++e;
+    }
+    last_selected = e;
+    double u = 1.0 - random_number_generator.random_real(1.0);
+    return std::make_pair(e, -std::log(u) / total_rate());
+  }
+
+  double total_rate() const {
+    return rates[0] + rates[1] + rates[2] + rates[3];
+  }
+  double get_rate(clexmonte::EventIndex e) const { return rates[e]; }
+  void set_rate(clexmonte::EventIndex e, double rate) { rates[e] = rate; }
+  void set_last_selected(clexmonte::EventIndex e) {
+    update_impacted_event_rates();
+    last_selected = e;
+  }
+};
+
+}  // namespace
+
+/// \brief Check the mean rate method for a 2-state flicker
+TEST(events_Superbasin_Test, Test1) {
+  // A <-> B with rate a, exits with rate e from both
+  double a = 1000.0;
+  double e = 1.0;
+  double R = a + e;
+  clexmonte::Superbasin superbasin;
+  Index A = superbasin.insert(11);
+  Index B = superbasin.insert(22);
+  EXPECT_EQ(superbasin.find(22), B);
+  EXPECT_EQ(superbasin.find(33), -1);
+  EXPECT_FALSE(superbasin.is_complete());
+  superbasin.add_transition(A, 0, a, B);
+  superbasin.add_transition(B, 1, a, A);
+  superbasin.set_total_rate(A, R);
+  superbasin.set_total_rate(B, R);
+
+  double mean_exit_time;
+  Eigen::VectorXd exit_probability;
+  ASSERT_TRUE(superbasin.solve(A, mean_exit_time, exit_probability));
+  EXPECT_NEAR(mean_exit_time, 1.0 / e, 1e-8);
+  EXPECT_NEAR(exit_probability(A), R / (R + a), 1e-8);
+  EXPECT_NEAR(exit_probability(B), a / (R + a), 1e-8);
+
+  std::vector<clexmonte::EventIndex> path = superbasin.path(B, A);
+  ASSERT_EQ(path.size(), 1);
+  EXPECT_EQ(path[0], 1);
+}
+
+/// \brief Check the exit time and number of steps for a 2-state flicker
+TEST(events_SuperbasinEventSelector_Test, Test1) {
+  std::vector<int> final_state = {1, 0, 2, 2};
+  auto engine = std::make_shared<std::mt19937_64>(1234);
+
+  Index n_trials = 1000;
+  double total_time = 0.0;
+  Index total_steps = 0;
+  Index total_exits = 0;
+  for (Index trial = 0; trial < n_trials; ++trial) {
+    int state = 0;
+    TestEventSelector event_selector(&state, engine);
+    clexmonte::SuperbasinEventSelector superbasin_selector(
+        event_selector, [&]() { return std::uint64_t(state); },
+        20 /*min_steps*/, 4 /*max_states*/, engine);
+    while (state != 2) {
+      auto result = superbasin_selector.select_event();
+      ASSERT_GT(event_selector.rates[result.first], 0.0);
+      state = final_state[result.first];
+      total_time += result.second;
+      ++total_steps;
+    }
+    total_exits += superbasin_selector.n_superbasin_exits();
+  }
+
+  // mean exit time is 1.0; without acceleration there would be ~1000 steps
+  // per trial
+  EXPECT_NEAR(total_time / n_trials, 1.0, 0.05);
+  EXPECT_LT(double(total_steps) / n_trials, 30.0);
+  EXPECT_GT(total_exits, 0.9 * n_trials);
+}
@@ -0,0 +1,132 @@
+#include "casm/clexmonte/events/DomainDecomposition.hh"
+#include "casm/clexmonte/events/SynchronousSublatticeEventSelector.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+namespace {
+
+/// Fixed rates, by EventIndex
+struct TestRateCalculator {
+  std::vector<double> rates;
+
+  void calculate_rates(clexmonte::EventIndexRange event_index_list,
+                       std::vector<double> &_rates) {
+    _rates.clear();
+    for (clexmonte::EventIndex event_index : event_index_list) {
+      _rates.push_back(rates[event_index]);
+    }
+  }
+};
+
+/// Each event impacts the events in neighboring unit cells
+struct TestImpactTable {
+  std::vector<std::vector<clexmonte::EventIndex>> impacted;
+
+  clexmonte::EventIndexRange operator[](
+      clexmonte::EventIndex event_index) const {
+    clexmonte::EventIndexRange range;
+    range.begin_ptr = impacted[event_index].data();
+    range.end_ptr = range.begin_ptr + impacted[event_index].size();
+    return range;
+  }
+};
+
+std::vector<std::vector<clexmonte::RelativeEventID>>
+make_nearest_neighbor_impact() {
+  std::vector<clexmonte::RelativeEventID> impacted;
+  for (Index a = 0; a < 3; ++a) {
+    for (int s : {-1, 1}) {
+      clexmonte::RelativeEventID relative_event_id;
+      relative_event_id.prim_event_index = 0;
+      relative_event_id.translation = xtal::UnitCell(0, 0, 0);
+      relative_event_id.translation(a) = s;
+      impacted.push_back(relative_event_id);
+    }
+  }
+  return {impacted};
+}
+
+}  // namespace
+
+/// \brief Check domain and sector assignment
+TEST(events_DomainDecomposition_Test, Test1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 8;
+  xtal::UnitCellIndexConverter unitcell_index_converter(T);
+  clexmonte::DomainDecomposition domain_decomposition(
+      T, unitcell_index_converter, Eigen::Vector3l(2, 2, 1),
+      make_nearest_neighbor_impact());
+  EXPECT_EQ(domain_decomposition.n_domains, 4);
+  EXPECT_EQ(domain_decomposition.n_sectors, 4);
+
+  std::vector<Index> count(16, 0);
+  for (Index u = 0; u < 512; ++u) {
+    Index domain = domain_decomposition.unitcell_domain[u];
+    Index sector = domain_decomposition.unitcell_sector[u];
+    ++count[domain * 4 + sector];
+
+    xtal::UnitCell unitcell = unitcell_index_converter(u);
+    EXPECT_EQ(domain, (unitcell(0) / 4) * 2 + unitcell(1) / 4);
+    EXPECT_EQ(sector, ((unitcell(0) / 2) % 2) * 2 + (unitcell(1) / 2) % 2);
+  }
+  for (Index c : count) {
+    EXPECT_EQ(c, 32);
+  }
+
+  // sectors of width 0.5 unit cells are narrower than the impact range
+  EXPECT_THROW(clexmonte::DomainDecomposition(T, unitcell_index_converter,
+                                              Eigen::Vector3l(8, 1, 1),
+                                              make_nearest_neighbor_impact()),
+               std::runtime_error);
+}
+
+/// \brief Check the number of events per unit time, with constant rates
+TEST(events_SynchronousSublatticeEventSelector_Test, Test1) {
+  Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 8;
+  xtal::UnitCellIndexConverter unitcell_index_converter(T);
+  auto relative_impact_table = make_nearest_neighbor_impact();
+  clexmonte::DomainDecomposition domain_decomposition(
+      T, unitcell_index_converter, Eigen::Vector3l(2, 2, 2),
+      relative_impact_table);
+
+  Index n_events = 512;
+  TestImpactTable impact_table;
+  for (Index u = 0; u < n_events; ++u) {
+    impact_table.impacted.push_back({clexmonte::EventIndex(u)});
+    for (auto const &relative_event_id : relative_impact_table[0]) {
+      impact_table.impacted.back().push_back(
+          clexmonte::EventIndex(unitcell_index_converter(
+              unitcell_index_converter(u) + relative_event_id.translation)));
+    }
+  }
+
+  std::vector<std::shared_ptr<TestRateCalculator>> calculators;
+  for (int i = 0; i < 2; ++i) {
+    calculators.push_back(std::make_shared<TestRateCalculator>());
+    calculators.back()->rates.assign(n_events, 1.0);
+  }
+  std::vector<Index> n_applied(2, 0);
+  clexmonte::SynchronousSublatticeEventSelector<TestRateCalculator,
+                                                TestImpactTable>
+      selector(
+          calculators, domain_decomposition, 1, impact_table,
+          [&](int thread_index, clexmonte::EventIndex event_index) {
+            ++n_applied[thread_index];
+          },
+          0.01 /*time_window*/, std::make_shared<std::mt19937_64>(1234),
+          std::make_shared<clexmonte::ThreadPool>(2));
+  EXPECT_DOUBLE_EQ(selector.total_rate(), 512.0);
+
+  // rates are constant, so events occur at the total rate
+  double time = 0.0;
+  Index count = 0;
+  while (time < 20.0) {
+    auto result = selector.select_event();
+    EXPECT_GE(result.second, 0.0);
+    time += result.second;
+    ++count;
+  }
+  EXPECT_NEAR(count / time, 512.0, 0.05 * 512.0);
+  EXPECT_EQ(selector.n_events(), n_applied[0] + n_applied[1]);
+  EXPECT_LE(time, selector.n_windows() * 0.01 + 1e-8);
+}
@@ -1,8 +1,12 @@
+#include <fstream>
+
 #include "KMCTestSystem.hh"
 #include "gtest/gtest.h"
 
 // impact table & event lists
 #include "casm/clexmonte/events/CompleteEventList.hh"
+#include "casm/clexmonte/events/ImpactTable.hh"
+#include "casm/clexmonte/events/PrimEventCache.hh"
 #include "casm/clexmonte/events/event_methods.hh"
 #include "casm/clexmonte/state/Configuration.hh"
 #include "casm/monte/events/OccLocation.hh"
@@ -63,10 +67,10 @@ TEST_F(events_impact_table_Test, Test1) {
       prim_event_list, prim_impact_info_list, occ_location);
   EXPECT_EQ(event_list.impact_table.size(), 1000 * 24);
 
-  for (auto const &impacted : event_list.impact_table) {
-    EXPECT_EQ(impacted.second.size(), 708);
+  for (Index i = 0; i < event_list.impact_table.size(); ++i) {
+    EXPECT_EQ(event_list.impact_table[i].size(), 708);
   }
-  EXPECT_EQ(event_list.events.size(), 1000 * 24);
+  EXPECT_EQ(event_list.size(), 1000 * 24);
 }
 
 /// \brief Simpler test:
@@ -110,6 +114,56 @@ TEST_F(events_impact_table_Test, Test2) {
 
   // print_impact_info(prim_impact_info_list);
 
+  // prim event cache: written by the first call, read by the second
+  fs::path cache_dir =
+      fs::temp_directory_path() / "clexmonte_events_impact_table_Test2";
+  fs::remove_all(cache_dir);
+  for (Index i = 0; i < 2; ++i) {
+    clexmonte::PrimEventCacheData cache_data =
+        clexmonte::make_prim_event_cache_data(*system, prim_event_list,
+                                              {"formation_energy"}, {},
+                                              cache_dir.string());
+    EXPECT_EQ(std::distance(fs::directory_iterator(cache_dir),
+                            fs::directory_iterator()),
+              1);
+    ASSERT_EQ(cache_data.prim_impact_info_list.size(),
+              prim_impact_info_list.size());
+    for (Index j = 0; j < prim_impact_info_list.size(); ++j) {
+      auto const &impact = cache_data.prim_impact_info_list[j];
+      EXPECT_EQ(impact.phenomenal_sites,
+                prim_impact_info_list[j].phenomenal_sites);
+      EXPECT_EQ(impact.required_update_neighborhood,
+                prim_impact_info_list[j].required_update_neighborhood);
+    }
+    auto expected =
+        clexmonte::make_relative_impact_table(prim_impact_info_list);
+    ASSERT_EQ(cache_data.relative_impact_table.size(), expected.size());
+    for (Index j = 0; j < expected.size(); ++j) {
+      auto const &impacted = cache_data.relative_impact_table[j];
+      ASSERT_EQ(impacted.size(), expected[j].size());
+      for (Index k = 0; k < expected[j].size(); ++k) {
+        EXPECT_EQ(impacted[k].prim_event_index,
+                  expected[j][k].prim_event_index);
+        EXPECT_EQ(impacted[k].translation, expected[j][k].translation);
+      }
+    }
+  }
+
+  // a corrupt cache, with an event count larger than the file, is not read
+  {
+    fs::path filepath = cache_dir / "corrupt.bin";
+    std::ofstream out(filepath, std::ios::binary);
+    char const magic[8] = {'C', 'L', 'X', 'M', 'P', 'E', 'C', '\0'};
+    std::int64_t values[3] = {1, 0, std::int64_t(1) << 40};
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<char const *>(values), sizeof(values));
+    out.close();
+    clexmonte::PrimEventCacheData cache_data;
+    EXPECT_FALSE(clexmonte::read_prim_event_cache(cache_data, filepath, 0));
+    EXPECT_EQ(cache_data.prim_impact_info_list.size(), 0);
+  }
+  fs::remove_all(cache_dir);
+
   // Create config
   Eigen::Matrix3l T = Eigen::Matrix3l::Identity() * 10;
   monte::State<clexmonte::Configuration> state(
@@ -122,10 +176,93 @@ TEST_F(events_impact_table_Test, Test2) {
       prim_event_list, prim_impact_info_list, occ_location);
   EXPECT_EQ(event_list.impact_table.size(), 1000 * 12);
 
-  for (auto const &impacted : event_list.impact_table) {
-    EXPECT_EQ(impacted.second.size(), 46);
+  for (Index i = 0; i < event_list.impact_table.size(); ++i) {
+    EXPECT_EQ(event_list.impact_table[i].size(), 46);
+  }
+  EXPECT_EQ(event_list.size(), 1000 * 12);
+
+  // compare with SupercellEventImpactTable
+  auto const &unitcell_converter =
+      occ_location.convert().unitcell_index_converter();
+  clexmonte::SupercellEventImpactTable supercell_impact_table(
+      prim_impact_info_list, unitcell_converter);
+  clexmonte::RelativeEventImpactTable relative_impact_table(
+      prim_impact_info_list, unitcell_converter);
+  for (Index i = 0; i < event_list.size(); ++i) {
+    clexmonte::EventID event_id = event_list.event_id(i);
+    auto const &expected = supercell_impact_table(event_id);
+    auto impacted = event_list.impact_table[i];
+    ASSERT_EQ(impacted.size(), expected.size());
+    for (Index j = 0; j < impacted.size(); ++j) {
+      EXPECT_EQ(impacted[j], event_list.event_index(expected[j]));
+    }
+  }
+  EXPECT_LT(relative_impact_table.memory_usage(),
+            event_list.impact_table.memory_usage());
+  EXPECT_LT(event_list.impact_table.memory_usage(),
+            supercell_impact_table.memory_usage());
+
+  // compare with multi-threaded construction
+  clexmonte::CompleteEventList event_list_mt =
+      clexmonte::make_complete_event_list(prim_event_list,
+                                          prim_impact_info_list, occ_location,
+                                          {}, 4 /*n_threads*/);
+  ASSERT_EQ(event_list_mt.size(), event_list.size());
+  for (Index i = 0; i < event_list.size(); ++i) {
+    auto impacted = event_list.impact_table[i];
+    auto impacted_mt = event_list_mt.impact_table[i];
+    ASSERT_EQ(impacted_mt.size(), impacted.size());
+    for (Index j = 0; j < impacted.size(); ++j) {
+      EXPECT_EQ(impacted_mt[j], impacted[j]);
+    }
+  }
+
+  // compare site table with set_event
+  monte::OccEvent event;
+  std::vector<Index> linear_site_index;
+  for (Index i = 0; i < event_list.size(); ++i) {
+    clexmonte::EventID event_id = event_list.event_id(i);
+    set_event(event, i, event_list, prim_event_list, occ_location);
+    event_list.site_table.set_linear_site_index(
+        linear_site_index, event_id.unitcell_index, event_id.prim_event_index);
+    EXPECT_EQ(linear_site_index, event.linear_site_index);
+  }
+
+  // event filters: a slab by region, and a unit cell listed by index
+  clexmonte::EventFilterGroup slab_filter;
+  clexmonte::UnitCellRegion slab;
+  slab.min(2) = 2;
+  slab.max(2) = 3;
+  slab_filter.regions.push_back(slab);
+  slab_filter.include_by_default = false;
+  slab_filter.prim_event_index = {0, 1};
+
+  clexmonte::EventFilterGroup index_filter;
+  index_filter.unitcell_index = {0};
+  index_filter.include_by_default = true;
+  index_filter.prim_event_index = {5};
+
+  clexmonte::CompleteEventList filtered_event_list =
+      clexmonte::make_complete_event_list(prim_event_list,
+                                          prim_impact_info_list, occ_location,
+                                          {slab_filter, index_filter});
+  Index n_included = 0;
+  for (Index i = 0; i < filtered_event_list.size(); ++i) {
+    clexmonte::EventID event_id = filtered_event_list.event_id(i);
+    xtal::UnitCell unitcell = unitcell_converter(event_id.unitcell_index);
+    bool expected = true;
+    if (unitcell(2) >= 2 && unitcell(2) <= 3) {
+      expected = (event_id.prim_event_index < 2);
+    } else if (event_id.unitcell_index == 0) {
+      expected = (event_id.prim_event_index != 5);
+    }
+    EXPECT_EQ(filtered_event_list.is_included[i], expected);
+    if (filtered_event_list.is_included[i]) {
+      ++n_included;
+    }
   }
-  EXPECT_EQ(event_list.events.size(), 1000 * 12);
+  // 200 unit cells in slab: 2 events each; 800 other: 12 events; minus 1
+  EXPECT_EQ(n_included, 200 * 2 + 800 * 12 - 1);
 }
 
 // /// \brief Useful for big supercell tests
@@ -172,7 +309,7 @@ TEST_F(events_impact_table_Test, Test2) {
 //   EXPECT_EQ(event_list.impact_table.size(), vol * 24);
 //
 //   for (auto const &impacted : event_list.impact_table) {
-//     EXPECT_EQ(impacted.second.size(), 707);
+//     EXPECT_EQ(impacted.size(), 707);
 //   }
 //   EXPECT_EQ(event_list.events.size(), vol * 24);
 //
@@ -0,0 +1,45 @@
+#include <numeric>
+
+#include "casm/clexmonte/misc/parallel.hh"
+#include "gtest/gtest.h"
+
+using namespace CASM;
+
+TEST(misc_parallel_Test, ThreadPoolTest1) {
+  clexmonte::ThreadPool pool(4);
+  EXPECT_EQ(pool.n_threads(), 4);
+
+  // repeated small loops, including fewer elements than threads
+  std::vector<Index> values(101, 0);
+  for (Index n : {Index(101), Index(3), Index(1), Index(0), Index(101)}) {
+    pool.for_blocks(n, [&](int thread_index, Index begin, Index end) {
+      for (Index i = begin; i < end; ++i) {
+        values[i] += i;
+      }
+    });
+  }
+  for (Index i = 0; i < values.size(); ++i) {
+    Index expected = 2 * i + (i < 3 ? i : 0) + (i < 1 ? i : 0);
+    EXPECT_EQ(values[i], expected);
+  }
+}
+
+TEST(misc_parallel_Test, ThreadPoolTest2) {
+  clexmonte::ThreadPool pool(3);
+  EXPECT_THROW(pool.for_blocks(10,
+                               [&](int thread_index, Index begin, Index end) {
+                                 if (thread_index == 1) {
+                                   throw std::runtime_error("error");
+                                 }
+                               }),
+               std::runtime_error);
+
+  // still usable after an exception
+  std::vector<int> values(10, 0);
+  pool.for_blocks(10, [&](int thread_index, Index begin, Index end) {
+    for (Index i = begin; i < end; ++i) {
+      values[i] = 1;
+    }
+  });
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 10);
+}
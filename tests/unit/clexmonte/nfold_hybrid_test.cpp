@@ -0,0 +1,278 @@
+#include <algorithm>
+
+#include "casm/casm_io/json/InputParser_impl.hh"
+#include "casm/clexmonte/nfold/hybrid.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/run/io/RunParams.hh"
+#include "casm/clexmonte/run/io/json/RunParams_json_io_impl.hh"
+#include "casm/clexmonte/semigrand_canonical/calculator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/clexmonte/system/io/json/System_json_io.hh"
+#include "casm/monte/MethodLog.hh"
+#include "casm/monte/checks/CompletionCheck.hh"
+#include "casm/monte/run_management/RunManager.hh"
+#include "casm/monte/run_management/SamplingFixture.hh"
+#include "casm/monte/run_management/io/json/jsonResultsIO_impl.hh"
+#include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+#include "casm/monte/sampling/SamplingParams.hh"
+#include "gtest/gtest.h"
+#include "misc.hh"
+#include "testdir.hh"
+
+using namespace CASM;
+
+namespace {
+
+/// \brief Construct the ZrO system, from Clex_ZrO_Occ/system.json
+std::shared_ptr<clexmonte::System> make_ZrO_system(fs::path test_dir) {
+  std::vector<fs::path> search_path;
+
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  fs::path clexulator_src_relpath = fs::path("basis_sets") /
+                                    "bset.formation_energy" /
+                                    "ZrO_Clexulator_formation_energy.cc";
+  fs::path eci_relpath = "formation_energy_eci.json";
+
+  fs::copy_options copy_options = fs::copy_options::skip_existing;
+  fs::create_directories(test_dir / clexulator_src_relpath.parent_path());
+  fs::copy_file(test_data_dir / clexulator_src_relpath,
+                test_dir / clexulator_src_relpath, copy_options);
+  fs::copy_file(test_data_dir / eci_relpath, test_dir / eci_relpath,
+                copy_options);
+
+  jsonParser system_json(test_data_dir / "system.json");
+  system_json["basis_sets"]["formation_energy"]["source"] =
+      (test_dir / clexulator_src_relpath).string();
+  system_json["clex"]["formation_energy"]["coefficients"] =
+      (test_dir / eci_relpath).string();
+  InputParser<clexmonte::System> system_parser(system_json, search_path);
+  std::runtime_error system_error_if_invalid{
+      "Error reading semi-grand canonical Monte Carlo system JSON input"};
+  report_and_throw_if_invalid(system_parser, CASM::log(),
+                              system_error_if_invalid);
+
+  return std::shared_ptr<clexmonte::System>(system_parser.value.release());
+}
+
+/// \brief Run a single state, 4 x 4 x 4 supercell, for a fixed number of
+///     passes, and return the contents of summary.json
+///
+/// \param calculation SemiGrandCanonical or HybridNfold calculator
+/// \param output_dir Output directory, removed before returning
+/// \param n_passes Number of passes, sampling after each pass
+template <typename CalculationType>
+jsonParser run_and_read_summary(std::shared_ptr<CalculationType> calculation,
+                                fs::path output_dir, Index n_passes) {
+  typedef typename CalculationType::engine_type engine_type;
+  std::shared_ptr<clexmonte::System> system = calculation->system;
+  std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
+
+  monte::StateSamplingFunctionMap sampling_functions =
+      CalculationType::standard_sampling_functions(calculation);
+  monte::jsonStateSamplingFunctionMap json_sampling_functions =
+      CalculationType::standard_json_sampling_functions(calculation);
+  std::map<std::string, clexmonte::results_analysis_function_type>
+      analysis_functions =
+          CalculationType::standard_analysis_functions(calculation);
+
+  // - State generator: 4 x 4 x 4 supercell
+  Eigen::Matrix3l transformation_matrix_to_super;
+  transformation_matrix_to_super.col(0) << 4, 0, 0;
+  transformation_matrix_to_super.col(1) << 0, 4, 0;
+  transformation_matrix_to_super.col(2) << 0, 0, 4;
+  clexmonte::Configuration initial_configuration =
+      clexmonte::make_default_configuration(*system,
+                                            transformation_matrix_to_super);
+  auto config_generator = notstd::make_unique<clexmonte::FixedConfigGenerator>(
+      initial_configuration);
+  composition::CompositionConverter const &composition_converter =
+      get_composition_converter(*system);
+  monte::ValueMap initial_conditions =
+      clexmonte::semigrand_canonical::make_conditions(
+          1000.0, composition_converter, {{"a", -2.0}});
+  monte::ValueMap conditions_increment =
+      clexmonte::semigrand_canonical::make_conditions_increment(
+          0.0, composition_converter, {{"a", 0.0}});
+  clexmonte::RunDataOutputParams output_params;
+  output_params.output_dir = output_dir;
+  clexmonte::IncrementalConditionsStateGenerator state_generator(
+      system, output_params, std::move(config_generator), initial_conditions,
+      conditions_increment, 1 /*n_states*/, false /*dependent_runs*/);
+
+  // - Sampling, by pass
+  monte::SamplingParams sampling_params;
+  sampling_params.sample_mode = monte::SAMPLE_MODE::BY_PASS;
+  sampling_params.sample_method = monte::SAMPLE_METHOD::LINEAR;
+  sampling_params.begin = 1.0;
+  sampling_params.period = 1.0;
+  sampling_params.sampler_names = std::vector<std::string>(
+      {"formation_energy", "param_composition", "potential_energy"});
+  sampling_params.do_sample_trajectory = false;
+
+  // - Completion check: fixed number of passes (the requested precision is
+  //   not reached, but is needed to calculate the precision)
+  monte::CompletionCheckParams<clexmonte::statistics_type>
+      completion_check_params;
+  completion_check_params.equilibration_check_f =
+      monte::default_equilibration_check;
+  completion_check_params.calc_statistics_f =
+      monte::BasicStatisticsCalculator();
+  completion_check_params.cutoff_params.min_count = n_passes;
+  completion_check_params.cutoff_params.max_count = n_passes;
+  converge(sampling_functions, completion_check_params)
+      .set_abs_precision("formation_energy", 1e-8)
+      .set_abs_precision("param_composition", 1e-8);
+
+  fs::path output_thermo_dir = output_dir / "thermo";
+  auto results_io =
+      std::make_unique<monte::jsonResultsIO<clexmonte::results_type>>(
+          output_thermo_dir, false /*write_trajectory*/,
+          false /*write_observations*/);
+
+  monte::MethodLog method_log;
+  method_log.logfile_path = output_thermo_dir / "status.json";
+  method_log.log_frequency = 60;  // seconds
+
+  std::vector<clexmonte::sampling_fixture_params_type> sampling_fixture_params;
+  sampling_fixture_params.emplace_back(
+      "thermo", sampling_functions, json_sampling_functions, analysis_functions,
+      sampling_params, completion_check_params, std::vector<std::string>(),
+      std::move(results_io), method_log);
+
+  clexmonte::run_series(*calculation, engine, state_generator,
+                        sampling_fixture_params, true /*global_cutoff*/);
+
+  EXPECT_TRUE(fs::exists(output_thermo_dir / "summary.json"));
+  jsonParser summary(output_thermo_dir / "summary.json");
+
+  fs::remove_all(output_dir);
+  return summary;
+}
+
+/// \brief Expect the mean of a sampled quantity to agree within the
+///     calculated precision
+void expect_same_mean(jsonParser const &stats_1, jsonParser const &stats_2,
+                      double min_tol) {
+  double mean_1 = stats_1["mean"][0].get<double>();
+  double mean_2 = stats_2["mean"][0].get<double>();
+  double tol = 2.0 * (stats_1["calculated_precision"][0].get<double>() +
+                      stats_2["calculated_precision"][0].get<double>());
+  EXPECT_NEAR(mean_1, mean_2, std::max(tol, min_tol));
+}
+
+}  // namespace
+
+/// \brief Hybrid Metropolis / N-fold agrees with semi-grand canonical
+///     Metropolis, and counts the same steps and samples, with switching
+TEST(nfold_hybrid_test, Test1) {
+  fs::path test_dir =
+      fs::current_path() / "CASM_test_projects" / "nfold_hybrid_test";
+  std::shared_ptr<clexmonte::System> system = make_ZrO_system(test_dir);
+  Index n_passes = 4000;
+
+  auto metropolis = std::make_shared<
+      clexmonte::semigrand_canonical::SemiGrandCanonical_mt19937_64>(system);
+  jsonParser metropolis_summary = run_and_read_summary(
+      metropolis, test_dir / "output_metropolis", n_passes);
+  double acceptance_rate =
+      metropolis_summary["completion_check_results"]["acceptance_rate"][0]
+          .get<double>();
+  EXPECT_GT(acceptance_rate, 0.0);
+
+  // Thresholds bracketing the mean acceptance rate, so that the hybrid
+  // switches many times during the run
+  auto hybrid =
+      std::make_shared<clexmonte::nfold::HybridNfold_mt19937_64>(system);
+  hybrid->nfold_acceptance_threshold = acceptance_rate;
+  hybrid->metropolis_acceptance_threshold = acceptance_rate + 0.01;
+  jsonParser hybrid_summary =
+      run_and_read_summary(hybrid, test_dir / "output_hybrid", n_passes);
+  EXPECT_GT(hybrid->n_switches, 10);
+  EXPECT_GT(hybrid->n_nfold_steps, 0);
+
+  // N-fold steps count as Metropolis attempts: the same number of steps and
+  // samples as Metropolis
+  jsonParser const &metropolis_results =
+      metropolis_summary["completion_check_results"];
+  jsonParser const &hybrid_results = hybrid_summary["completion_check_results"];
+  EXPECT_EQ(metropolis_results["count"][0].get<double>(),
+            hybrid_results["count"][0].get<double>());
+  EXPECT_EQ(metropolis_results["N_samples"][0].get<double>(),
+            hybrid_results["N_samples"][0].get<double>());
+  EXPECT_NEAR(hybrid_results["acceptance_rate"][0].get<double>(),
+              acceptance_rate, 0.02);
+
+  // Same equilibrium averages
+  expect_same_mean(metropolis_summary["statistics"]["formation_energy"]["value"],
+                   hybrid_summary["statistics"]["formation_energy"]["value"],
+                   0.002);
+  expect_same_mean(metropolis_summary["statistics"]["param_composition"]["a"],
+                   hybrid_summary["statistics"]["param_composition"]["a"],
+                   0.005);
+}
+
+/// \brief Hybrid Metropolis / N-fold does not allow time-based sampling
+TEST(nfold_hybrid_test, Test2) {
+  std::vector<fs::path> search_path;
+  fs::path test_dir =
+      fs::current_path() / "CASM_test_projects" / "nfold_hybrid_test";
+  std::shared_ptr<clexmonte::System> system = make_ZrO_system(test_dir);
+
+  typedef clexmonte::nfold::HybridNfold_mt19937_64 calculation_type;
+  typedef calculation_type::engine_type engine_type;
+  auto calculation = std::make_shared<calculation_type>(system);
+  EXPECT_FALSE(calculation->time_sampling_allowed);
+
+  // time sampling is also not allowed through the base class
+  clexmonte::nfold::Nfold_mt19937_64 const &base = *calculation;
+  EXPECT_FALSE(base.time_sampling_allowed);
+
+  std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
+  auto sampling_functions =
+      calculation_type::standard_sampling_functions(calculation);
+  auto json_sampling_functions =
+      calculation_type::standard_json_sampling_functions(calculation);
+  auto analysis_functions =
+      calculation_type::standard_analysis_functions(calculation);
+  auto modifying_functions =
+      calculation_type::standard_modifying_functions(calculation);
+
+  clexmonte::semigrand_canonical::SemiGrandCanonicalConditions const
+      *conditions_ptr = nullptr;
+  auto config_generator_methods =
+      clexmonte::standard_config_generator_methods(calculation->system);
+  auto state_generator_methods = clexmonte::standard_state_generator_methods(
+      calculation->system, modifying_functions, config_generator_methods,
+      conditions_ptr);
+  auto results_io_methods = clexmonte::standard_results_io_methods();
+
+  fs::path test_data_dir = test::data_dir("clexmonte") / "Clex_ZrO_Occ";
+  jsonParser run_params_json(test_data_dir / "run_params_sgc_complete.json");
+  run_params_json["sampling_fixtures"]["thermo"]["results_io"]["kwargs"]
+                 ["output_dir"] = (test_dir / "output" / "thermo").string();
+
+  // sampling by pass is allowed
+  {
+    InputParser<clexmonte::RunParams<std::mt19937_64>> run_params_parser(
+        run_params_json, search_path, engine, sampling_functions,
+        json_sampling_functions, analysis_functions, state_generator_methods,
+        results_io_methods, calculation->time_sampling_allowed,
+        conditions_ptr);
+    EXPECT_TRUE(run_params_parser.valid());
+  }
+
+  // sampling by time is an error
+  {
+    run_params_json["sampling_fixtures"]["thermo"]["sampling"]["sample_by"] =
+        "time";
+    InputParser<clexmonte::RunParams<std::mt19937_64>> run_params_parser(
+        run_params_json, search_path, engine, sampling_functions,
+        json_sampling_functions, analysis_functions, state_generator_methods,
+        results_io_methods, calculation->time_sampling_allowed,
+        conditions_ptr);
+    EXPECT_FALSE(run_params_parser.valid());
+  }
+}
@@ -0,0 +1,232 @@
+#include <algorithm>
+
+#include "KMCTestSystem.hh"
+#include "casm/clexmonte/run/FixedConfigGenerator.hh"
+#include "casm/clexmonte/run/IncrementalConditionsStateGenerator.hh"
+#include "casm/clexmonte/run/functions.hh"
+#include "casm/clexmonte/semigrand_canonical/calculator.hh"
+#include "casm/clexmonte/state/Configuration.hh"
+#include "casm/clexmonte/system/System.hh"
+#include "casm/monte/MethodLog.hh"
+#include "casm/monte/checks/CompletionCheck.hh"
+#include "casm/monte/run_management/RunManager.hh"
+#include "casm/monte/run_management/SamplingFixture.hh"
+#include "casm/monte/run_management/io/json/jsonResultsIO_impl.hh"
+#include "casm/monte/sampling/RequestedPrecisionConstructor.hh"
+#include "casm/monte/sampling/SamplingParams.hh"
+#include "gtest/gtest.h"
+#include "misc.hh"
+#include "testdir.hh"
+
+using namespace CASM;
+
+/// NOTE:
+/// - This test is designed to copy data to the same directory each time, so
+///   that the Clexulators do not need to be re-compiled.
+/// - To clear existing data, remove the directory:
+//    CASM_test_projects/semigrand_canonical_checkerboard_fullrun_test
+class semigrand_canonical_checkerboard_fullrun_test
+    : public test::KMCTestSystem {
+ protected:
+  typedef clexmonte::semigrand_canonical::SemiGrandCanonical_mt19937_64
+      calculation_type;
+  typedef calculation_type::engine_type engine_type;
+
+  semigrand_canonical_checkerboard_fullrun_test()
+      : KMCTestSystem(
+            "FCC_binary_vacancy",
+            "semigrand_canonical_checkerboard_fullrun_test",
+            test::data_dir("clexmonte") / "kmc" / "system_template.json") {
+    // checkerboard sweeps require formation_energy cluster_info, which is
+    // read from the basis set's basis.json
+    set_clex("formation_energy", "default", "formation_energy_eci.json");
+    write_input();
+    make_system();
+  }
+
+  /// \brief Run a series of states, 8 x 8 x 8 supercell, sampling every
+  ///     `sample_period` steps for `n_steps` steps, check the output files,
+  ///     and return the contents of summary.json
+  ///
+  /// \param calculation Semi-grand canonical calculator
+  /// \param output_dir Output directory, removed before returning
+  /// \param n_states Number of states, with param_chem_pot "a" incremented
+  ///     by 0.5 starting from -1.0
+  /// \param sample_period Number of steps between samples
+  /// \param n_steps Number of steps per state
+  jsonParser run_and_read_summary(std::shared_ptr<calculation_type> calculation,
+                                  fs::path output_dir, Index n_states,
+                                  double sample_period, Index n_steps) {
+    std::shared_ptr<engine_type> engine = std::make_shared<engine_type>();
+
+    monte::StateSamplingFunctionMap sampling_functions =
+        calculation_type::standard_sampling_functions(calculation);
+    monte::jsonStateSamplingFunctionMap json_sampling_functions =
+        calculation_type::standard_json_sampling_functions(calculation);
+    std::map<std::string, clexmonte::results_analysis_function_type>
+        analysis_functions =
+            calculation_type::standard_analysis_functions(calculation);
+
+    // - State generator: 8 x 8 x 8 supercell, so that 2 x 2 x 2 domains
+    //   have sectors 2 unit cells wide
+    Eigen::Matrix3l transformation_matrix_to_super;
+    transformation_matrix_to_super.col(0) << 8, 0, 0;
+    transformation_matrix_to_super.col(1) << 0, 8, 0;
+    transformation_matrix_to_super.col(2) << 0, 0, 8;
+    clexmonte::Configuration initial_configuration =
+        clexmonte::make_default_configuration(*system,
+                                              transformation_matrix_to_super);
+    auto config_generator =
+        notstd::make_unique<clexmonte::FixedConfigGenerator>(
+            initial_configuration);
+    composition::CompositionConverter const &composition_converter =
+        get_composition_converter(*system);
+    monte::ValueMap initial_conditions =
+        clexmonte::semigrand_canonical::make_conditions(
+            1000.0, composition_converter, {{"a", -1.0}, {"b", 0.0}});
+    monte::ValueMap conditions_increment =
+        clexmonte::semigrand_canonical::make_conditions_increment(
+            0.0, composition_converter, {{"a", 0.5}, {"b", 0.0}});
+    clexmonte::RunDataOutputParams output_params;
+    output_params.output_dir = output_dir;
+    clexmonte::IncrementalConditionsStateGenerator state_generator(
+        system, output_params, std::move(config_generator),
+        initial_conditions, conditions_increment, n_states,
+        true /*dependent_runs*/);
+
+    // - Sampling, by step
+    monte::SamplingParams sampling_params;
+    sampling_params.sample_mode = monte::SAMPLE_MODE::BY_STEP;
+    sampling_params.sample_method = monte::SAMPLE_METHOD::LINEAR;
+    sampling_params.begin = sample_period;
+    sampling_params.period = sample_period;
+    sampling_params.sampler_names = std::vector<std::string>(
+        {"temperature", "mol_composition", "param_composition",
+         "formation_energy", "potential_energy"});
+    sampling_params.json_sampler_names = std::vector<std::string>({"config"});
+    sampling_params.do_sample_trajectory = false;
+
+    // - Completion check: fixed number of steps (the requested precision is
+    //   not reached, but is needed to calculate the precision)
+    monte::CompletionCheckParams<clexmonte::statistics_type>
+        completion_check_params;
+    completion_check_params.equilibration_check_f =
+        monte::default_equilibration_check;
+    completion_check_params.calc_statistics_f =
+        monte::BasicStatisticsCalculator();
+    completion_check_params.cutoff_params.min_count = n_steps;
+    completion_check_params.cutoff_params.max_count = n_steps;
+    converge(sampling_functions, completion_check_params)
+        .set_abs_precision("formation_energy", 1e-8)
+        .set_abs_precision("param_composition", 1e-8);
+
+    fs::path output_thermo_dir = output_dir / "thermo";
+    auto results_io =
+        std::make_unique<monte::jsonResultsIO<clexmonte::results_type>>(
+            output_thermo_dir, true /*write_trajectory*/,
+            true /*write_observations*/);
+
+    monte::MethodLog method_log;
+    method_log.logfile_path = output_thermo_dir / "status.json";
+    method_log.log_frequency = 60;  // seconds
+
+    std::vector<clexmonte::sampling_fixture_params_type>
+        sampling_fixture_params;
+    sampling_fixture_params.emplace_back(
+        "thermo", sampling_functions, json_sampling_functions,
+        analysis_functions, sampling_params, completion_check_params,
+        std::vector<std::string>(), std::move(results_io), method_log);
+
+    clexmonte::run_series(*calculation, engine, state_generator,
+                          sampling_fixture_params, true /*global_cutoff*/);
+
+    // check output/ files presence
+    EXPECT_TRUE(fs::exists(output_dir / "completed_runs.json"));
+    EXPECT_TRUE(fs::exists(output_thermo_dir / "summary.json"));
+    for (int i = 1; i <= n_states; ++i) {
+      fs::path run_dir =
+          output_thermo_dir / (std::string("run.") + std::to_string(i));
+      EXPECT_TRUE(fs::exists(run_dir));
+      EXPECT_TRUE(fs::exists(run_dir / "observations.json"));
+      EXPECT_TRUE(fs::exists(run_dir / "trajectory.json"));
+    }
+    jsonParser summary(output_thermo_dir / "summary.json");
+
+    fs::remove_all(output_dir);
+    return summary;
+  }
+
+  /// \brief Expect the mean of a sampled quantity, for run `i`, to agree
+  ///     within the calculated precision
+  void expect_same_mean(jsonParser const &stats_1, jsonParser const &stats_2,
+                        Index i, double min_tol) {
+    double mean_1 = stats_1["mean"][i].get<double>();
+    double mean_2 = stats_2["mean"][i].get<double>();
+    double tol = 2.0 * (stats_1["calculated_precision"][i].get<double>() +
+                        stats_2["calculated_precision"][i].get<double>());
+    EXPECT_NEAR(mean_1, mean_2, std::max(tol, min_tol));
+  }
+};
+
+/// \brief Checkerboard-parallel sweeps agree with sequential Metropolis, and
+///     count the same steps and samples
+TEST_F(semigrand_canonical_checkerboard_fullrun_test, Test1) {
+  Index n_states = 3;
+  Index n_sites = 8 * 8 * 8;
+
+  // The sample period and number of steps are not multiples of the number
+  // of attempts per sub-sweep, so samples and completion fall inside
+  // sub-sweeps
+  double sample_period = 97.0;
+  Index n_steps = n_sites * 1000 + 13;
+
+  auto metropolis = std::make_shared<calculation_type>(system);
+  jsonParser metropolis_summary =
+      run_and_read_summary(metropolis, test_dir / "output_metropolis",
+                           n_states, sample_period, n_steps);
+
+  auto checkerboard = std::make_shared<calculation_type>(system);
+  checkerboard->checkerboard_n_domains = {2, 2, 2};
+  checkerboard->checkerboard_n_threads = 2;
+  jsonParser checkerboard_summary =
+      run_and_read_summary(checkerboard, test_dir / "output_checkerboard",
+                           n_states, sample_period, n_steps);
+
+  jsonParser const &metropolis_results =
+      metropolis_summary["completion_check_results"];
+  jsonParser const &checkerboard_results =
+      checkerboard_summary["completion_check_results"];
+  jsonParser const &metropolis_stats = metropolis_summary["statistics"];
+  jsonParser const &checkerboard_stats = checkerboard_summary["statistics"];
+  for (Index i = 0; i < n_states; ++i) {
+    // Completion is checked, and samples are taken, after each step
+    EXPECT_EQ(checkerboard_results["count"][i].get<double>(), n_steps);
+    EXPECT_EQ(metropolis_results["count"][i].get<double>(),
+              checkerboard_results["count"][i].get<double>());
+    EXPECT_EQ(metropolis_results["N_samples"][i].get<double>(),
+              checkerboard_results["N_samples"][i].get<double>());
+    EXPECT_NEAR(metropolis_results["acceptance_rate"][i].get<double>(),
+                checkerboard_results["acceptance_rate"][i].get<double>(),
+                0.02);
+
+    // Same equilibrium averages
+    expect_same_mean(metropolis_stats["formation_energy"]["value"],
+                     checkerboard_stats["formation_energy"]["value"], i,
+                     0.002);
+    expect_same_mean(metropolis_stats["param_composition"]["a"],
+                     checkerboard_stats["param_composition"]["a"], i, 0.005);
+    expect_same_mean(metropolis_stats["param_composition"]["b"],
+                     checkerboard_stats["param_composition"]["b"], i, 0.005);
+  }
+}
+
+/// \brief Checkerboard sweeps throw if sectors are narrower than the
+///     formation energy range
+TEST_F(semigrand_canonical_checkerboard_fullrun_test, Test2) {
+  auto checkerboard = std::make_shared<calculation_type>(system);
+  checkerboard->checkerboard_n_domains = {8, 1, 1};
+  EXPECT_THROW(run_and_read_summary(checkerboard, test_dir / "output_narrow",
+                                    1 /*n_states*/, 10.0, 1000),
+               std::runtime_error);
+  fs::remove_all(test_dir / "output_narrow");
+}